@@ -0,0 +1,96 @@
+/*
+ * Geometry3D query suite: nanoseconds per call over fixed random shapes.
+ *
+ * Built twice (see bench/CMakeLists.txt): bench_geom3d with the vectors.h
+ * and matrices.h operations inlined as usual, and bench_geom3d_calls with
+ * each of them forced out of line, which is what every vec3/mat4 operation
+ * cost before they moved into the headers. Run both and compare.
+ */
+#include "Geometry3D/geom3d_types.h"
+#include "Geometry3D/geom3d_arrays.h"
+#include "Geometry3D/geom3d_collision.h"
+#include "Geometry3D/geom3d_queries.h"
+#include "Geometry3D/geom3d_intersect.h"
+#include "Geometry3D/geom3d_raycast.h"
+#include "matrices.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_COUNT  4096           /* shapes per kind, a power of two */
+#define BENCH_ROUNDS 200
+
+static double bench_now(void) {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1.0e-9;
+}
+
+static float bench_random(void) {
+    return (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static OBB      obbs[BENCH_COUNT];
+static Sphere   spheres[BENCH_COUNT];
+static Triangle triangles[BENCH_COUNT];
+static Point3D  points[BENCH_COUNT];
+static Ray3D    rays[BENCH_COUNT];
+static mat4     matrices[BENCH_COUNT];
+
+/* Keeps the results alive so the loops are not optimised away */
+static volatile float sink;
+
+#define NEXT(i) (((i) + 1) & (BENCH_COUNT - 1))
+
+#define BENCH(name, body)                                                       \
+    do {                                                                        \
+        double start = bench_now();                                             \
+        for (int round = 0; round < BENCH_ROUNDS; ++round) {                    \
+            for (int i = 0; i < BENCH_COUNT; ++i) {                             \
+                body;                                                           \
+            }                                                                   \
+        }                                                                       \
+        double elapsed = bench_now() - start;                                   \
+        printf("%-28s %8.1f ns\n", name,                                        \
+               elapsed / BENCH_ROUNDS / BENCH_COUNT * 1.0e9);                   \
+    } while (0)
+
+int main(void) {
+    srand(1);
+    for (int i = 0; i < BENCH_COUNT; ++i) {
+        obbs[i].position = vec3_make(bench_random() * 4, bench_random() * 4, bench_random() * 4);
+        obbs[i].size = vec3_make(1 + bench_random() * 0.5f, 1, 1);
+        obbs[i].orientation = Rotation3x3(bench_random() * 90, bench_random() * 90, bench_random() * 90);
+        spheres[i].position = vec3_make(bench_random() * 4, bench_random() * 4, bench_random() * 4);
+        spheres[i].radius = 1;
+        for (int k = 0; k < 3; ++k) {
+            triangles[i].points[k] = vec3_make(bench_random() * 4, bench_random() * 4, bench_random() * 4);
+        }
+        points[i] = vec3_make(bench_random() * 4, bench_random() * 4, bench_random() * 4);
+        rays[i].origin = vec3_make(bench_random() * 8, bench_random() * 8, -10);
+        rays[i].direction = vec3_normalized(vec3_make(bench_random(), bench_random(), 1));
+        matrices[i] = Rotation(bench_random() * 90, bench_random() * 90, bench_random() * 90);
+        matrices[i]._41 = bench_random();
+    }
+
+    vec3 vertices[8];
+    RaycastResult hit;
+
+    BENCH("obb_get_vertices", obb_get_vertices(obbs[i], vertices); sink += vertices[i & 7].x);
+    BENCH("closest_point_on_obb", sink += closest_point_on_obb(obbs[i], points[i]).x);
+    BENCH("closest_point_on_triangle", sink += closest_point_on_triangle(triangles[i], points[i]).y);
+    BENCH("obb_obb", sink += obb_obb(obbs[i], obbs[NEXT(i)]));
+    BENCH("sphere_obb", sink += sphere_obb(spheres[i], obbs[i]));
+    BENCH("triangle_obb", sink += triangle_obb(triangles[i], obbs[i]));
+    BENCH("raycast_obb", sink += raycast_obb(obbs[i], rays[i], &hit));
+    BENCH("raycast_triangle", sink += raycast_triangle(triangles[i], rays[i], &hit));
+    BENCH("obb_obb manifold", {
+        CollisionManifold manifold = find_collision_features_obb_obb(obbs[i], obbs[NEXT(i)]);
+        sink += manifold.depth;
+        collision_manifold_free(&manifold);
+    });
+    BENCH("mat4_mul", sink += mat4_mul(matrices[i], matrices[NEXT(i)])._22);
+    BENCH("MultiplyPoint", sink += MultiplyPoint(points[i], matrices[i]).z);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * OBB-OBB manifolds through the heap CollisionManifold path against the
+ * ManifoldPool + _fixed path: heap allocations and nanoseconds per pair.
+ *
+ * Linked with -Wl,--wrap for malloc, calloc and realloc (see
+ * bench/CMakeLists.txt), so every allocation made by the geometry code is
+ * counted; allocations inside libc itself are not.
+ */
+#include "Geometry3D/geom3d_types.h"
+#include "Geometry3D/geom3d_arrays.h"
+#include "Geometry3D/geom3d_collision.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_PAIRS 4096
+#define BENCH_STEPS 20
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* block, size_t size);
+
+static long allocations;
+
+void* __wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* block, size_t size) {
+    allocations++;
+    return __real_realloc(block, size);
+}
+
+static double bench_now(void) {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1.0e-9;
+}
+
+static float bench_random(void) {
+    return (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static OBB first[BENCH_PAIRS];
+static OBB second[BENCH_PAIRS];
+
+static void report(const char* name, double elapsed, long manifolds, long contacts, long allocated) {
+    printf("%-28s %8.1f ns/pair %8ld manifolds %8ld contacts %8ld allocations\n", name,
+           elapsed / BENCH_STEPS / BENCH_PAIRS * 1.0e9, manifolds, contacts, allocated);
+}
+
+int main(void) {
+    /* Rotated unit boxes, each overlapping its partner */
+    srand(1);
+    for (int i = 0; i < BENCH_PAIRS; ++i) {
+        Point3D position = vec3_make(bench_random() * 50, bench_random() * 50, bench_random() * 50);
+        vec3 offset = vec3_make(bench_random() * 0.5f, 1.5f, bench_random() * 0.5f);
+        first[i] = obb_create(position, vec3_make(1, 1, 1),
+                              Rotation3x3(bench_random() * 90, bench_random() * 90, bench_random() * 90));
+        second[i] = obb_create(vec3_add(position, offset), vec3_make(1, 1, 1),
+                               Rotation3x3(bench_random() * 90, bench_random() * 90, bench_random() * 90));
+    }
+
+    long manifolds = 0, contacts = 0;
+    allocations = 0;
+    double start = bench_now();
+    for (int step = 0; step < BENCH_STEPS; ++step) {
+        for (int i = 0; i < BENCH_PAIRS; ++i) {
+            CollisionManifold manifold = find_collision_features_obb_obb(first[i], second[i]);
+            if (manifold.colliding) {
+                manifolds++;
+                contacts += manifold.contacts.count;
+            }
+            collision_manifold_free(&manifold);
+        }
+    }
+    report("heap CollisionManifold", bench_now() - start, manifolds, contacts, allocations);
+
+    ManifoldPool pool;
+    manifold_pool_init(&pool);
+    manifolds = contacts = 0;
+    allocations = 0;
+    start = bench_now();
+    for (int step = 0; step < BENCH_STEPS; ++step) {
+        manifold_pool_clear(&pool);
+        for (int i = 0; i < BENCH_PAIRS; ++i) {
+            if (find_collision_features_obb_obb_fixed(first[i], second[i], manifold_pool_next(&pool))) {
+                manifold_pool_commit(&pool);
+            }
+        }
+        manifolds += pool.count;
+        for (int k = 0; k < pool.count; ++k) {
+            contacts += pool.data[k].contacts.count;
+        }
+    }
+    report("ManifoldPool + _fixed", bench_now() - start, manifolds, contacts, allocations);
+    manifold_pool_free(&pool);
+    return 0;
+}
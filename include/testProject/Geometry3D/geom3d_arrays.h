@@ -39,4 +39,33 @@ void collision_manifold_reset(CollisionManifold* result);
 void collision_manifold_init(CollisionManifold* result);
 void collision_manifold_free(CollisionManifold* result);
 
+/*******************************************************************************
+ * FixedManifold / ManifoldPool
+ ******************************************************************************/
+
+/* Returns false (and drops the point) once the inline storage is full */
+bool fixed_contact_array_push(FixedContactArray* arr, vec3 point);
+void fixed_contact_array_swap_remove(FixedContactArray* arr, int index);
+
+void fixed_manifold_init(FixedManifold* result);
+
+void manifold_pool_init(ManifoldPool* pool);
+void manifold_pool_free(ManifoldPool* pool);
+/* Returns false, keeping the current storage, if the allocation fails */
+bool manifold_pool_reserve(ManifoldPool* pool, int capacity);
+void manifold_pool_clear(ManifoldPool* pool);
+
+/*
+ * Two-phase insertion: write into manifold_pool_next() and only keep the
+ * slot with manifold_pool_commit() if the pair actually collided, e.g.
+ *   if (find_collision_features_obb_obb_fixed(a, b, manifold_pool_next(&p)))
+ *       manifold_pool_commit(&p);
+ * The pool only allocates when it has to grow past its high-water mark.
+ * If it cannot grow, next() returns the pool's overflow slot, which
+ * commit() never keeps, so the pair is dropped instead of written out of
+ * bounds.
+ */
+FixedManifold* manifold_pool_next(ManifoldPool* pool);
+void           manifold_pool_commit(ManifoldPool* pool);
+
 #endif /* GEOM3D_ARRAYS_H */
\ No newline at end of file
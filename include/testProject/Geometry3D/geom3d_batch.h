@@ -0,0 +1,106 @@
+/**
+ * @file geom3d_batch.h
+ * @brief Structure-of-arrays shape sets and batched narrowphase tests
+ */
+#ifndef GEOM3D_BATCH_H
+#define GEOM3D_BATCH_H
+
+#include "geom3d_types.h"
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Type Definitions
+ *
+ * One float array per component, so a batch kernel can fill a SIMD lane per
+ * pair. Heap owned; release with the matching _free.
+ ******************************************************************************/
+
+typedef struct SphereSoA {
+    float* position[3];
+    float* radius;
+    int    count;
+    int    capacity;
+} SphereSoA;
+
+typedef struct AABBSoA {
+    float* position[3];     /* Center */
+    float* size[3];         /* HALF SIZE */
+    int    count;
+    int    capacity;
+} AABBSoA;
+
+typedef struct OBBSoA {
+    float* position[3];     /* Center */
+    float* size[3];         /* HALF SIZE */
+    float* orientation[9];  /* orientation.m[i][j] lives in orientation[i * 3 + j] */
+    int    count;
+    int    capacity;
+} OBBSoA;
+
+/* Broadphase output: a indexes the first set, b the second */
+typedef struct CollisionPair {
+    int a;
+    int b;
+} CollisionPair;
+
+/* uint32_t words needed for the result mask of count pairs */
+#define BATCH_MASK_WORDS(count) (((count) + 31) / 32)
+
+static inline bool batch_mask_test(const uint32_t* mask, int index) {
+    return (mask[index >> 5] >> (index & 31)) & 1u;
+}
+
+/*******************************************************************************
+ * Shape Sets
+ *
+ * _reserve returns false, keeping the set's contents and capacity, when an
+ * allocation fails; _push then returns -1 instead of the new index.
+ ******************************************************************************/
+
+void sphere_soa_init(SphereSoA* set);
+void sphere_soa_free(SphereSoA* set);
+bool sphere_soa_reserve(SphereSoA* set, int capacity);
+void sphere_soa_clear(SphereSoA* set);
+int  sphere_soa_push(SphereSoA* set, Sphere sphere);
+void sphere_soa_set(SphereSoA* set, int index, Sphere sphere);
+Sphere sphere_soa_get(const SphereSoA* set, int index);
+
+void aabb_soa_init(AABBSoA* set);
+void aabb_soa_free(AABBSoA* set);
+bool aabb_soa_reserve(AABBSoA* set, int capacity);
+void aabb_soa_clear(AABBSoA* set);
+int  aabb_soa_push(AABBSoA* set, AABB aabb);
+void aabb_soa_set(AABBSoA* set, int index, AABB aabb);
+AABB aabb_soa_get(const AABBSoA* set, int index);
+
+void obb_soa_init(OBBSoA* set);
+void obb_soa_free(OBBSoA* set);
+bool obb_soa_reserve(OBBSoA* set, int capacity);
+void obb_soa_clear(OBBSoA* set);
+int  obb_soa_push(OBBSoA* set, OBB obb);
+void obb_soa_set(OBBSoA* set, int index, OBB obb);
+OBB  obb_soa_get(const OBBSoA* set, int index);
+
+/*******************************************************************************
+ * Batched Tests
+ *
+ * Tests pairs[i].a of the first set against pairs[i].b of the second, four
+ * pairs per SIMD step, and sets bit i of out_mask (BATCH_MASK_WORDS(count)
+ * words, overwritten) when they overlap. Each answers exactly as the
+ * matching single-pair test in geom3d_intersect.h. Both sets may be the
+ * same set. Returns the number of overlapping pairs.
+ ******************************************************************************/
+
+int sphere_sphere_batch(const SphereSoA* a, const SphereSoA* b,
+                        const CollisionPair* pairs, int count, uint32_t* out_mask);
+int sphere_aabb_batch(const SphereSoA* spheres, const AABBSoA* boxes,
+                      const CollisionPair* pairs, int count, uint32_t* out_mask);
+int sphere_obb_batch(const SphereSoA* spheres, const OBBSoA* boxes,
+                     const CollisionPair* pairs, int count, uint32_t* out_mask);
+int aabb_aabb_batch(const AABBSoA* a, const AABBSoA* b,
+                    const CollisionPair* pairs, int count, uint32_t* out_mask);
+int obb_obb_batch(const OBBSoA* a, const OBBSoA* b,
+                  const CollisionPair* pairs, int count, uint32_t* out_mask);
+
+#endif /* GEOM3D_BATCH_H */
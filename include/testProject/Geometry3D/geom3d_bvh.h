@@ -11,6 +11,20 @@
  * BVH / Mesh Operations
  ******************************************************************************/
 
+/*
+ * Octree over the mesh triangles. Nodes split until they hold at most
+ * BVH_LEAF_TRIANGLES or reach BVH_MAX_DEPTH, so query cost follows the
+ * local triangle density rather than the mesh size.
+ *
+ * Each level can copy straddling triangles into several children, so a
+ * deeper cap trades build time and memory for smaller leaves. Measured on
+ * 128x128 and 256x256 height fields and floors, depth 4 builds in a
+ * third of the time of depth 8 and its manifold queries are as fast or
+ * faster; raise it only for much larger meshes.
+ */
+#define BVH_MAX_DEPTH      4
+#define BVH_LEAF_TRIANGLES 16
+
 void mesh_accelerate(Mesh* mesh);
 void bvhnode_split(BVHNode* node, const Mesh* mesh, int depth);
 void bvhnode_free(BVHNode* node);
@@ -21,10 +35,31 @@ bool  mesh_aabb(const Mesh* mesh, AABB aabb);
 bool  mesh_obb(const Mesh* mesh, OBB obb);
 bool  mesh_plane(const Mesh* mesh, Plane plane);
 bool  mesh_triangle(const Mesh* mesh, Triangle triangle);
+bool  mesh_capsule(const Mesh* mesh, Capsule capsule);
 float mesh_ray(const Mesh* mesh, Ray3D ray);
 
 #ifndef NO_EXTRAS
 float raycast_mesh(const Mesh* mesh, Ray3D ray);
 #endif
 
+/*
+ * Nearest time of impact of a shape moved by motion (see geom3d_sweep.h for
+ * the result convention). Only triangles inside the swept bounds are cast.
+ */
+bool mesh_sweep_sphere(const Mesh* mesh, Sphere sphere, vec3 motion, RaycastResult* out_result);
+bool mesh_sweep_capsule(const Mesh* mesh, Capsule capsule, vec3 motion, RaycastResult* out_result);
+bool mesh_sweep_obb(const Mesh* mesh, OBB obb, vec3 motion, RaycastResult* out_result);
+
+/*
+ * One manifold against the whole mesh: the deepest triangle contact sets the
+ * normal (mesh towards the shape), contacts from triangles facing the same
+ * way are merged and reduced to MANIFOLD_REDUCED_CONTACTS. Only triangles
+ * under the shape's bounds are visited. out->truncated is set when the
+ * shape touches more distinct points than are gathered (64) and some
+ * were left out of the reduction.
+ */
+bool find_collision_features_mesh_capsule(const Mesh* mesh, Capsule capsule, FixedManifold* out);
+bool find_collision_features_mesh_sphere(const Mesh* mesh, Sphere sphere, FixedManifold* out);
+bool find_collision_features_mesh_obb(const Mesh* mesh, OBB obb, FixedManifold* out);
+
 #endif /* GEOM3D_BVH_H */
\ No newline at end of file
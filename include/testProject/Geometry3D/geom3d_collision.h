@@ -25,6 +25,26 @@ int   clip_edges_to_obb(const Line3D* edges, int num_edges, OBB obb,
                         Point3D* out_points, int max_points);
 float penetration_depth(OBB o1, OBB o2, vec3 axis, bool* out_should_flip);
 
+/*
+ * Sutherland-Hodgman: clips a convex polygon to the side of plane with
+ * dot(normal, p) <= distance. Writes at most max_points; returns the count.
+ */
+int   clip_polygon_to_plane(const Point3D* in, int count, Plane plane, Point3D* out, int max_points);
+
+/*******************************************************************************
+ * Contact Reduction
+ ******************************************************************************/
+
+#define MANIFOLD_REDUCED_CONTACTS 4
+
+/*
+ * Reduces coplanar contacts to at most MANIFOLD_REDUCED_CONTACTS in place:
+ * the deepest point, the point farthest from it, the point spanning the
+ * largest triangle with those two, and the point adding the most area to that
+ * triangle. depths[] is permuted alongside points[]. Returns the new count.
+ */
+int reduce_contacts(Point3D* points, float* depths, int count, vec3 normal);
+
 /*******************************************************************************
  * Collision Manifold Functions
  ******************************************************************************/
@@ -33,4 +53,39 @@ CollisionManifold find_collision_features_sphere_sphere(Sphere a, Sphere b);
 CollisionManifold find_collision_features_obb_sphere(OBB a, Sphere b);
 CollisionManifold find_collision_features_obb_obb(OBB a, OBB b);
 
+/* Capsule pairs; normal points from the capsule towards the other shape */
+#define CAPSULE_MAX_CONTACTS 2
+
+CollisionManifold find_collision_features_capsule_sphere(Capsule a, Sphere b);
+CollisionManifold find_collision_features_capsule_capsule(Capsule a, Capsule b);
+CollisionManifold find_collision_features_capsule_aabb(Capsule a, AABB b);
+CollisionManifold find_collision_features_capsule_obb(Capsule a, OBB b);
+CollisionManifold find_collision_features_capsule_plane(Capsule a, Plane b);
+CollisionManifold find_collision_features_capsule_triangle(Capsule a, Triangle b);
+
+/* Two-sided triangles; normal points from the sphere / box towards the triangle */
+CollisionManifold find_collision_features_sphere_triangle(Sphere a, Triangle b);
+CollisionManifold find_collision_features_obb_triangle(OBB a, Triangle b);
+
+/*******************************************************************************
+ * Fixed Manifold Functions
+ *
+ * Same contact generation as above, written into caller-owned inline storage
+ * (e.g. a ManifoldPool slot). Returns out->colliding.
+ ******************************************************************************/
+
+bool find_collision_features_sphere_sphere_fixed(Sphere a, Sphere b, FixedManifold* out);
+bool find_collision_features_obb_sphere_fixed(OBB a, Sphere b, FixedManifold* out);
+bool find_collision_features_obb_obb_fixed(OBB a, OBB b, FixedManifold* out);
+
+bool find_collision_features_capsule_sphere_fixed(Capsule a, Sphere b, FixedManifold* out);
+bool find_collision_features_capsule_capsule_fixed(Capsule a, Capsule b, FixedManifold* out);
+bool find_collision_features_capsule_aabb_fixed(Capsule a, AABB b, FixedManifold* out);
+bool find_collision_features_capsule_obb_fixed(Capsule a, OBB b, FixedManifold* out);
+bool find_collision_features_capsule_plane_fixed(Capsule a, Plane b, FixedManifold* out);
+bool find_collision_features_capsule_triangle_fixed(Capsule a, Triangle b, FixedManifold* out);
+
+bool find_collision_features_sphere_triangle_fixed(Sphere a, Triangle b, FixedManifold* out);
+bool find_collision_features_obb_triangle_fixed(OBB a, Triangle b, FixedManifold* out);
+
 #endif /* GEOM3D_COLLISION_H */
\ No newline at end of file
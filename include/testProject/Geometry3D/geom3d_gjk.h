@@ -0,0 +1,112 @@
+/**
+ * @file geom3d_gjk.h
+ * @brief GJK distance / overlap and EPA penetration over support functions
+ */
+#ifndef GEOM3D_GJK_H
+#define GEOM3D_GJK_H
+
+#include "geom3d_types.h"
+
+/*******************************************************************************
+ * Convex Shapes
+ ******************************************************************************/
+
+/* Farthest point of the shape's core along direction (need not be unit) */
+typedef vec3 (*SupportFunction)(const void* shape, vec3 direction);
+
+/*
+ * A convex shape is its core (support) inflated by margin. Spheres and
+ * capsules are a point / segment with margin = radius, which keeps GJK on
+ * the cheap core distance for shallow contacts. data is borrowed and must
+ * outlive the query.
+ */
+typedef struct ConvexShape {
+    SupportFunction support;
+    const void*     data;
+    float           margin;
+} ConvexShape;
+
+/* Convex hull given by its points; only the extreme points matter */
+typedef struct ConvexPoints {
+    const Point3D* points;
+    int            count;
+} ConvexPoints;
+
+vec3 support_sphere(const void* shape, vec3 direction);         /* Sphere */
+vec3 support_capsule(const void* shape, vec3 direction);        /* Capsule */
+vec3 support_obb(const void* shape, vec3 direction);            /* OBB */
+vec3 support_aabb(const void* shape, vec3 direction);           /* AABB */
+vec3 support_triangle(const void* shape, vec3 direction);       /* Triangle */
+vec3 support_convex_points(const void* shape, vec3 direction);  /* ConvexPoints */
+
+static inline ConvexShape convex_shape_create(SupportFunction support, const void* data, float margin) {
+    return (ConvexShape){ .support = support, .data = data, .margin = margin };
+}
+
+static inline ConvexShape convex_shape_sphere(const Sphere* sphere) {
+    return convex_shape_create(support_sphere, sphere, sphere->radius);
+}
+
+static inline ConvexShape convex_shape_capsule(const Capsule* capsule) {
+    return convex_shape_create(support_capsule, capsule, capsule->radius);
+}
+
+static inline ConvexShape convex_shape_obb(const OBB* obb) {
+    return convex_shape_create(support_obb, obb, 0.0f);
+}
+
+static inline ConvexShape convex_shape_aabb(const AABB* aabb) {
+    return convex_shape_create(support_aabb, aabb, 0.0f);
+}
+
+static inline ConvexShape convex_shape_triangle(const Triangle* triangle) {
+    return convex_shape_create(support_triangle, triangle, 0.0f);
+}
+
+static inline ConvexShape convex_shape_points(const ConvexPoints* points) {
+    return convex_shape_create(support_convex_points, points, 0.0f);
+}
+
+/*******************************************************************************
+ * GJK / EPA
+ ******************************************************************************/
+
+/*
+ * Search directions of the last terminating simplex. Passing the same cache
+ * for a pair on consecutive frames re-evaluates those directions against the
+ * new poses, which usually converges in one or two iterations.
+ */
+typedef struct GJKCache {
+    vec3 directions[4];
+    int  count;
+} GJKCache;
+
+typedef struct GJKResult {
+    bool    intersecting;
+    float   distance;   /* Surface separation, 0 when intersecting */
+    float   depth;      /* Penetration depth, 0 when separated */
+    vec3    normal;     /* Unit, from A towards B */
+    Point3D point_a;    /* Closest / deepest point on A */
+    Point3D point_b;    /* Closest / deepest point on B */
+    int     iterations;
+} GJKResult;
+
+static inline void gjk_cache_init(GJKCache* cache) {
+    cache->count = 0;
+}
+
+/* Boolean overlap only; stops at the first separating direction */
+bool gjk_intersect(ConvexShape a, ConvexShape b, GJKCache* cache);
+
+/*
+ * Full query: distance and closest points when separated, EPA depth, normal
+ * and witness points when the cores overlap. cache may be NULL.
+ * Returns out_result->intersecting.
+ */
+bool gjk_query(ConvexShape a, ConvexShape b, GJKCache* cache, GJKResult* out_result);
+
+/* Single-contact manifold for any convex pair (no dedicated SAT routine needed) */
+bool find_collision_features_gjk(ConvexShape a, ConvexShape b, GJKCache* cache,
+                                 FixedManifold* out);
+
+#endif /* GEOM3D_GJK_H */
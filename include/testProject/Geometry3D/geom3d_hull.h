@@ -0,0 +1,130 @@
+/**
+ * @file geom3d_hull.h
+ * @brief Quickhull convex hull builder and convex hull collision
+ */
+#ifndef GEOM3D_HULL_H
+#define GEOM3D_HULL_H
+
+#include "geom3d_types.h"
+#include "geom3d_gjk.h"
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+
+/* Edges come in twin pairs: edge ^ 1 is the opposite half-edge */
+typedef struct HullHalfEdge {
+    int origin;     /* Vertex index */
+    int twin;       /* Opposite half-edge */
+    int next;       /* Next half-edge around face, CCW seen from outside */
+    int face;
+} HullHalfEdge;
+
+/* Coplanar triangles are merged, so faces are convex polygons */
+typedef struct HullFace {
+    int   edge;     /* Any half-edge of the face */
+    Plane plane;    /* Outward normal */
+} HullFace;
+
+/* Heap owned; release with convex_hull_free */
+typedef struct ConvexHull {
+    Point3D*      vertices;
+    HullHalfEdge* edges;
+    HullFace*     faces;
+    int           num_vertices;
+    int           num_edges;
+    int           num_faces;
+    Point3D       centroid;
+    AABB          bounds;
+} ConvexHull;
+
+typedef enum HullFeatureType {
+    HULL_FEATURE_NONE = 0,
+    HULL_FEATURE_FACE_A,    /* index_a is a face of A */
+    HULL_FEATURE_FACE_B,    /* index_b is a face of B */
+    HULL_FEATURE_EDGES      /* index_a / index_b are edges of A / B */
+} HullFeatureType;
+
+/*
+ * Axis of the last SAT query for a pair. It is tested first on the next
+ * frame; if it still separates, the full face / edge search is skipped.
+ */
+typedef struct HullFeatureCache {
+    HullFeatureType type;
+    int             index_a;
+    int             index_b;
+} HullFeatureCache;
+
+static inline ConvexHull convex_hull_default(void) {
+    ConvexHull hull = {0};
+    return hull;
+}
+
+static inline void hull_feature_cache_init(HullFeatureCache* cache) {
+    cache->type = HULL_FEATURE_NONE;
+    cache->index_a = -1;
+    cache->index_b = -1;
+}
+
+/*******************************************************************************
+ * Construction
+ ******************************************************************************/
+
+/*
+ * Builds the hull of a point cloud with quickhull. Fails (leaving out_hull
+ * empty) for fewer than 4 points or a flat / degenerate cloud.
+ */
+bool convex_hull_from_points(const Point3D* points, int count, ConvexHull* out_hull);
+bool convex_hull_from_mesh(const Mesh* mesh, ConvexHull* out_hull);
+void convex_hull_free(ConvexHull* hull);
+
+/* Deep copy; dst must be empty or previously freed */
+bool convex_hull_copy(const ConvexHull* src, ConvexHull* dst);
+
+/*
+ * Writes src transformed by a rigid (or uniformly scaled) world matrix into
+ * dst, which must be a copy of src. No allocation, so a per-body world-space
+ * hull can be refreshed every step.
+ */
+void convex_hull_transform(const ConvexHull* src, mat4 world, ConvexHull* dst);
+
+/*******************************************************************************
+ * Queries
+ ******************************************************************************/
+
+bool point_in_convex_hull(Point3D point, const ConvexHull* hull);
+
+/* Cyrus-Beck clip against the face planes; t = exit distance from inside */
+bool raycast_convex_hull(const ConvexHull* hull, Ray3D ray, RaycastResult* out_result);
+bool linetest_convex_hull(const ConvexHull* hull, Line3D line);
+
+/* Linear scan over the vertices; hull is a ConvexHull */
+vec3 support_convex_hull(const void* shape, vec3 direction);
+
+static inline ConvexShape convex_shape_hull(const ConvexHull* hull) {
+    return convex_shape_create(support_convex_hull, hull, 0.0f);
+}
+
+/*******************************************************************************
+ * Collision
+ ******************************************************************************/
+
+/* SAT over face normals and Gauss-map pruned edge pairs; cache may be NULL */
+bool convex_hull_convex_hull(const ConvexHull* A, const ConvexHull* B, HullFeatureCache* cache);
+bool convex_hull_obb(const ConvexHull* hull, OBB obb, HullFeatureCache* cache);
+bool convex_hull_sphere(const ConvexHull* hull, Sphere sphere);
+bool convex_hull_triangle(const ConvexHull* hull, Triangle triangle);
+
+/*
+ * Face contacts clip the incident face against the reference face and are
+ * reduced to MANIFOLD_REDUCED_CONTACTS points; edge contacts give a single
+ * point. Normal points from the hull / A towards the other shape.
+ */
+bool find_collision_features_hull_hull(const ConvexHull* A, const ConvexHull* B,
+                                       HullFeatureCache* cache, FixedManifold* out);
+bool find_collision_features_hull_obb(const ConvexHull* hull, OBB obb,
+                                      HullFeatureCache* cache, FixedManifold* out);
+bool find_collision_features_hull_sphere(const ConvexHull* hull, Sphere sphere,
+                                         FixedManifold* out);
+
+#endif /* GEOM3D_HULL_H */
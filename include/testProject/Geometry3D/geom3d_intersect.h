@@ -25,13 +25,31 @@ bool obb_plane(OBB obb, Plane plane);
 
 bool plane_plane(Plane p1, Plane p2);
 
+bool capsule_capsule(Capsule c1, Capsule c2);
+bool capsule_sphere(Capsule capsule, Sphere sphere);
+bool capsule_aabb(Capsule capsule, AABB aabb);
+bool capsule_obb(Capsule capsule, OBB obb);
+bool capsule_plane(Capsule capsule, Plane plane);
+
 bool triangle_sphere(Triangle t, Sphere s);
 bool triangle_aabb(Triangle t, AABB aabb);
 bool triangle_obb(Triangle t, OBB obb);
 bool triangle_plane(Triangle t, Plane p);
+bool triangle_capsule(Triangle t, Capsule c);
 bool triangle_triangle(Triangle t1, Triangle t2);
 bool triangle_triangle_robust(Triangle t1, Triangle t2);
 
+/*
+ * One box against many triangles: triangles[indices[i]] for i < count, or
+ * triangles[i] when indices is NULL. Indices of the overlapping triangles
+ * are written to out_indices (may be NULL) in input order; returns their
+ * count. Four triangles per step with SSE, scalar elsewhere.
+ */
+int triangle_aabb_batch(const Triangle* triangles, const int* indices, int count,
+                        AABB aabb, int* out_indices);
+int triangle_obb_batch(const Triangle* triangles, const int* indices, int count,
+                       OBB obb, int* out_indices);
+
 /* Argument order swap macros */
 #define aabb_sphere(aabb, sphere)     sphere_aabb(sphere, aabb)
 #define obb_sphere(obb, sphere)       sphere_obb(sphere, obb)
@@ -39,10 +57,15 @@ bool triangle_triangle_robust(Triangle t1, Triangle t2);
 #define obb_aabb(obb, aabb)           aabb_obb(aabb, obb)
 #define plane_aabb(plane, aabb)       aabb_plane(aabb, plane)
 #define plane_obb(plane, obb)         obb_plane(obb, plane)
+#define sphere_capsule(sphere, c)     capsule_sphere(c, sphere)
+#define aabb_capsule(aabb, c)         capsule_aabb(c, aabb)
+#define obb_capsule(obb, c)           capsule_obb(c, obb)
+#define plane_capsule(plane, c)       capsule_plane(c, plane)
 
 #define sphere_triangle(s, t)         triangle_sphere(t, s)
 #define aabb_triangle(a, t)           triangle_aabb(t, a)
 #define obb_triangle(o, t)            triangle_obb(t, o)
 #define plane_triangle(p, t)          triangle_plane(t, p)
+#define capsule_triangle(c, t)        triangle_capsule(t, c)
 
 #endif /* GEOM3D_INTERSECT_H */
\ No newline at end of file
@@ -6,6 +6,7 @@
 #define GEOM3D_MODEL_H
 
 #include "geom3d_types.h"
+#include "transform.h"
 
 /*******************************************************************************
  * Model Operations
@@ -15,6 +16,8 @@ void  model_set_content(Model* model, Mesh* mesh);
 Mesh* model_get_mesh(const Model* model);
 AABB  model_get_bounds(const Model* model);
 mat4  model_get_world_matrix(const Model* model);
+/* The same pose with the parent chain composed as transforms */
+Transform model_get_world_transform(const Model* model);
 OBB   model_get_obb(const Model* model);
 
 float model_ray(const Model* model, Ray3D ray);
@@ -24,6 +27,12 @@ bool  model_aabb(const Model* model, AABB aabb);
 bool  model_obb(const Model* model, OBB obb);
 bool  model_plane(const Model* model, Plane plane);
 bool  model_triangle(const Model* model, Triangle triangle);
+bool  model_capsule(const Model* model, Capsule capsule);
+
+/* Casts in the model's local space; point and normal come back in world space */
+bool  model_sweep_sphere(const Model* model, Sphere sphere, vec3 motion, RaycastResult* out_result);
+bool  model_sweep_capsule(const Model* model, Capsule capsule, vec3 motion, RaycastResult* out_result);
+bool  model_sweep_obb(const Model* model, OBB obb, vec3 motion, RaycastResult* out_result);
 
 #ifndef NO_EXTRAS
 float raycast_model(const Model* model, Ray3D ray);
@@ -1,6 +1,6 @@
 /**
  * @file geom3d_primitives.h
- * @brief Basic primitive operations (Line3D, Ray3D, AABB, Plane)
+ * @brief Basic primitive operations (Line3D, Ray3D, AABB, OBB, Capsule, Plane)
  */
 #ifndef GEOM3D_PRIMITIVES_H
 #define GEOM3D_PRIMITIVES_H
@@ -28,6 +28,22 @@ vec3 aabb_get_min(AABB aabb);
 vec3 aabb_get_max(AABB aabb);
 AABB aabb_from_min_max(vec3 min, vec3 max);
 
+/* Bounds of aabb over a translation by motion */
+AABB aabb_swept(AABB aabb, vec3 motion);
+
+/*******************************************************************************
+ * OBB Operations
+ ******************************************************************************/
+
+AABB obb_get_bounds(OBB obb);
+
+/*******************************************************************************
+ * Capsule Operations
+ ******************************************************************************/
+
+Line3D capsule_get_segment(Capsule capsule);
+AABB   capsule_get_bounds(Capsule capsule);
+
 /*******************************************************************************
  * Plane Operations
  ******************************************************************************/
@@ -49,6 +65,7 @@ void ray3d_print(FILE* stream, Ray3D shape);
 void sphere_print(FILE* stream, Sphere shape);
 void aabb_print(FILE* stream, AABB shape);
 void obb_print(FILE* stream, OBB shape);
+void capsule_print(FILE* stream, Capsule shape);
 void plane_print(FILE* stream, Plane shape);
 void triangle_print(FILE* stream, Triangle shape);
 #endif
@@ -18,6 +18,7 @@ bool point_on_plane(Point3D point, Plane plane);
 bool point_on_line3d(Point3D point, Line3D line);
 bool point_on_ray3d(Point3D point, Ray3D ray);
 bool point_in_triangle(Point3D point, Triangle triangle);
+bool point_in_capsule(Point3D point, Capsule capsule);
 
 #ifndef NO_EXTRAS
 /* Alias functions for convenience */
@@ -51,6 +52,13 @@ Point3D closest_point_on_plane(Plane plane, Point3D point);
 Point3D closest_point_on_line3d(Line3D line, Point3D point);
 Point3D closest_point_on_ray3d(Ray3D ray, Point3D point);
 Point3D closest_point_on_triangle(Triangle triangle, Point3D point);
+Point3D closest_point_on_capsule(Capsule capsule, Point3D point);
+
+/* Closest points between two segments; returns their squared distance */
+float closest_points_line3d_line3d(Line3D l1, Line3D l2, Point3D* out_p1, Point3D* out_p2);
+
+/* Closest points between a segment and a triangle; returns their squared distance */
+float closest_points_line3d_triangle(Line3D line, Triangle triangle, Point3D* out_line, Point3D* out_triangle);
 
 #ifndef NO_EXTRAS
 /* Reversed argument order variants */
@@ -61,6 +69,7 @@ Point3D closest_point_on_triangle(Triangle triangle, Point3D point);
 #define closest_point_point_line3d(point, line)       closest_point_on_line3d(line, point)
 #define closest_point_point_ray3d(point, ray)         closest_point_on_ray3d(ray, point)
 #define closest_point_point_triangle(point, triangle) closest_point_on_triangle(triangle, point)
+#define closest_point_point_capsule(point, capsule)   closest_point_on_capsule(capsule, point)
 #endif
 
 #endif /* GEOM3D_QUERIES_H */
\ No newline at end of file
@@ -16,6 +16,7 @@ bool raycast_aabb(AABB aabb, Ray3D ray, RaycastResult* out_result);
 bool raycast_obb(OBB obb, Ray3D ray, RaycastResult* out_result);
 bool raycast_plane(Plane plane, Ray3D ray, RaycastResult* out_result);
 bool raycast_triangle(Triangle triangle, Ray3D ray, RaycastResult* out_result);
+bool raycast_capsule(Capsule capsule, Ray3D ray, RaycastResult* out_result);
 
 #ifndef NO_EXTRAS
 /* Reversed argument order variants */
@@ -23,6 +24,7 @@ bool raycast_triangle(Triangle triangle, Ray3D ray, RaycastResult* out_result);
 #define raycast_ray_aabb(ray, aabb, result)     raycast_aabb(aabb, ray, result)
 #define raycast_ray_obb(ray, obb, result)       raycast_obb(obb, ray, result)
 #define raycast_ray_plane(ray, plane, result)   raycast_plane(plane, ray, result)
+#define raycast_ray_capsule(ray, c, result)     raycast_capsule(c, ray, result)
 #endif
 
 /*******************************************************************************
@@ -34,6 +36,7 @@ bool linetest_aabb(AABB aabb, Line3D line);
 bool linetest_obb(OBB obb, Line3D line);
 bool linetest_plane(Plane plane, Line3D line);
 bool linetest_triangle(Triangle triangle, Line3D line);
+bool linetest_capsule(Capsule capsule, Line3D line);
 
 #ifndef NO_EXTRAS
 /* Reversed argument order variants */
@@ -41,6 +44,7 @@ bool linetest_triangle(Triangle triangle, Line3D line);
 #define linetest_line_aabb(line, aabb)     linetest_aabb(aabb, line)
 #define linetest_line_obb(line, obb)       linetest_obb(obb, line)
 #define linetest_line_plane(line, plane)   linetest_plane(plane, line)
+#define linetest_line_capsule(line, c)     linetest_capsule(c, line)
 #endif
 
 #endif /* GEOM3D_RAYCAST_H */
\ No newline at end of file
@@ -21,6 +21,16 @@ bool overlap_on_axis_aabb_triangle(AABB aabb, Triangle tri, vec3 axis);
 bool overlap_on_axis_obb_triangle(OBB obb, Triangle tri, vec3 axis);
 bool overlap_on_axis_triangle_triangle(Triangle t1, Triangle t2, vec3 axis);
 
+/* Added to |R[i][j]| by the OBB-OBB tests */
+#define OBB_SAT_EPSILON 1.0e-6f
+
+/*
+ * Full OBB-OBB SAT on the relative rotation, stopping at the first
+ * separating axis. out_normal / out_depth (either may be NULL) receive the
+ * unit axis of least penetration, pointing from a towards b, and its depth.
+ */
+bool obb_obb_sat(OBB a, OBB b, vec3* out_normal, float* out_depth);
+
 /*******************************************************************************
  * Triangle Utilities
  ******************************************************************************/
@@ -0,0 +1,174 @@
+/**
+ * @file geom3d_simd.h
+ * @brief Four-lane float helpers over SSE, NEON and WASM SIMD128
+ *
+ * Internal to the batch kernels. simd4m is a lane mask (all ones / zero per
+ * lane) from the comparisons; simd4m_bits packs it to the low four bits.
+ * Define GEOM3D_NO_SIMD to force the scalar fallback.
+ *
+ * The NEON and WASM SIMD128 paths have not been built or tested yet, so
+ * those targets take the scalar fallback unless GEOM3D_SIMD_NEON_WASM is
+ * defined.
+ */
+#ifndef GEOM3D_SIMD_H
+#define GEOM3D_SIMD_H
+
+#include <stdint.h>
+
+#if defined(GEOM3D_NO_SIMD)
+#define GEOM3D_SIMD_SCALAR 1
+#elif defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#define GEOM3D_SIMD_SSE 1
+#include <xmmintrin.h>
+#elif defined(GEOM3D_SIMD_NEON_WASM) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define GEOM3D_SIMD_NEON 1
+#include <arm_neon.h>
+#elif defined(GEOM3D_SIMD_NEON_WASM) && defined(__wasm_simd128__)
+#define GEOM3D_SIMD_WASM 1
+#include <wasm_simd128.h>
+#else
+#define GEOM3D_SIMD_SCALAR 1
+#endif
+
+/*******************************************************************************
+ * SSE
+ ******************************************************************************/
+
+#if defined(GEOM3D_SIMD_SSE)
+
+typedef __m128 simd4f;
+typedef __m128 simd4m;
+
+static inline simd4f simd4f_load(const float* p)            { return _mm_loadu_ps(p); }
+static inline void   simd4f_store(float* p, simd4f a)       { _mm_storeu_ps(p, a); }
+static inline simd4f simd4f_set1(float x)                   { return _mm_set1_ps(x); }
+static inline simd4f simd4f_zero(void)                      { return _mm_setzero_ps(); }
+static inline simd4f simd4f_add(simd4f a, simd4f b)         { return _mm_add_ps(a, b); }
+static inline simd4f simd4f_sub(simd4f a, simd4f b)         { return _mm_sub_ps(a, b); }
+static inline simd4f simd4f_mul(simd4f a, simd4f b)         { return _mm_mul_ps(a, b); }
+static inline simd4f simd4f_min(simd4f a, simd4f b)         { return _mm_min_ps(a, b); }
+static inline simd4f simd4f_max(simd4f a, simd4f b)         { return _mm_max_ps(a, b); }
+static inline simd4f simd4f_abs(simd4f a)                   { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+static inline simd4f simd4f_neg(simd4f a)                   { return _mm_xor_ps(_mm_set1_ps(-0.0f), a); }
+static inline simd4m simd4f_gt(simd4f a, simd4f b)          { return _mm_cmpgt_ps(a, b); }
+static inline simd4m simd4f_lt(simd4f a, simd4f b)          { return _mm_cmplt_ps(a, b); }
+static inline simd4m simd4f_le(simd4f a, simd4f b)          { return _mm_cmple_ps(a, b); }
+static inline simd4m simd4m_or(simd4m a, simd4m b)          { return _mm_or_ps(a, b); }
+static inline simd4m simd4m_and(simd4m a, simd4m b)         { return _mm_and_ps(a, b); }
+static inline simd4m simd4m_none(void)                      { return _mm_setzero_ps(); }
+static inline int    simd4m_bits(simd4m m)                  { return _mm_movemask_ps(m); }
+
+/*******************************************************************************
+ * NEON
+ ******************************************************************************/
+
+#elif defined(GEOM3D_SIMD_NEON)
+
+typedef float32x4_t simd4f;
+typedef uint32x4_t  simd4m;
+
+static inline simd4f simd4f_load(const float* p)            { return vld1q_f32(p); }
+static inline void   simd4f_store(float* p, simd4f a)       { vst1q_f32(p, a); }
+static inline simd4f simd4f_set1(float x)                   { return vdupq_n_f32(x); }
+static inline simd4f simd4f_zero(void)                      { return vdupq_n_f32(0.0f); }
+static inline simd4f simd4f_add(simd4f a, simd4f b)         { return vaddq_f32(a, b); }
+static inline simd4f simd4f_sub(simd4f a, simd4f b)         { return vsubq_f32(a, b); }
+static inline simd4f simd4f_mul(simd4f a, simd4f b)         { return vmulq_f32(a, b); }
+static inline simd4f simd4f_min(simd4f a, simd4f b)         { return vminq_f32(a, b); }
+static inline simd4f simd4f_max(simd4f a, simd4f b)         { return vmaxq_f32(a, b); }
+static inline simd4f simd4f_abs(simd4f a)                   { return vabsq_f32(a); }
+static inline simd4f simd4f_neg(simd4f a)                   { return vnegq_f32(a); }
+static inline simd4m simd4f_gt(simd4f a, simd4f b)          { return vcgtq_f32(a, b); }
+static inline simd4m simd4f_lt(simd4f a, simd4f b)          { return vcltq_f32(a, b); }
+static inline simd4m simd4f_le(simd4f a, simd4f b)          { return vcleq_f32(a, b); }
+static inline simd4m simd4m_or(simd4m a, simd4m b)          { return vorrq_u32(a, b); }
+static inline simd4m simd4m_and(simd4m a, simd4m b)         { return vandq_u32(a, b); }
+static inline simd4m simd4m_none(void)                      { return vdupq_n_u32(0); }
+
+static inline int simd4m_bits(simd4m m) {
+    static const uint32_t weights[4] = { 1, 2, 4, 8 };
+    uint32x4_t w = vandq_u32(m, vld1q_u32(weights));
+#if defined(__aarch64__)
+    return (int)vaddvq_u32(w);
+#else
+    uint32x2_t s = vadd_u32(vget_low_u32(w), vget_high_u32(w));
+    return (int)vget_lane_u32(vpadd_u32(s, s), 0);
+#endif
+}
+
+/*******************************************************************************
+ * WASM SIMD128
+ ******************************************************************************/
+
+#elif defined(GEOM3D_SIMD_WASM)
+
+typedef v128_t simd4f;
+typedef v128_t simd4m;
+
+static inline simd4f simd4f_load(const float* p)            { return wasm_v128_load(p); }
+static inline void   simd4f_store(float* p, simd4f a)       { wasm_v128_store(p, a); }
+static inline simd4f simd4f_set1(float x)                   { return wasm_f32x4_splat(x); }
+static inline simd4f simd4f_zero(void)                      { return wasm_f32x4_splat(0.0f); }
+static inline simd4f simd4f_add(simd4f a, simd4f b)         { return wasm_f32x4_add(a, b); }
+static inline simd4f simd4f_sub(simd4f a, simd4f b)         { return wasm_f32x4_sub(a, b); }
+static inline simd4f simd4f_mul(simd4f a, simd4f b)         { return wasm_f32x4_mul(a, b); }
+static inline simd4f simd4f_min(simd4f a, simd4f b)         { return wasm_f32x4_pmin(a, b); }
+static inline simd4f simd4f_max(simd4f a, simd4f b)         { return wasm_f32x4_pmax(a, b); }
+static inline simd4f simd4f_abs(simd4f a)                   { return wasm_f32x4_abs(a); }
+static inline simd4f simd4f_neg(simd4f a)                   { return wasm_f32x4_neg(a); }
+static inline simd4m simd4f_gt(simd4f a, simd4f b)          { return wasm_f32x4_gt(a, b); }
+static inline simd4m simd4f_lt(simd4f a, simd4f b)          { return wasm_f32x4_lt(a, b); }
+static inline simd4m simd4f_le(simd4f a, simd4f b)          { return wasm_f32x4_le(a, b); }
+static inline simd4m simd4m_or(simd4m a, simd4m b)          { return wasm_v128_or(a, b); }
+static inline simd4m simd4m_and(simd4m a, simd4m b)         { return wasm_v128_and(a, b); }
+static inline simd4m simd4m_none(void)                      { return wasm_i32x4_splat(0); }
+static inline int    simd4m_bits(simd4m m)                  { return (int)wasm_i32x4_bitmask(m); }
+
+/*******************************************************************************
+ * Scalar Fallback
+ ******************************************************************************/
+
+#else
+
+typedef struct simd4f { float v[4]; } simd4f;
+typedef struct simd4m { uint32_t v[4]; } simd4m;
+
+#define GEOM3D_SIMD_LANES(type, expr) \
+    type r; for (int i = 0; i < 4; ++i) { r.v[i] = (expr); } return r
+
+static inline simd4f simd4f_load(const float* p)            { GEOM3D_SIMD_LANES(simd4f, p[i]); }
+static inline void   simd4f_store(float* p, simd4f a)       { for (int i = 0; i < 4; ++i) { p[i] = a.v[i]; } }
+static inline simd4f simd4f_set1(float x)                   { GEOM3D_SIMD_LANES(simd4f, x); }
+static inline simd4f simd4f_zero(void)                      { GEOM3D_SIMD_LANES(simd4f, 0.0f); }
+static inline simd4f simd4f_add(simd4f a, simd4f b)         { GEOM3D_SIMD_LANES(simd4f, a.v[i] + b.v[i]); }
+static inline simd4f simd4f_sub(simd4f a, simd4f b)         { GEOM3D_SIMD_LANES(simd4f, a.v[i] - b.v[i]); }
+static inline simd4f simd4f_mul(simd4f a, simd4f b)         { GEOM3D_SIMD_LANES(simd4f, a.v[i] * b.v[i]); }
+static inline simd4f simd4f_min(simd4f a, simd4f b)         { GEOM3D_SIMD_LANES(simd4f, a.v[i] < b.v[i] ? a.v[i] : b.v[i]); }
+static inline simd4f simd4f_max(simd4f a, simd4f b)         { GEOM3D_SIMD_LANES(simd4f, a.v[i] > b.v[i] ? a.v[i] : b.v[i]); }
+static inline simd4f simd4f_abs(simd4f a)                   { GEOM3D_SIMD_LANES(simd4f, a.v[i] < 0.0f ? -a.v[i] : a.v[i]); }
+static inline simd4f simd4f_neg(simd4f a)                   { GEOM3D_SIMD_LANES(simd4f, -a.v[i]); }
+static inline simd4m simd4f_gt(simd4f a, simd4f b)          { GEOM3D_SIMD_LANES(simd4m, a.v[i] > b.v[i] ? 0xFFFFFFFFu : 0u); }
+static inline simd4m simd4f_lt(simd4f a, simd4f b)          { GEOM3D_SIMD_LANES(simd4m, a.v[i] < b.v[i] ? 0xFFFFFFFFu : 0u); }
+static inline simd4m simd4f_le(simd4f a, simd4f b)          { GEOM3D_SIMD_LANES(simd4m, a.v[i] <= b.v[i] ? 0xFFFFFFFFu : 0u); }
+static inline simd4m simd4m_or(simd4m a, simd4m b)          { GEOM3D_SIMD_LANES(simd4m, a.v[i] | b.v[i]); }
+static inline simd4m simd4m_and(simd4m a, simd4m b)         { GEOM3D_SIMD_LANES(simd4m, a.v[i] & b.v[i]); }
+static inline simd4m simd4m_none(void)                      { GEOM3D_SIMD_LANES(simd4m, 0u); }
+
+static inline int simd4m_bits(simd4m m) {
+    int bits = 0;
+    for (int i = 0; i < 4; ++i) {
+        bits |= (m.v[i] != 0u) << i;
+    }
+    return bits;
+}
+
+#undef GEOM3D_SIMD_LANES
+
+#endif
+
+/* a * b + c, lane-wise */
+static inline simd4f simd4f_madd(simd4f a, simd4f b, simd4f c) {
+    return simd4f_add(simd4f_mul(a, b), c);
+}
+
+#endif /* GEOM3D_SIMD_H */
@@ -0,0 +1,83 @@
+/**
+ * @file geom3d_sweep.h
+ * @brief Swept shape casts and continuous collision (time of impact)
+ */
+#ifndef GEOM3D_SWEEP_H
+#define GEOM3D_SWEEP_H
+
+#include "geom3d_types.h"
+#include "geom3d_gjk.h"
+
+#define SWEEP_TOLERANCE      1.0e-4f    /* Separation at which an advancing cast reports contact */
+#define SWEEP_MAX_ITERATIONS 32
+
+/*******************************************************************************
+ * Shape Casts
+ *
+ * A shape moves by motion (start pose to start + motion) against a static
+ * target. On a hit out_result->t is the time of impact as a fraction of
+ * motion in [0, 1], point is the contact on the target and normal the unit
+ * target normal facing the moving shape. Shapes already overlapping at the
+ * start report t = 0 with the penetration normal.
+ ******************************************************************************/
+
+/* Exact: inflated-triangle raycast (face prism plus edge capsules) */
+bool sweep_sphere_triangle(Sphere sphere, vec3 motion, Triangle triangle, RaycastResult* out_result);
+
+/* Conservative advancement on GJK distance; t stops just short of contact */
+bool sweep_capsule_triangle(Capsule capsule, vec3 motion, Triangle triangle, RaycastResult* out_result);
+bool sweep_obb_triangle(OBB obb, vec3 motion, Triangle triangle, RaycastResult* out_result);
+
+/*
+ * Any convex pair; target is static. If the shapes have not come within
+ * tolerance after SWEEP_MAX_ITERATIONS, the hit is reported at the t
+ * reached so far, which is never past the first contact; point and normal
+ * are then the closest features at that t. A shape that only grazes past
+ * can so report a hit, but never passes through.
+ */
+bool shape_cast(ConvexShape shape, vec3 motion, ConvexShape target, RaycastResult* out_result);
+
+/*******************************************************************************
+ * Continuous Collision
+ *
+ * Conservative advancement (Mirtich) for bodies that translate and rotate
+ * over a step. Shapes are given in body space about the rotation centre.
+ * t is the first contact time in seconds within [0, dt]; point and normal
+ * follow the shape cast convention, with b as the target. Like shape_cast,
+ * running out of iterations reports a hit at the conservative t reached,
+ * so a slow convergence never lets the bodies tunnel.
+ ******************************************************************************/
+
+/* Rotation loosens the advancement bound, so convergence takes more steps */
+#define CCD_MAX_ITERATIONS 128
+
+/* Pose at the start of the step and velocities, constant over the step */
+typedef struct RigidMotion {
+    Point3D position;           /* Rotation centre */
+    mat3    orientation;        /* Rows are the body axes in world space */
+    vec3    linear_velocity;
+    vec3    angular_velocity;   /* World space, radians per second */
+} RigidMotion;
+
+static inline RigidMotion rigid_motion_create(Point3D position, mat3 orientation,
+                                              vec3 linear_velocity, vec3 angular_velocity) {
+    return (RigidMotion){
+        .position = position,
+        .orientation = orientation,
+        .linear_velocity = linear_velocity,
+        .angular_velocity = angular_velocity
+    };
+}
+
+void rigid_motion_pose(const RigidMotion* motion, float t, Point3D* out_position, mat3* out_orientation);
+
+bool time_of_impact(ConvexShape a, const RigidMotion* motion_a,
+                    ConvexShape b, const RigidMotion* motion_b,
+                    float dt, RaycastResult* out_result);
+
+/* OBBs rotate about their centres; their pose is the start of the step */
+bool time_of_impact_obb_obb(OBB a, vec3 linear_a, vec3 angular_a,
+                            OBB b, vec3 linear_b, vec3 angular_b,
+                            float dt, RaycastResult* out_result);
+
+#endif /* GEOM3D_SWEEP_H */
@@ -43,6 +43,13 @@ typedef struct OBB {
     mat3    orientation;
 } OBB;
 
+/* Segment swept by a sphere: all points within radius of start..end */
+typedef struct Capsule {
+    Point3D start;
+    Point3D end;
+    float   radius;
+} Capsule;
+
 typedef struct Plane {
     vec3  normal;
     float distance;
@@ -133,6 +140,31 @@ typedef struct CollisionManifold {
     ContactArray contacts;
 } CollisionManifold;
 
+/* Inline contact storage; same data/count access pattern as ContactArray */
+#define FIXED_MANIFOLD_MAX_CONTACTS 8
+
+typedef struct FixedContactArray {
+    vec3 data[FIXED_MANIFOLD_MAX_CONTACTS];
+    int  count;
+} FixedContactArray;
+
+/* Allocation-free manifold, safe to memcpy and to store in flat arrays */
+typedef struct FixedManifold {
+    bool              colliding;
+    bool              truncated;    /* More contacts were found than fit; some were dropped */
+    vec3              normal;
+    float             depth;
+    FixedContactArray contacts;
+} FixedManifold;
+
+/* Arena of FixedManifolds, reused between steps without freeing */
+typedef struct ManifoldPool {
+    FixedManifold* data;
+    int            count;
+    int            capacity;
+    FixedManifold  overflow;    /* Handed out when growing fails; never committed */
+} ManifoldPool;
+
 /* Dynamic array for Line3D (replaces std::vector<Line>) */
 typedef struct Line3DArray {
     Line3D* data;
@@ -211,6 +243,14 @@ static inline OBB obb_default(void) {
     return (OBB){ .position = {{{0, 0, 0}}}, .size = {{{1, 1, 1}}}, .orientation = mat3_identity() };
 }
 
+static inline Capsule capsule_create(Point3D start, Point3D end, float radius) {
+    return (Capsule){ .start = start, .end = end, .radius = radius };
+}
+
+static inline Capsule capsule_default(void) {
+    return (Capsule){ .start = {{{0, -0.5f, 0}}}, .end = {{{0, 0.5f, 0}}}, .radius = 0.5f };
+}
+
 static inline Plane plane_create(vec3 normal, float distance) {
     return (Plane){ .normal = normal, .distance = distance };
 }
@@ -0,0 +1,191 @@
+#ifndef CYCLONE_BODY_H
+#define CYCLONE_BODY_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "core.h"
+#include "snapshot.h"
+
+/*
+ * Cyclone rigid-body world.
+ *
+ * Body state is stored as structure-of-arrays, one real array per
+ * component, like the particle world. Each step:
+ *
+ *   1. cyclone_body_world_calculate_derived_data() rebuilds every body's
+ *      transform matrix and world-space inverse inertia tensor from its
+ *      position and orientation in one batched pass.
+ *   2. Forces and torques are accumulated (add_force / add_torque ...).
+ *   3. cyclone_body_world_integrate() advances the awake bodies, refreshes
+ *      their derived data and puts bodies that have stopped moving to
+ *      sleep.
+ *
+ * Matrices follow core.h: transform[n] is cyclone_Matrix4.data[n] and the
+ * inertia tensors use the cyclone_Matrix3.data layout.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Damping given to new bodies (fraction of velocity kept per second) */
+#define CYCLONE_BODY_DEFAULT_LINEAR_DAMPING  ((real)0.99)
+#define CYCLONE_BODY_DEFAULT_ANGULAR_DAMPING ((real)0.8)
+
+typedef struct cyclone_BodyWorld {
+    /* State */
+    real *position[3];
+    real *orientation[4];                   /* r, i, j, k */
+    real *velocity[3];
+    real *rotation[3];                      /* angular velocity */
+    real *acceleration[3];                  /* constant part, e.g. gravity */
+    real *inverse_mass;                     /* zero for immovable bodies */
+    real *inverse_inertia_tensor[9];        /* body space */
+    real *linear_damping;
+    real *angular_damping;
+
+    /* Accumulators, cleared after every integration */
+    real *force_accum[3];
+    real *torque_accum[3];
+
+    /* Derived data */
+    real *transform[12];                    /* body to world */
+    real *inverse_inertia_tensor_world[9];
+    real *last_frame_acceleration[3];       /* linear acceleration of the last step */
+
+    /* Sleep */
+    real *motion;                           /* recency-weighted kinetic energy */
+    bool *is_awake;
+    bool *can_sleep;
+
+    /*
+     * When set, integrate() keeps the motion averages up to date but never
+     * puts a body to sleep by itself; islands.h decides for whole islands.
+     */
+    bool island_sleep;
+
+    size_t count;
+    size_t capacity;
+
+    /* damping^dt per body and 0.5^dt, cached for damping_step */
+    real *linear_damping_factor;
+    real *angular_damping_factor;
+    real  sleep_bias;
+    real  damping_step;
+} cyclone_BodyWorld;
+
+/*
+ * Initialise an empty world. Always succeeds; nothing is allocated
+ * until bodies are added.
+ */
+void cyclone_body_world_init(cyclone_BodyWorld *world);
+
+/*
+ * Free all body storage and reset to empty.
+ */
+void cyclone_body_world_free(cyclone_BodyWorld *world);
+
+/*
+ * Make room for at least capacity bodies.
+ * Returns false on allocation failure (the world is left unchanged).
+ */
+bool cyclone_body_world_reserve(cyclone_BodyWorld *world, size_t capacity);
+
+/*
+ * Append an awake body at rest. mass <= 0 creates an immovable body, whose
+ * inertia tensor is ignored. inertia_tensor is in body space.
+ * Writes the new index to *out_index (may be NULL).
+ * Returns false on allocation failure.
+ */
+bool cyclone_body_world_add(cyclone_BodyWorld *world,
+                            cyclone_Vector3 position,
+                            cyclone_Quaternion orientation,
+                            real mass,
+                            const cyclone_Matrix3 *inertia_tensor,
+                            size_t *out_index);
+
+/* Per-body accessors */
+
+cyclone_Vector3 cyclone_body_world_get_position(const cyclone_BodyWorld *world, size_t i);
+cyclone_Quaternion cyclone_body_world_get_orientation(const cyclone_BodyWorld *world, size_t i);
+cyclone_Vector3 cyclone_body_world_get_velocity(const cyclone_BodyWorld *world, size_t i);
+cyclone_Vector3 cyclone_body_world_get_rotation(const cyclone_BodyWorld *world, size_t i);
+cyclone_Vector3 cyclone_body_world_get_last_frame_acceleration(const cyclone_BodyWorld *world, size_t i);
+cyclone_Matrix4 cyclone_body_world_get_transform(const cyclone_BodyWorld *world, size_t i);
+cyclone_Matrix3 cyclone_body_world_get_inverse_inertia_tensor_world(const cyclone_BodyWorld *world, size_t i);
+
+void cyclone_body_world_set_position(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 position);
+void cyclone_body_world_set_orientation(cyclone_BodyWorld *world, size_t i, cyclone_Quaternion orientation);
+void cyclone_body_world_set_velocity(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 velocity);
+void cyclone_body_world_set_rotation(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 rotation);
+void cyclone_body_world_set_acceleration(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 acceleration);
+void cyclone_body_world_set_mass(cyclone_BodyWorld *world, size_t i, real mass);
+void cyclone_body_world_set_inertia_tensor(cyclone_BodyWorld *world, size_t i, const cyclone_Matrix3 *inertia_tensor);
+void cyclone_body_world_set_damping(cyclone_BodyWorld *world, size_t i, real linear, real angular);
+
+/*
+ * Waking gives the body enough motion not to fall straight back asleep;
+ * putting it to sleep zeroes its velocity, rotation and accumulators.
+ */
+bool cyclone_body_world_is_awake(const cyclone_BodyWorld *world, size_t i);
+void cyclone_body_world_set_awake(cyclone_BodyWorld *world, size_t i, bool awake);
+
+/*
+ * Bodies that may never sleep (e.g. player controlled) are woken here too.
+ */
+void cyclone_body_world_set_can_sleep(cyclone_BodyWorld *world, size_t i, bool can_sleep);
+
+/* Force and torque accumulation; each wakes the body */
+
+void cyclone_body_world_add_force(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 force);
+void cyclone_body_world_add_torque(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 torque);
+
+/* Force through a point given in world space */
+void cyclone_body_world_add_force_at_point(cyclone_BodyWorld *world, size_t i,
+                                           cyclone_Vector3 force, cyclone_Vector3 point);
+
+/* Force through a point given in body space */
+void cyclone_body_world_add_force_at_body_point(cyclone_BodyWorld *world, size_t i,
+                                                cyclone_Vector3 force, cyclone_Vector3 point);
+
+/*
+ * Renormalise every orientation and rebuild transform and
+ * inverse_inertia_tensor_world for all bodies. Call after moving bodies
+ * by hand; integrate() does it for the bodies it advances.
+ */
+void cyclone_body_world_calculate_derived_data(cyclone_BodyWorld *world);
+
+/*
+ * The same for body i alone.
+ */
+void cyclone_body_world_update_derived_data(cyclone_BodyWorld *world, size_t i);
+
+/*
+ * Advance every awake body by duration: linear and angular acceleration
+ * from the accumulators, damping, semi-implicit Euler on position and
+ * orientation, derived data, then the sleep test against
+ * cyclone_sleep_epsilon on the running average of v.v + w.w (unless
+ * island_sleep is set). Clears the accumulators of the awake bodies.
+ */
+void cyclone_body_world_integrate(cyclone_BodyWorld *world, real duration);
+
+/*
+ * Append the state of every body to the snapshot: all per-body arrays,
+ * derived data and sleep state included, so a loaded world steps exactly
+ * like the saved one. island_sleep is a setting and is not saved.
+ * Returns false on allocation failure.
+ */
+bool cyclone_body_world_save(const cyclone_BodyWorld *world, cyclone_Snapshot *snapshot);
+
+/*
+ * Read back state written by cyclone_body_world_save at *cursor. Bodies
+ * added since the save are dropped. Returns false, leaving the world
+ * unchanged, if the snapshot is short or storage cannot grow.
+ */
+bool cyclone_body_world_load(cyclone_BodyWorld *world, const cyclone_Snapshot *snapshot, size_t *cursor);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CYCLONE_BODY_H */
@@ -0,0 +1,209 @@
+#ifndef CYCLONE_CONTACTS_H
+#define CYCLONE_CONTACTS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "core.h"
+#include "body.h"
+#include "jobs.h"
+#include "snapshot.h"
+#include "Geometry3D/geom3d_types.h"
+
+/*
+ * Sequential-impulse contact solver for the rigid-body world.
+ *
+ * Each step, after cyclone_body_world_integrate() and collision detection,
+ * add the manifolds from geom3d (normal pointing from body a to body b)
+ * and call cyclone_contact_solver_solve(). Every manifold point becomes one
+ * constraint row in a flat array holding a normal and two friction
+ * directions, with the effective mass of each precomputed once per step.
+ * Impulses are then applied iteratively (Gauss-Seidel) with accumulated
+ * clamping: normal >= 0, friction inside the box |f| <= mu * normal.
+ *
+ * Impulses from the previous step are matched to the new contacts by body
+ * pair and nearby body-space anchor and used as a starting guess (warm
+ * starting), which lets stacks settle in far fewer iterations.
+ *
+ * With threads > 1 the rows are first coloured greedily so that no two
+ * rows of one colour share a movable body; each colour is then swept in
+ * parallel, one colour after another. Colouring depends only on the row
+ * order, so colour-ordered results are bit-identical for any thread count;
+ * set deterministic to use the same order on one thread as well.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Body index for the static world: infinite mass, never moves */
+#define CYCLONE_CONTACT_STATIC ((size_t)-1)
+
+/* Cached impulses are reused for anchors closer than this */
+#define CYCLONE_CONTACT_MATCH_DISTANCE ((real)0.05)
+
+/* Colours tried per row; rows left over are swept on one thread at the end */
+#define CYCLONE_CONTACT_MAX_COLORS 64
+
+typedef enum cyclone_PositionCorrection {
+    /* Penetration fed back as extra separating velocity */
+    CYCLONE_POSITION_BAUMGARTE,
+    /*
+     * Penetration resolved by separate pseudo velocities that move the
+     * bodies but are then discarded, so correction adds no energy
+     */
+    CYCLONE_POSITION_SPLIT_IMPULSE
+} cyclone_PositionCorrection;
+
+typedef struct cyclone_ContactConstraint {
+    size_t body[2];                 /* a, b; either may be CYCLONE_CONTACT_STATIC */
+    size_t slot[2];                 /* index into the solver's body table */
+
+    cyclone_Vector3 point;          /* world space */
+    cyclone_Vector3 anchor;         /* point in a's body space, for warm starting */
+    cyclone_Vector3 direction[3];   /* normal (a to b), then two tangents */
+    real depth;
+    real friction;
+    real restitution;
+
+    /* Per step, from prepare */
+    cyclone_Vector3 arm[3][2];      /* r x direction, per body */
+    cyclone_Vector3 spin[3][2];     /* I^-1 (r x direction): rotation per unit impulse */
+    real mass[3];                   /* effective mass along each direction */
+    real velocity_bias;             /* target separating speed from restitution / Baumgarte */
+    real position_bias;             /* target pseudo speed for split impulse */
+    bool active;                    /* false when both bodies sleep */
+    int color;                      /* CYCLONE_CONTACT_MAX_COLORS when uncoloured */
+
+    /* Accumulated impulses, warm started */
+    real impulse[3];
+    real pseudo_impulse;
+} cyclone_ContactConstraint;
+
+/* Velocities of one body while solving */
+typedef struct cyclone_SolverBody {
+    cyclone_Vector3 velocity;
+    cyclone_Vector3 rotation;
+    cyclone_Vector3 pseudo_velocity;
+    cyclone_Vector3 pseudo_rotation;
+    real inverse_mass;
+    size_t index;                   /* body in the world */
+} cyclone_SolverBody;
+
+typedef struct cyclone_ContactSolverStats {
+    size_t constraints;             /* rows solved (active) */
+    size_t warm_started;            /* rows matched to a cached impulse */
+    int    iterations;              /* velocity iterations run */
+    real   residual;                /* largest impulse change in the last iteration */
+    int    position_iterations;     /* split-impulse iterations run */
+    real   position_residual;
+    size_t colors;                  /* parallel batches, 0 when solved in row order */
+    size_t uncolored;               /* rows swept on one thread after the colours */
+} cyclone_ContactSolverStats;
+
+typedef struct cyclone_ContactSolver {
+    /* Settings; init fills in defaults */
+    int  velocity_iterations;       /* upper bound, default 10 */
+    int  position_iterations;       /* split impulse only, default 4 */
+    real tolerance;                 /* stop once no impulse changes by more, default 1e-4 */
+    real baumgarte;                 /* fraction of penetration removed per step, default 0.2 */
+    real slop;                      /* penetration left alone, default 0.005 */
+    real restitution_threshold;     /* slower impacts do not bounce, default 0.5 */
+    cyclone_PositionCorrection position_correction;
+    bool warm_starting;
+    int  threads;                   /* workers for the sweeps, default 1 */
+    bool deterministic;             /* colour rows on one thread too, default false */
+
+    cyclone_ContactSolverStats stats;
+
+    cyclone_ContactConstraint *constraints;
+    size_t count;
+    size_t capacity;
+
+    /* Last step's constraints, sorted by body pair */
+    cyclone_ContactConstraint *cache;
+    size_t cache_count;
+    size_t cache_capacity;
+
+    cyclone_SolverBody *bodies;
+    size_t body_count;
+    size_t body_capacity;
+
+    size_t *body_slot;              /* world index -> bodies[], 0 when unused */
+    size_t body_slot_capacity;
+
+    /*
+     * While solving, colour c is constraints[color_start[c] .. color_start[c + 1]);
+     * group color_count after the colours is swept on one thread
+     */
+    size_t color_start[CYCLONE_CONTACT_MAX_COLORS + 3];
+    size_t color_count;
+
+    uint64_t *color_mask;           /* per solver body: colours already touching it */
+    size_t color_mask_capacity;
+
+    cyclone_JobPool *pool;          /* created on first use for threads > 1 */
+    int pool_threads;
+} cyclone_ContactSolver;
+
+/*
+ * Initialise with default settings. Always succeeds.
+ */
+void cyclone_contact_solver_init(cyclone_ContactSolver *solver);
+
+/*
+ * Free all storage, including the warm-start cache, and stop the workers.
+ */
+void cyclone_contact_solver_free(cyclone_ContactSolver *solver);
+
+/*
+ * Add every contact point of a colliding manifold between bodies a and b
+ * (either may be CYCLONE_CONTACT_STATIC). All points share the manifold
+ * depth. Returns false on allocation failure.
+ */
+bool cyclone_contact_solver_add_manifold(cyclone_ContactSolver *solver,
+                                         const cyclone_BodyWorld *world,
+                                         size_t a, size_t b,
+                                         const CollisionManifold *manifold,
+                                         real friction, real restitution);
+
+bool cyclone_contact_solver_add_fixed_manifold(cyclone_ContactSolver *solver,
+                                               const cyclone_BodyWorld *world,
+                                               size_t a, size_t b,
+                                               const FixedManifold *manifold,
+                                               real friction, real restitution);
+
+/*
+ * Resolve the added contacts: prepare, warm start, up to
+ * velocity_iterations sweeps (fewer once the residual drops below
+ * tolerance), and for split impulse the position sweeps, which move the
+ * bodies directly. Writes the velocities back to the world, wakes sleeping
+ * bodies touched by awake ones, fills stats, and moves the constraints to
+ * the warm-start cache so the solver is empty for the next step.
+ * If the worker threads cannot be started the sweeps run on the calling
+ * thread, in the same order. Returns false on allocation failure (nothing
+ * is applied).
+ */
+bool cyclone_contact_solver_solve(cyclone_ContactSolver *solver,
+                                  cyclone_BodyWorld *world,
+                                  real duration);
+
+/*
+ * Append the warm-start cache, the only solver state carried between
+ * steps, so a rolled-back world re-simulates exactly. Call between steps.
+ * Returns false on allocation failure.
+ */
+bool cyclone_contact_solver_save(const cyclone_ContactSolver *solver, cyclone_Snapshot *snapshot);
+
+/*
+ * Read back a cache written by cyclone_contact_solver_save at *cursor.
+ * Returns false, leaving the solver unchanged, if the snapshot is short
+ * or storage cannot grow.
+ */
+bool cyclone_contact_solver_load(cyclone_ContactSolver *solver, const cyclone_Snapshot *snapshot, size_t *cursor);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CYCLONE_CONTACTS_H */
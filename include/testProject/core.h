@@ -3,11 +3,16 @@
 
 #include <math.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "precision.h"
+#include "core_simd.h"
 
 /*
  * C23-compatible Cyclone core interface.
  * Types + inline helpers live here; heavy lifting lives in core.c.
+ *
+ * In single precision cross, dot, add_scaled and the quaternion product
+ * use 4-lane SIMD when core_simd.h finds a backend; see that header.
  */
 
 #ifdef __cplusplus
@@ -45,6 +50,19 @@ typedef struct cyclone_Vector3 {
 /* Alias to make porting easier if you want the old name */
 typedef cyclone_Vector3 Vector3;
 
+#if CYCLONE_SIMD
+/*
+ * Lanes (x, y, z, 0). Built from the fields instead of one 16-byte load:
+ * the fields are often in registers or were just written one by one, and
+ * a wide load of narrow stores stalls store forwarding.
+ */
+static inline cyclone_simd4
+cyclone_simd4_vector3(const cyclone_Vector3 *v)
+{
+    return cyclone_simd4_set(v->x, v->y, v->z, 0.0f);
+}
+#endif
+
 /* Common constants (defined in core.c) */
 extern const cyclone_Vector3 CYCLONE_VECTOR3_GRAVITY;
 extern const cyclone_Vector3 CYCLONE_VECTOR3_HIGH_GRAVITY;
@@ -154,11 +172,18 @@ cyclone_vector3_component_product_update(cyclone_Vector3 *a, const cyclone_Vecto
 static inline cyclone_Vector3
 cyclone_vector3_cross(cyclone_Vector3 a, cyclone_Vector3 b)
 {
+#if CYCLONE_SIMD
+    cyclone_Vector3 r;
+    cyclone_simd4_store(&r.x, cyclone_simd4_cross(cyclone_simd4_vector3(&a), cyclone_simd4_vector3(&b)));
+    r.pad = (real)0;
+    return r;
+#else
     return cyclone_vector3_make(
         a.y * b.z - a.z * b.y,
         a.z * b.x - a.x * b.z,
         a.x * b.y - a.y * b.x
     );
+#endif
 }
 
 static inline void
@@ -172,7 +197,11 @@ cyclone_vector3_cross_inplace(cyclone_Vector3 *a, const cyclone_Vector3 *b)
 static inline real
 cyclone_vector3_dot(cyclone_Vector3 a, cyclone_Vector3 b)
 {
+#if CYCLONE_SIMD
+    return cyclone_simd4_sum3(cyclone_simd4_mul(cyclone_simd4_vector3(&a), cyclone_simd4_vector3(&b)));
+#else
     return a.x * b.x + a.y * b.y + a.z * b.z;
+#endif
 }
 
 /* Add scaled vector */
@@ -182,9 +211,14 @@ cyclone_vector3_add_scaled(cyclone_Vector3 *v,
                            const cyclone_Vector3 *other,
                            real scale)
 {
+#if CYCLONE_SIMD
+    cyclone_simd4_store(&v->x, cyclone_simd4_madd(cyclone_simd4_vector3(other), cyclone_simd4_splat(scale),
+                                                  cyclone_simd4_vector3(v)));
+#else
     v->x += other->x * scale;
     v->y += other->y * scale;
     v->z += other->z * scale;
+#endif
 }
 
 /* Magnitude helpers */
@@ -308,6 +342,14 @@ typedef struct cyclone_Quaternion {
 
 typedef cyclone_Quaternion Quaternion;
 
+#if CYCLONE_SIMD
+static inline cyclone_simd4
+cyclone_simd4_quaternion(const cyclone_Quaternion *q)
+{
+    return cyclone_simd4_set(q->r, q->i, q->j, q->k);
+}
+#endif
+
 static inline cyclone_Quaternion
 cyclone_quaternion_make(real r, real i, real j, real k)
 {
@@ -345,6 +387,23 @@ static inline void
 cyclone_quaternion_multiply_inplace(cyclone_Quaternion *q,
                                     const cyclone_Quaternion *multiplier)
 {
+#if CYCLONE_SIMD
+    /*
+     * q * m = q.r (m.r, m.i, m.j, m.k) + q.i (-m.i, m.r, -m.k, m.j)
+     *       + q.j (-m.j, m.k, m.r, -m.i) + q.k (-m.k, -m.j, m.i, m.r)
+     */
+    cyclone_simd4 a = cyclone_simd4_quaternion(q);
+    cyclone_simd4 m = cyclone_simd4_quaternion(multiplier);
+
+    cyclone_simd4 r = cyclone_simd4_mul(CYCLONE_SIMD4_LANE(a, 0), m);
+    r = cyclone_simd4_madd(CYCLONE_SIMD4_LANE(a, 1),
+                           cyclone_simd4_mul(cyclone_simd4_swap_pairs(m), cyclone_simd4_set(-1, 1, -1, 1)), r);
+    r = cyclone_simd4_madd(CYCLONE_SIMD4_LANE(a, 2),
+                           cyclone_simd4_mul(cyclone_simd4_swap_halves(m), cyclone_simd4_set(-1, 1, 1, -1)), r);
+    r = cyclone_simd4_madd(CYCLONE_SIMD4_LANE(a, 3),
+                           cyclone_simd4_mul(cyclone_simd4_reverse(m), cyclone_simd4_set(-1, -1, 1, 1)), r);
+    cyclone_simd4_store(&q->r, r);
+#else
     cyclone_Quaternion a = *q;
 
     q->r = a.r * multiplier->r - a.i * multiplier->i -
@@ -358,6 +417,7 @@ cyclone_quaternion_multiply_inplace(cyclone_Quaternion *q,
 
     q->k = a.r * multiplier->k + a.k * multiplier->r +
            a.i * multiplier->j - a.j * multiplier->i;
+#endif
 }
 
 static inline void
@@ -863,6 +923,41 @@ cyclone_matrix3_linear_interpolate(const cyclone_Matrix3 *a,
     return r;
 }
 
+/* ============================================================
+ * Batched orientation kernels
+ * ============================================================
+ *
+ * The same operations over count bodies stored SoA: q[0..3] are the r,
+ * i, j, k arrays, v[0..2] the x, y, z arrays and m[0..8] the Matrix3
+ * entries in data[] order. Arrays must not overlap. With SIMD (see
+ * core_simd.h) four bodies go per instruction; otherwise the plain loops
+ * are left to the compiler's vectoriser. Implemented in core.c.
+ */
+
+/* cyclone_quaternion_add_scaled_vector for each body */
+void cyclone_quaternion_add_scaled_vector_batch(real *const q[4],
+                                                const real *const v[3],
+                                                real scale,
+                                                size_t count);
+
+/*
+ * cyclone_quaternion_normalise for each body, degenerate ones becoming
+ * the identity. With SIMD the reciprocal square root is the hardware
+ * estimate refined by Newton's method, good to about 2 ulp.
+ */
+void cyclone_quaternion_normalise_batch(real *const q[4], size_t count);
+
+/* Both of the above in one pass: advance orientations by angular velocity w */
+void cyclone_quaternion_integrate_batch(real *const q[4],
+                                        const real *const w[3],
+                                        real duration,
+                                        size_t count);
+
+/* cyclone_matrix3_set_orientation for each body */
+void cyclone_matrix3_set_orientation_batch(real *const m[9],
+                                           const real *const q[4],
+                                           size_t count);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,222 @@
+#ifndef CYCLONE_CORE_SIMD_H
+#define CYCLONE_CORE_SIMD_H
+
+#include "precision.h"
+
+/*
+ * Four-lane float helpers for the core.h inline operations.
+ *
+ * Only used in single precision, where cyclone_Vector3 (x, y, z, pad)
+ * and cyclone_Quaternion are exactly one 16-byte register. The backend is picked at compile time:
+ *
+ *   CYCLONE_SIMD_SSE    x86 / x86-64 (SSE, part of every x86-64 target)
+ *   CYCLONE_SIMD_NEON   AArch64
+ *   CYCLONE_SIMD_WASM   Emscripten with -msimd128
+ *
+ * CYCLONE_SIMD is 1 when one of them is active and 0 otherwise, in which
+ * case core.h keeps its scalar code. Define CYCLONE_NO_SIMD to force the
+ * scalar code.
+ *
+ * Only operations that measured faster than the compiler's own code for
+ * the scalar form are routed here: one 3x3 or 3x4 matrix spread over
+ * 4-lane registers costs more in shuffles than it saves.
+ */
+
+#if CYCLONE_USE_SINGLE_PRECISION && !defined(CYCLONE_NO_SIMD)
+    #if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+        #define CYCLONE_SIMD_SSE 1
+        #include <xmmintrin.h>
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #define CYCLONE_SIMD_NEON 1
+        #include <arm_neon.h>
+    #elif defined(__wasm_simd128__)
+        #define CYCLONE_SIMD_WASM 1
+        #include <wasm_simd128.h>
+    #endif
+#endif
+
+#if defined(CYCLONE_SIMD_SSE) || defined(CYCLONE_SIMD_NEON) || defined(CYCLONE_SIMD_WASM)
+#define CYCLONE_SIMD 1
+#else
+#define CYCLONE_SIMD 0
+#endif
+
+#if CYCLONE_SIMD
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ * SSE
+ * ============================================================
+ */
+
+#if defined(CYCLONE_SIMD_SSE)
+
+typedef __m128 cyclone_simd4;
+
+static inline cyclone_simd4 cyclone_simd4_load(const float *p)               { return _mm_loadu_ps(p); }
+static inline void          cyclone_simd4_store(float *p, cyclone_simd4 a)   { _mm_storeu_ps(p, a); }
+static inline cyclone_simd4 cyclone_simd4_set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+static inline cyclone_simd4 cyclone_simd4_splat(float s)                     { return _mm_set1_ps(s); }
+static inline cyclone_simd4 cyclone_simd4_add(cyclone_simd4 a, cyclone_simd4 b) { return _mm_add_ps(a, b); }
+static inline cyclone_simd4 cyclone_simd4_sub(cyclone_simd4 a, cyclone_simd4 b) { return _mm_sub_ps(a, b); }
+static inline cyclone_simd4 cyclone_simd4_mul(cyclone_simd4 a, cyclone_simd4 b) { return _mm_mul_ps(a, b); }
+
+/* Lane i in every lane */
+#define CYCLONE_SIMD4_LANE(a, i) _mm_shuffle_ps((a), (a), _MM_SHUFFLE((i), (i), (i), (i)))
+
+/* (y, z, x, w) */
+static inline cyclone_simd4 cyclone_simd4_yzx(cyclone_simd4 a)
+{
+    return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+/* (a1, a0, a3, a2), (a2, a3, a0, a1), (a3, a2, a1, a0) */
+static inline cyclone_simd4 cyclone_simd4_swap_pairs(cyclone_simd4 a)  { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline cyclone_simd4 cyclone_simd4_swap_halves(cyclone_simd4 a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 3, 2)); }
+static inline cyclone_simd4 cyclone_simd4_reverse(cyclone_simd4 a)     { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+/* a0 + a1 + a2 */
+static inline float cyclone_simd4_sum3(cyclone_simd4 a)
+{
+    __m128 s = _mm_add_ss(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_movehl_ps(a, a)));
+}
+
+/* 1 / sqrt(a): 12-bit estimate plus one Newton step, about 22 bits */
+static inline cyclone_simd4 cyclone_simd4_rsqrt(cyclone_simd4 a)
+{
+    __m128 y = _mm_rsqrt_ps(a);
+    __m128 half_a = _mm_mul_ps(_mm_set1_ps(0.5f), a);
+    return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half_a, _mm_mul_ps(y, y))));
+}
+
+/* 1 where a >= edge, else 0 */
+static inline cyclone_simd4 cyclone_simd4_step(cyclone_simd4 edge, cyclone_simd4 a)
+{
+    return _mm_and_ps(_mm_cmpge_ps(a, edge), _mm_set1_ps(1.0f));
+}
+
+/* ============================================================
+ * NEON
+ * ============================================================
+ */
+
+#elif defined(CYCLONE_SIMD_NEON)
+
+typedef float32x4_t cyclone_simd4;
+
+static inline cyclone_simd4 cyclone_simd4_load(const float *p)               { return vld1q_f32(p); }
+static inline void          cyclone_simd4_store(float *p, cyclone_simd4 a)   { vst1q_f32(p, a); }
+static inline cyclone_simd4 cyclone_simd4_splat(float s)                     { return vdupq_n_f32(s); }
+static inline cyclone_simd4 cyclone_simd4_add(cyclone_simd4 a, cyclone_simd4 b) { return vaddq_f32(a, b); }
+static inline cyclone_simd4 cyclone_simd4_sub(cyclone_simd4 a, cyclone_simd4 b) { return vsubq_f32(a, b); }
+static inline cyclone_simd4 cyclone_simd4_mul(cyclone_simd4 a, cyclone_simd4 b) { return vmulq_f32(a, b); }
+
+static inline cyclone_simd4 cyclone_simd4_set(float x, float y, float z, float w)
+{
+    const float lanes[4] = { x, y, z, w };
+    return vld1q_f32(lanes);
+}
+
+#define CYCLONE_SIMD4_LANE(a, i) vdupq_laneq_f32((a), (i))
+
+static inline cyclone_simd4 cyclone_simd4_yzx(cyclone_simd4 a)
+{
+    /* (y, z, w, x) with lane 2 replaced by x */
+    return vsetq_lane_f32(vgetq_lane_f32(a, 0), vextq_f32(a, a, 1), 2);
+}
+
+static inline cyclone_simd4 cyclone_simd4_swap_pairs(cyclone_simd4 a)  { return vrev64q_f32(a); }
+static inline cyclone_simd4 cyclone_simd4_swap_halves(cyclone_simd4 a) { return vextq_f32(a, a, 2); }
+static inline cyclone_simd4 cyclone_simd4_reverse(cyclone_simd4 a)     { return vrev64q_f32(vextq_f32(a, a, 2)); }
+
+static inline float cyclone_simd4_sum3(cyclone_simd4 a)
+{
+    return vaddvq_f32(vsetq_lane_f32(0.0f, a, 3));
+}
+
+/* 8-bit estimate plus two Newton steps */
+static inline cyclone_simd4 cyclone_simd4_rsqrt(cyclone_simd4 a)
+{
+    float32x4_t y = vrsqrteq_f32(a);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a, y), y));
+    return vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a, y), y));
+}
+
+static inline cyclone_simd4 cyclone_simd4_step(cyclone_simd4 edge, cyclone_simd4 a)
+{
+    return vreinterpretq_f32_u32(vandq_u32(vcgeq_f32(a, edge), vreinterpretq_u32_f32(vdupq_n_f32(1.0f))));
+}
+
+/* ============================================================
+ * WASM SIMD128
+ * ============================================================
+ */
+
+#elif defined(CYCLONE_SIMD_WASM)
+
+typedef v128_t cyclone_simd4;
+
+static inline cyclone_simd4 cyclone_simd4_load(const float *p)               { return wasm_v128_load(p); }
+static inline void          cyclone_simd4_store(float *p, cyclone_simd4 a)   { wasm_v128_store(p, a); }
+static inline cyclone_simd4 cyclone_simd4_set(float x, float y, float z, float w) { return wasm_f32x4_make(x, y, z, w); }
+static inline cyclone_simd4 cyclone_simd4_splat(float s)                     { return wasm_f32x4_splat(s); }
+static inline cyclone_simd4 cyclone_simd4_add(cyclone_simd4 a, cyclone_simd4 b) { return wasm_f32x4_add(a, b); }
+static inline cyclone_simd4 cyclone_simd4_sub(cyclone_simd4 a, cyclone_simd4 b) { return wasm_f32x4_sub(a, b); }
+static inline cyclone_simd4 cyclone_simd4_mul(cyclone_simd4 a, cyclone_simd4 b) { return wasm_f32x4_mul(a, b); }
+
+#define CYCLONE_SIMD4_LANE(a, i) wasm_i32x4_shuffle((a), (a), (i), (i), (i), (i))
+
+static inline cyclone_simd4 cyclone_simd4_yzx(cyclone_simd4 a)         { return wasm_i32x4_shuffle(a, a, 1, 2, 0, 3); }
+static inline cyclone_simd4 cyclone_simd4_swap_pairs(cyclone_simd4 a)  { return wasm_i32x4_shuffle(a, a, 1, 0, 3, 2); }
+static inline cyclone_simd4 cyclone_simd4_swap_halves(cyclone_simd4 a) { return wasm_i32x4_shuffle(a, a, 2, 3, 0, 1); }
+static inline cyclone_simd4 cyclone_simd4_reverse(cyclone_simd4 a)     { return wasm_i32x4_shuffle(a, a, 3, 2, 1, 0); }
+
+static inline float cyclone_simd4_sum3(cyclone_simd4 a)
+{
+    return wasm_f32x4_extract_lane(a, 0) + wasm_f32x4_extract_lane(a, 1) + wasm_f32x4_extract_lane(a, 2);
+}
+
+/* SIMD128 has no estimate instruction */
+static inline cyclone_simd4 cyclone_simd4_rsqrt(cyclone_simd4 a)
+{
+    return wasm_f32x4_div(wasm_f32x4_splat(1.0f), wasm_f32x4_sqrt(a));
+}
+
+static inline cyclone_simd4 cyclone_simd4_step(cyclone_simd4 edge, cyclone_simd4 a)
+{
+    return wasm_v128_and(wasm_f32x4_ge(a, edge), wasm_f32x4_splat(1.0f));
+}
+
+#endif
+
+/* ============================================================
+ * Shared
+ * ============================================================
+ */
+
+/* a * b + c */
+static inline cyclone_simd4 cyclone_simd4_madd(cyclone_simd4 a, cyclone_simd4 b, cyclone_simd4 c)
+{
+    return cyclone_simd4_add(cyclone_simd4_mul(a, b), c);
+}
+
+/* Cross product of the xyz lanes; the w lane is left as garbage */
+static inline cyclone_simd4 cyclone_simd4_cross(cyclone_simd4 a, cyclone_simd4 b)
+{
+    /* (a * b.yzx - a.yzx * b).yzx */
+    cyclone_simd4 c = cyclone_simd4_sub(cyclone_simd4_mul(a, cyclone_simd4_yzx(b)),
+                                        cyclone_simd4_mul(cyclone_simd4_yzx(a), b));
+    return cyclone_simd4_yzx(c);
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CYCLONE_SIMD */
+
+#endif /* CYCLONE_CORE_SIMD_H */
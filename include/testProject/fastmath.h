@@ -0,0 +1,151 @@
+#ifndef MATH_FASTMATH_H_
+#define MATH_FASTMATH_H_
+
+#include <stddef.h>
+#include <math.h>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#endif
+
+/*
+ * Polynomial replacements for the libm calls on the math library's hot
+ * paths (rotation builders, normalisation). Errors measured against the
+ * double-precision libm result (bench/bench_fastmath prints them):
+ *
+ *   math_fast_sin, _cos, _sincos   absolute error <= 3e-7 for |x| <= 1e4
+ *                                  (1.2e-6 at 1e5)
+ *   math_fast_atan2                absolute error <= 4.5e-7 radians
+ *   math_fast_rsqrt                relative error <= 2.8e-7
+ *
+ * sin and cos reduce x by the nearest multiple of 2 pi and evaluate a
+ * degree-9 odd minimax polynomial on [-pi/2, pi/2]. There are no
+ * branches, so math_fast_sincos_array runs four angles per SIMD register.
+ * atan2 uses a degree-15 odd polynomial for atan on [0, 1] and treats
+ * x = -0 as +0. rsqrt is the SSE estimate refined by one Newton step;
+ * without SSE it is 1 / sqrtf, which is a single instruction on AArch64
+ * and WASM anyway. None of them handle infinities or NaNs the way libm
+ * does.
+ *
+ * The library calls math_sin, math_cos, math_sincos, math_atan2 and
+ * math_rsqrt, which are the libm functions unless MATH_FAST_MATH is
+ * defined (CMake option USE_FAST_MATH). That mainly pays off on WASM,
+ * where libm trig is compiled C, and in loops the compiler can vectorise;
+ * glibc's own sinf/cosf are about as fast for one small angle at a time.
+ */
+
+#define MATH_FAST_PI          3.14159265f
+#define MATH_FAST_HALF_PI     1.57079633f
+#define MATH_FAST_INV_TWO_PI  0.159154943f
+
+/* 2 pi in three parts; k * hi is exact for |k| < 2^16 */
+#define MATH_FAST_TWO_PI_HI   6.28125f
+#define MATH_FAST_TWO_PI_MID  1.93530717e-3f
+#define MATH_FAST_TWO_PI_LO   1.02531317e-11f
+
+/* round(x) for |x| < 2^22 with float arithmetic */
+#define MATH_FAST_ROUND_MAGIC 12582912.0f
+
+/* x - k * 2 pi for the nearest integer k, in [-pi, pi] */
+static inline float math_fast_reduce(float x) {
+    float k = (x * MATH_FAST_INV_TWO_PI + MATH_FAST_ROUND_MAGIC) - MATH_FAST_ROUND_MAGIC;
+    float r = x - k * MATH_FAST_TWO_PI_HI;
+    r -= k * MATH_FAST_TWO_PI_MID;
+    return r - k * MATH_FAST_TWO_PI_LO;
+}
+
+/* sin(x) for x in [-pi/2, pi/2]; relative error 5.3e-9 before rounding */
+static inline float math_fast_sin_poly(float x) {
+    float s = x * x;
+    float p = 2.60190307e-6f;
+    p = p * s - 1.98074187e-4f;
+    p = p * s + 8.33302514e-3f;
+    p = p * s - 1.66666567e-1f;
+    return x + x * s * p;
+}
+
+static inline float math_fast_sin(float x) {
+    float r = math_fast_reduce(x);
+    /* Fold [-pi, -pi/2) and (pi/2, pi] back onto [-pi/2, pi/2] */
+    float a = MATH_FAST_PI - r;
+    float b = -MATH_FAST_PI - r;
+    r = r < a ? r : a;
+    r = r > b ? r : b;
+    return math_fast_sin_poly(r);
+}
+
+static inline float math_fast_cos(float x) {
+    /* cos(r) = sin(pi/2 - |r|) */
+    return math_fast_sin_poly(MATH_FAST_HALF_PI - fabsf(math_fast_reduce(x)));
+}
+
+static inline void math_fast_sincos(float x, float *s, float *c) {
+    float r = math_fast_reduce(x);
+    float a = MATH_FAST_PI - r;
+    float b = -MATH_FAST_PI - r;
+    float f = r < a ? r : a;
+    f = f > b ? f : b;
+    *s = math_fast_sin_poly(f);
+    *c = math_fast_sin_poly(MATH_FAST_HALF_PI - fabsf(r));
+}
+
+static inline float math_fast_atan2(float y, float x) {
+    float ax = fabsf(x);
+    float ay = fabsf(y);
+    float hi = ax > ay ? ax : ay;
+    float lo = ax > ay ? ay : ax;
+    float t  = hi > 0.0f ? lo / hi : 0.0f;
+
+    /* atan(t) for t in [0, 1]; relative error 9.9e-8 before rounding */
+    float s = t * t;
+    float p = -4.69327507e-3f;
+    p = p * s + 2.42523992e-2f;
+    p = p * s - 5.94863869e-2f;
+    p = p * s + 9.91429233e-2f;
+    p = p * s - 1.40194807e-1f;
+    p = p * s + 1.99697239e-1f;
+    p = p * s - 3.33319907e-1f;
+    float r = t + t * s * p;
+
+    r = ay > ax ? MATH_FAST_HALF_PI - r : r;
+    r = x < 0.0f ? MATH_FAST_PI - r : r;
+    return copysignf(r, y);
+}
+
+static inline float math_fast_rsqrt(float x) {
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+    float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (1.5f - 0.5f * x * y * y);
+#else
+    return 1.0f / sqrtf(x);
+#endif
+}
+
+/*
+ * sines[i] = sin(angles[i]) and cosines[i] = cos(angles[i]) with the
+ * math_fast_sincos error, whatever MATH_FAST_MATH says. The arrays must
+ * not overlap.
+ */
+void math_fast_sincos_array(const float *angles, float *sines, float *cosines, size_t n);
+
+/* ---------- what the library calls ---------- */
+
+#ifdef MATH_FAST_MATH
+
+static inline float math_sin(float x)                      { return math_fast_sin(x); }
+static inline float math_cos(float x)                      { return math_fast_cos(x); }
+static inline void  math_sincos(float x, float *s, float *c) { math_fast_sincos(x, s, c); }
+static inline float math_atan2(float y, float x)           { return math_fast_atan2(y, x); }
+static inline float math_rsqrt(float x)                    { return math_fast_rsqrt(x); }
+
+#else
+
+static inline float math_sin(float x)                      { return sinf(x); }
+static inline float math_cos(float x)                      { return cosf(x); }
+static inline void  math_sincos(float x, float *s, float *c) { *s = sinf(x); *c = cosf(x); }
+static inline float math_atan2(float y, float x)           { return atan2f(y, x); }
+static inline float math_rsqrt(float x)                    { return 1.0f / sqrtf(x); }
+
+#endif
+
+#endif /* MATH_FASTMATH_H_ */
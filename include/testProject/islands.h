@@ -0,0 +1,91 @@
+#ifndef CYCLONE_ISLANDS_H
+#define CYCLONE_ISLANDS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "core.h"
+#include "body.h"
+#include "contacts.h"
+
+/*
+ * Simulation islands: groups of bodies connected through contact rows.
+ *
+ * Bodies are joined with a union-find over the solver's constraints (the
+ * static world and immovable bodies join nothing), then bodies and rows
+ * are bucketed per island. An island is the unit of sleeping: it is woken
+ * as a whole when any of its bodies is awake, and put to sleep as a whole
+ * once every body in it has stayed still, so a settled stack no longer
+ * keeps waking itself one box at a time.
+ *
+ * Each step, with world->island_sleep set:
+ *
+ *   1. cyclone_body_world_integrate()
+ *   2. collision detection, cyclone_contact_solver_add_manifold() ...
+ *      (pairs of sleeping bodies can be skipped: both then belong to
+ *      sleeping islands and the solver ignores them anyway)
+ *   3. cyclone_islands_build()
+ *   4. cyclone_contact_solver_solve()
+ *   5. cyclone_islands_update_sleep()
+ *
+ * The per-island body and row lists also give independent work units for
+ * solving islands separately.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct cyclone_Islands {
+    /* Union-find over world bodies, rebuilt every step */
+    size_t *parent;
+    size_t *size;
+
+    size_t *island_of;              /* body -> island */
+
+    /* Island i holds bodies[body_start[i] .. body_start[i + 1]) */
+    size_t *body_start;
+    size_t *bodies;
+
+    /* and solver rows rows[row_start[i] .. row_start[i + 1]), indices into
+       solver->constraints that stay valid until the solve */
+    size_t *row_start;
+    size_t *rows;
+
+    bool *awake;                    /* per island, after build */
+
+    size_t island_count;
+    size_t body_capacity;
+    size_t row_capacity;
+} cyclone_Islands;
+
+/*
+ * Initialise empty. Always succeeds.
+ */
+void cyclone_islands_init(cyclone_Islands *islands);
+
+/*
+ * Free all storage and reset to empty.
+ */
+void cyclone_islands_free(cyclone_Islands *islands);
+
+/*
+ * Group the world's bodies by the rows currently added to the solver and
+ * wake every island holding an awake body. Bodies touching nothing form
+ * islands of their own. Returns false on allocation failure (the islands
+ * are left empty and no body is woken).
+ */
+bool cyclone_islands_build(cyclone_Islands *islands,
+                           cyclone_BodyWorld *world,
+                           const cyclone_ContactSolver *solver);
+
+/*
+ * Put to sleep every awake island whose bodies can all sleep and all have
+ * a motion average below cyclone_sleep_epsilon. Call after solving.
+ */
+void cyclone_islands_update_sleep(cyclone_Islands *islands, cyclone_BodyWorld *world);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CYCLONE_ISLANDS_H */
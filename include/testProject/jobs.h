@@ -0,0 +1,66 @@
+#ifndef CYCLONE_JOBS_H
+#define CYCLONE_JOBS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * Minimal fork-join worker pool for the physics stages.
+ *
+ * cyclone_job_pool_run() splits [0, count) into one contiguous range per
+ * worker, runs them in parallel (the calling thread takes the first range)
+ * and returns once all are done. Ranges depend only on count, grain and
+ * the pool size, never on timing.
+ *
+ * Threads come from pthreads when built with CYCLONE_USE_THREADS (native,
+ * or Emscripten with -pthread). Without it a pool always has one worker
+ * and runs jobs inline, so callers need no #ifdefs.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Upper bound on workers in one pool */
+#define CYCLONE_JOB_MAX_THREADS 64
+
+typedef struct cyclone_JobPool cyclone_JobPool;
+
+/* Process range [begin, end) as the given worker (0 = calling thread) */
+typedef void (*cyclone_JobFunction)(void *context, size_t begin, size_t end, int worker);
+
+/*
+ * Logical cores available, at least 1.
+ */
+int cyclone_job_hardware_threads(void);
+
+/*
+ * Start a pool of threads workers, the calling thread included, clamped
+ * to [1, CYCLONE_JOB_MAX_THREADS]. Returns NULL on failure.
+ */
+cyclone_JobPool *cyclone_job_pool_create(int threads);
+
+/*
+ * Stop and join the workers. NULL is ignored.
+ */
+void cyclone_job_pool_destroy(cyclone_JobPool *pool);
+
+/*
+ * Workers in the pool (1 when threads are not compiled in).
+ */
+int cyclone_job_pool_threads(const cyclone_JobPool *pool);
+
+/*
+ * Run function over [0, count), giving each worker at least grain items;
+ * small jobs therefore run inline on the calling thread. Returns the
+ * number of workers used, so callers can combine per-worker results.
+ * A NULL pool runs inline.
+ */
+int cyclone_job_pool_run(cyclone_JobPool *pool, size_t count, size_t grain,
+                         cyclone_JobFunction function, void *context);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CYCLONE_JOBS_H */
@@ -16,6 +16,20 @@
 #endif
 
 #include "vectors.h"
+#include "matrices_simd.h"
+
+/*
+ * The multiplies, mat4 transpose and vector transforms are defined in this
+ * header so callers inline them, with the matrices_simd.h kernels where
+ * available; matrices.c defines MATH_MATRICES_IMPLEMENTATION to emit them
+ * as out-of-line symbols (see vectors.h).
+ */
+#ifdef MATH_MATRICES_IMPLEMENTATION
+#undef MATH_MATRICES_INLINE
+#define MATH_MATRICES_INLINE
+#elif !defined(MATH_MATRICES_INLINE)
+#define MATH_MATRICES_INLINE static inline
+#endif
 
 /* ============================================================================
  *  Matrix types
@@ -115,7 +129,20 @@ void Transpose(const float *srcMat, float *dstMat, int srcRows, int srcCols);
 /* Dimension-specific versions */
 mat2 mat2_transpose(mat2 matrix);
 mat3 mat3_transpose(mat3 matrix);
-mat4 mat4_transpose(mat4 matrix);
+
+MATH_MATRICES_INLINE mat4 mat4_transpose(mat4 matrix) {
+    mat4 result;
+#if MATH_SIMD
+    math_simd4_mat4_transpose(result.asArray, matrix.asArray);
+#else
+    for (int r = 0; r < 4; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            result.m[c][r] = matrix.m[r][c];
+        }
+    }
+#endif
+    return result;
+}
 
 /* ============================================================================
  *  Scalar multiply
@@ -137,8 +164,44 @@ bool Multiply(float *out,
 
 /* Dimension-specific versions */
 mat2 mat2_mul(mat2 matrixA, mat2 matrixB);
-mat3 mat3_mul(mat3 matrixA, mat3 matrixB);
-mat4 mat4_mul(mat4 matrixA, mat4 matrixB);
+
+/* Unrolled so callers inline them; matches Multiply() term for term */
+MATH_MATRICES_INLINE mat3 mat3_mul(mat3 matrixA, mat3 matrixB) {
+    mat3 result;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            result.m[i][j] = matrixA.m[i][0] * matrixB.m[0][j] +
+                             matrixA.m[i][1] * matrixB.m[1][j] +
+                             matrixA.m[i][2] * matrixB.m[2][j];
+        }
+    }
+    return result;
+}
+
+MATH_MATRICES_INLINE mat4 mat4_mul(mat4 matrixA, mat4 matrixB) {
+    mat4 result;
+#if MATH_SIMD
+    math_simd4_mat4_mul(result.asArray, matrixA.asArray, matrixB.asArray);
+#else
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result.m[i][j] = matrixA.m[i][0] * matrixB.m[0][j] +
+                             matrixA.m[i][1] * matrixB.m[1][j] +
+                             matrixA.m[i][2] * matrixB.m[2][j] +
+                             matrixA.m[i][3] * matrixB.m[3][j];
+        }
+    }
+#endif
+    return result;
+}
+
+/*
+ * out = a * b without copying the operands; out may alias a or b. On x86
+ * this picks an AVX kernel at run time when the CPU has one, which is
+ * faster than the inlined mat4_mul for matrices already in memory. Gives
+ * the same result as mat4_mul.
+ */
+void mat4_mul_into(mat4 *out, const mat4 *a, const mat4 *b);
 
 /* ============================================================================
  *  Minors, cofactors, determinant, adjugate, inverse
@@ -248,11 +311,57 @@ mat3 AxisAngle3x3(vec3 axis, float angle);
  * ==========================================================================*/
 
 /* vec treated as point (w = 1) */
-vec3 MultiplyPoint(vec3 vec, mat4 mat);
+MATH_MATRICES_INLINE vec3 MultiplyPoint(vec3 vec, mat4 mat) {
+#if MATH_SIMD
+    float lanes[4];
+    math_simd4_store(lanes, math_simd4_mat4_transform(vec.x, vec.y, vec.z, mat.asArray, 1));
+    return vec3_make(lanes[0], lanes[1], lanes[2]);
+#else
+    vec3 result;
+    result.x = vec.x * mat._11 + vec.y * mat._21 + vec.z * mat._31 + mat._41;
+    result.y = vec.x * mat._12 + vec.y * mat._22 + vec.z * mat._32 + mat._42;
+    result.z = vec.x * mat._13 + vec.y * mat._23 + vec.z * mat._33 + mat._43;
+    return result;
+#endif
+}
 
 /* vec treated as direction (w = 0) – two explicit versions */
-vec3 mat4_multiply_vector(vec3 vec, mat4 mat);
-vec3 mat3_multiply_vector(vec3 vec, mat3 mat);
+MATH_MATRICES_INLINE vec3 mat4_multiply_vector(vec3 vec, mat4 mat) {
+#if MATH_SIMD
+    float lanes[4];
+    math_simd4_store(lanes, math_simd4_mat4_transform(vec.x, vec.y, vec.z, mat.asArray, 0));
+    return vec3_make(lanes[0], lanes[1], lanes[2]);
+#else
+    vec3 result;
+    result.x = vec.x * mat._11 + vec.y * mat._21 + vec.z * mat._31;
+    result.y = vec.x * mat._12 + vec.y * mat._22 + vec.z * mat._32;
+    result.z = vec.x * mat._13 + vec.y * mat._23 + vec.z * mat._33;
+    return result;
+#endif
+}
+
+MATH_MATRICES_INLINE vec3 mat3_multiply_vector(vec3 vec, mat3 mat) {
+    vec3 result;
+    result.x = vec.x * mat._11 + vec.y * mat._21 + vec.z * mat._31;
+    result.y = vec.x * mat._12 + vec.y * mat._22 + vec.z * mat._32;
+    result.z = vec.x * mat._13 + vec.y * mat._23 + vec.z * mat._33;
+    return result;
+}
+
+/*
+ * Batched forms over n vec3s, for vertex buffers and point clouds. Element i
+ * is read from in and written to out at byte offset i * stride (0 means
+ * tightly packed vec3s; otherwise a multiple of 4). out may equal in to
+ * transform a buffer in place; otherwise the two must not overlap.
+ *
+ * Points and directions give exactly what MultiplyPoint and
+ * mat4_multiply_vector give per element. The projective form also computes
+ * w = x * _14 + y * _24 + z * _34 + _44 and divides the point by it (no
+ * check for w == 0).
+ */
+void mat4_transform_points(const mat4 *mat, const vec3 *in, vec3 *out, size_t n, size_t stride);
+void mat4_transform_directions(const mat4 *mat, const vec3 *in, vec3 *out, size_t n, size_t stride);
+void mat4_transform_points_projective(const mat4 *mat, const vec3 *in, vec3 *out, size_t n, size_t stride);
 
 /* ============================================================================
  *  Composite transforms
@@ -0,0 +1,163 @@
+#ifndef _H_MATH_MATRICES_SIMD_
+#define _H_MATH_MATRICES_SIMD_
+
+/*
+  Four-lane float kernels behind the mat4 operations in matrices.h and
+  math_fast_sincos_array in fastmath.c.
+
+  The backend is picked at compile time:
+
+    MATH_SIMD_SSE    x86 / x86-64
+    MATH_SIMD_NEON   AArch64 with GCC 12+ or Clang (__builtin_shufflevector)
+    MATH_SIMD_WASM   Emscripten with -msimd128
+
+  MATH_SIMD is 1 when one of them is active and 0 otherwise. Define
+  MATH_NO_SIMD to keep the scalar code.
+
+  A mat4 row is one register. The multiply and transform kernels add their
+  products in the same order as the scalar code, so results are identical
+  with or without SIMD; only the inverse (2x2 block form) rounds
+  differently.
+*/
+
+#if !defined(MATH_NO_SIMD)
+    #if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+        #define MATH_SIMD_SSE 1
+        #include <xmmintrin.h>
+    #elif defined(__ARM_NEON) && defined(__aarch64__) && (defined(__clang__) || __GNUC__ >= 12)
+        #define MATH_SIMD_NEON 1
+        #include <arm_neon.h>
+    #elif defined(__wasm_simd128__)
+        #define MATH_SIMD_WASM 1
+        #include <wasm_simd128.h>
+    #endif
+#endif
+
+#if defined(MATH_SIMD_SSE) || defined(MATH_SIMD_NEON) || defined(MATH_SIMD_WASM)
+#define MATH_SIMD 1
+#else
+#define MATH_SIMD 0
+#endif
+
+#if MATH_SIMD
+
+/* ============================================================================
+ *  Backends
+ * ==========================================================================*/
+
+/* MATH_SIMD4_SHUFFLE(a, b, x, y, z, w) is (a[x], a[y], b[z], b[w]) */
+
+#if defined(MATH_SIMD_SSE)
+
+typedef __m128 math_simd4;
+
+static inline math_simd4 math_simd4_load(const float *p)                 { return _mm_loadu_ps(p); }
+static inline void       math_simd4_store(float *p, math_simd4 a)        { _mm_storeu_ps(p, a); }
+static inline math_simd4 math_simd4_splat(float s)                       { return _mm_set1_ps(s); }
+static inline math_simd4 math_simd4_set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+static inline math_simd4 math_simd4_add(math_simd4 a, math_simd4 b)      { return _mm_add_ps(a, b); }
+static inline math_simd4 math_simd4_sub(math_simd4 a, math_simd4 b)      { return _mm_sub_ps(a, b); }
+static inline math_simd4 math_simd4_mul(math_simd4 a, math_simd4 b)      { return _mm_mul_ps(a, b); }
+static inline math_simd4 math_simd4_div(math_simd4 a, math_simd4 b)      { return _mm_div_ps(a, b); }
+static inline math_simd4 math_simd4_min(math_simd4 a, math_simd4 b)      { return _mm_min_ps(a, b); }
+static inline math_simd4 math_simd4_max(math_simd4 a, math_simd4 b)      { return _mm_max_ps(a, b); }
+static inline float      math_simd4_first(math_simd4 a)                  { return _mm_cvtss_f32(a); }
+
+#define MATH_SIMD4_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps((a), (b), _MM_SHUFFLE((w), (z), (y), (x)))
+
+#elif defined(MATH_SIMD_NEON)
+
+typedef float32x4_t math_simd4;
+
+static inline math_simd4 math_simd4_load(const float *p)                 { return vld1q_f32(p); }
+static inline void       math_simd4_store(float *p, math_simd4 a)        { vst1q_f32(p, a); }
+static inline math_simd4 math_simd4_splat(float s)                       { return vdupq_n_f32(s); }
+static inline math_simd4 math_simd4_add(math_simd4 a, math_simd4 b)      { return vaddq_f32(a, b); }
+static inline math_simd4 math_simd4_sub(math_simd4 a, math_simd4 b)      { return vsubq_f32(a, b); }
+static inline math_simd4 math_simd4_mul(math_simd4 a, math_simd4 b)      { return vmulq_f32(a, b); }
+static inline math_simd4 math_simd4_div(math_simd4 a, math_simd4 b)      { return vdivq_f32(a, b); }
+static inline math_simd4 math_simd4_min(math_simd4 a, math_simd4 b)      { return vminq_f32(a, b); }
+static inline math_simd4 math_simd4_max(math_simd4 a, math_simd4 b)      { return vmaxq_f32(a, b); }
+static inline float      math_simd4_first(math_simd4 a)                  { return vgetq_lane_f32(a, 0); }
+
+static inline math_simd4 math_simd4_set(float x, float y, float z, float w) {
+    const float lanes[4] = { x, y, z, w };
+    return vld1q_f32(lanes);
+}
+
+#define MATH_SIMD4_SHUFFLE(a, b, x, y, z, w) __builtin_shufflevector((a), (b), (x), (y), (z) + 4, (w) + 4)
+
+#elif defined(MATH_SIMD_WASM)
+
+typedef v128_t math_simd4;
+
+static inline math_simd4 math_simd4_load(const float *p)                 { return wasm_v128_load(p); }
+static inline void       math_simd4_store(float *p, math_simd4 a)        { wasm_v128_store(p, a); }
+static inline math_simd4 math_simd4_splat(float s)                       { return wasm_f32x4_splat(s); }
+static inline math_simd4 math_simd4_set(float x, float y, float z, float w) { return wasm_f32x4_make(x, y, z, w); }
+static inline math_simd4 math_simd4_add(math_simd4 a, math_simd4 b)      { return wasm_f32x4_add(a, b); }
+static inline math_simd4 math_simd4_sub(math_simd4 a, math_simd4 b)      { return wasm_f32x4_sub(a, b); }
+static inline math_simd4 math_simd4_mul(math_simd4 a, math_simd4 b)      { return wasm_f32x4_mul(a, b); }
+static inline math_simd4 math_simd4_div(math_simd4 a, math_simd4 b)      { return wasm_f32x4_div(a, b); }
+static inline math_simd4 math_simd4_min(math_simd4 a, math_simd4 b)      { return wasm_f32x4_min(a, b); }
+static inline math_simd4 math_simd4_max(math_simd4 a, math_simd4 b)      { return wasm_f32x4_max(a, b); }
+static inline float      math_simd4_first(math_simd4 a)                  { return wasm_f32x4_extract_lane(a, 0); }
+
+#define MATH_SIMD4_SHUFFLE(a, b, x, y, z, w) wasm_i32x4_shuffle((a), (b), (x), (y), (z) + 4, (w) + 4)
+
+#endif
+
+/* Lane i in every lane */
+#define MATH_SIMD4_LANE(a, i) MATH_SIMD4_SHUFFLE((a), (a), (i), (i), (i), (i))
+
+/* ============================================================================
+ *  mat4 kernels over row-major float[16]
+ * ==========================================================================*/
+
+/* out = a * b; out may alias a or b */
+static inline void math_simd4_mat4_mul(float *out, const float *a, const float *b) {
+    math_simd4 b0 = math_simd4_load(b + 0);
+    math_simd4 b1 = math_simd4_load(b + 4);
+    math_simd4 b2 = math_simd4_load(b + 8);
+    math_simd4 b3 = math_simd4_load(b + 12);
+
+    for (int i = 0; i < 4; ++i) {
+        math_simd4 row = math_simd4_load(a + 4 * i);
+        math_simd4 r   = math_simd4_mul(MATH_SIMD4_LANE(row, 0), b0);
+        r = math_simd4_add(r, math_simd4_mul(MATH_SIMD4_LANE(row, 1), b1));
+        r = math_simd4_add(r, math_simd4_mul(MATH_SIMD4_LANE(row, 2), b2));
+        r = math_simd4_add(r, math_simd4_mul(MATH_SIMD4_LANE(row, 3), b3));
+        math_simd4_store(out + 4 * i, r);
+    }
+}
+
+/* out = transpose(m); out must not alias m */
+static inline void math_simd4_mat4_transpose(float *out, const float *m) {
+    math_simd4 r0 = math_simd4_load(m + 0);
+    math_simd4 r1 = math_simd4_load(m + 4);
+    math_simd4 r2 = math_simd4_load(m + 8);
+    math_simd4 r3 = math_simd4_load(m + 12);
+
+    /* (r0.x r0.y r1.x r1.y), (r0.z r0.w r1.z r1.w), and the same for r2, r3 */
+    math_simd4 t0 = MATH_SIMD4_SHUFFLE(r0, r1, 0, 1, 0, 1);
+    math_simd4 t1 = MATH_SIMD4_SHUFFLE(r0, r1, 2, 3, 2, 3);
+    math_simd4 t2 = MATH_SIMD4_SHUFFLE(r2, r3, 0, 1, 0, 1);
+    math_simd4 t3 = MATH_SIMD4_SHUFFLE(r2, r3, 2, 3, 2, 3);
+
+    math_simd4_store(out + 0,  MATH_SIMD4_SHUFFLE(t0, t2, 0, 2, 0, 2));
+    math_simd4_store(out + 4,  MATH_SIMD4_SHUFFLE(t0, t2, 1, 3, 1, 3));
+    math_simd4_store(out + 8,  MATH_SIMD4_SHUFFLE(t1, t3, 0, 2, 0, 2));
+    math_simd4_store(out + 12, MATH_SIMD4_SHUFFLE(t1, t3, 1, 3, 1, 3));
+}
+
+/* x * row0 + y * row1 + z * row2, plus row3 when point is non-zero */
+static inline math_simd4 math_simd4_mat4_transform(float x, float y, float z, const float *m, int point) {
+    math_simd4 r = math_simd4_mul(math_simd4_splat(x), math_simd4_load(m + 0));
+    r = math_simd4_add(r, math_simd4_mul(math_simd4_splat(y), math_simd4_load(m + 4)));
+    r = math_simd4_add(r, math_simd4_mul(math_simd4_splat(z), math_simd4_load(m + 8)));
+    return point ? math_simd4_add(r, math_simd4_load(m + 12)) : r;
+}
+
+#endif /* MATH_SIMD */
+
+#endif /* _H_MATH_MATRICES_SIMD_ */
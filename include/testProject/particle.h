@@ -0,0 +1,216 @@
+#ifndef CYCLONE_PARTICLE_H
+#define CYCLONE_PARTICLE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "core.h"
+#include "snapshot.h"
+
+/*
+ * Cyclone particle world.
+ *
+ * Particle state is stored as structure-of-arrays (one real array per
+ * component) so the force and integration passes are straight loops the
+ * compiler can vectorise. The public interface speaks cyclone_Vector3.
+ *
+ * Forces come from registered generators. Each generator holds the list of
+ * particles it acts on and is applied to that whole list in one pass, rather
+ * than one (particle, generator) callback at a time.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ * Force generators
+ * ============================================================
+ */
+
+typedef enum cyclone_ParticleForceType {
+    CYCLONE_PARTICLE_GRAVITY,   /* constant acceleration, ignores mass */
+    CYCLONE_PARTICLE_DRAG,      /* -(k1 |v| + k2 |v|^2) along v */
+    CYCLONE_PARTICLE_SPRING,    /* Hooke's law between two particles */
+    CYCLONE_PARTICLE_BUOYANCY   /* liquid plane at water_height along +y */
+} cyclone_ParticleForceType;
+
+typedef struct cyclone_ParticleForceGenerator {
+    cyclone_ParticleForceType type;
+
+    union {
+        struct { cyclone_Vector3 gravity; } gravity;
+        struct { real k1; real k2; } drag;
+        struct { real spring_constant; real rest_length; } spring;
+        struct {
+            real max_depth;
+            real volume;
+            real water_height;
+            real liquid_density;
+        } buoyancy;
+    };
+
+    /*
+     * Particles acted on. Springs store their two ends as consecutive
+     * entries. When all is set the list is ignored and every particle
+     * in the world is affected (not valid for springs).
+     */
+    size_t *particles;
+    size_t  count;
+    size_t  capacity;
+    bool    all;
+} cyclone_ParticleForceGenerator;
+
+/* ============================================================
+ * Particle world
+ * ============================================================
+ */
+
+typedef struct cyclone_ParticleWorld {
+    real *position[3];
+    real *velocity[3];
+    real *acceleration[3];      /* constant part, e.g. from gravity */
+    real *force_accum[3];       /* cleared after every integration */
+    real *inverse_mass;         /* zero for immovable particles */
+    real *damping;              /* fraction of velocity kept per second */
+    size_t count;
+    size_t capacity;
+
+    /*
+     * damping^dt per particle, cached for damping_step. Only recomputed
+     * when the step size changes, so a fixed step never calls pow.
+     */
+    real *damping_factor;
+    real  damping_step;
+
+    /*
+     * Sum of the gravity generators applied to every particle this step.
+     * Added during integration instead of through force_accum, so the
+     * common case costs no pass and no division by inverse mass.
+     */
+    cyclone_Vector3 uniform_acceleration;
+
+    cyclone_ParticleForceGenerator *generators;
+    size_t generator_count;
+    size_t generator_capacity;
+} cyclone_ParticleWorld;
+
+/*
+ * Initialise an empty world. Always succeeds; nothing is allocated
+ * until particles are added.
+ */
+void cyclone_particle_world_init(cyclone_ParticleWorld *world);
+
+/*
+ * Free all particle and generator storage and reset to empty.
+ */
+void cyclone_particle_world_free(cyclone_ParticleWorld *world);
+
+/*
+ * Make room for at least capacity particles.
+ * Returns false on allocation failure (the world is left unchanged).
+ */
+bool cyclone_particle_world_reserve(cyclone_ParticleWorld *world, size_t capacity);
+
+/*
+ * Append a particle. mass <= 0 creates an immovable particle.
+ * Writes the new index to *out_index (may be NULL).
+ * Returns false on allocation failure.
+ */
+bool cyclone_particle_world_add(cyclone_ParticleWorld *world,
+                                cyclone_Vector3 position,
+                                cyclone_Vector3 velocity,
+                                real mass,
+                                real damping,
+                                size_t *out_index);
+
+/* Per-particle accessors */
+
+cyclone_Vector3 cyclone_particle_world_get_position(const cyclone_ParticleWorld *world, size_t i);
+cyclone_Vector3 cyclone_particle_world_get_velocity(const cyclone_ParticleWorld *world, size_t i);
+void cyclone_particle_world_set_position(cyclone_ParticleWorld *world, size_t i, cyclone_Vector3 position);
+void cyclone_particle_world_set_velocity(cyclone_ParticleWorld *world, size_t i, cyclone_Vector3 velocity);
+void cyclone_particle_world_set_acceleration(cyclone_ParticleWorld *world, size_t i, cyclone_Vector3 acceleration);
+void cyclone_particle_world_set_mass(cyclone_ParticleWorld *world, size_t i, real mass);
+void cyclone_particle_world_set_damping(cyclone_ParticleWorld *world, size_t i, real damping);
+
+/*
+ * Add force to particle i for the next integration only.
+ */
+void cyclone_particle_world_add_force(cyclone_ParticleWorld *world, size_t i, cyclone_Vector3 force);
+
+/*
+ * Register a generator. Each returns false on allocation failure and
+ * writes the generator index to *out_generator (may be NULL).
+ */
+bool cyclone_particle_world_add_gravity(cyclone_ParticleWorld *world,
+                                        cyclone_Vector3 gravity,
+                                        size_t *out_generator);
+bool cyclone_particle_world_add_drag(cyclone_ParticleWorld *world,
+                                     real k1, real k2,
+                                     size_t *out_generator);
+bool cyclone_particle_world_add_spring(cyclone_ParticleWorld *world,
+                                       real spring_constant, real rest_length,
+                                       size_t *out_generator);
+bool cyclone_particle_world_add_buoyancy(cyclone_ParticleWorld *world,
+                                         real max_depth, real volume,
+                                         real water_height, real liquid_density,
+                                         size_t *out_generator);
+
+/*
+ * Attach particle i to a gravity, drag or buoyancy generator.
+ * Returns false on allocation failure.
+ */
+bool cyclone_particle_generator_attach(cyclone_ParticleWorld *world,
+                                       size_t generator, size_t i);
+
+/*
+ * Connect particles a and b with a spring generator.
+ * Returns false on allocation failure.
+ */
+bool cyclone_particle_generator_connect(cyclone_ParticleWorld *world,
+                                        size_t generator, size_t a, size_t b);
+
+/*
+ * Make a gravity, drag or buoyancy generator act on every particle,
+ * including ones added later, without keeping an index list.
+ */
+void cyclone_particle_generator_apply_to_all(cyclone_ParticleWorld *world,
+                                             size_t generator);
+
+/*
+ * Run every generator over its particles, accumulating into force_accum.
+ */
+void cyclone_particle_world_apply_forces(cyclone_ParticleWorld *world);
+
+/*
+ * Semi-implicit Euler: velocity from (acceleration + force / mass), then
+ * position from the new velocity. Immovable particles do not move.
+ * Clears the force accumulators.
+ */
+void cyclone_particle_world_integrate(cyclone_ParticleWorld *world, real duration);
+
+/*
+ * apply_forces followed by integrate.
+ */
+void cyclone_particle_world_run_physics(cyclone_ParticleWorld *world, real duration);
+
+/*
+ * Append the state of every particle to the snapshot. Force generators
+ * are setup, not state, and are not saved. Returns false on allocation
+ * failure.
+ */
+bool cyclone_particle_world_save(const cyclone_ParticleWorld *world, cyclone_Snapshot *snapshot);
+
+/*
+ * Read back state written by cyclone_particle_world_save at *cursor.
+ * Particles added since the save are dropped; generators must not refer
+ * to them. Returns false, leaving the world unchanged, if the snapshot is
+ * short or storage cannot grow.
+ */
+bool cyclone_particle_world_load(cyclone_ParticleWorld *world, const cyclone_Snapshot *snapshot, size_t *cursor);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CYCLONE_PARTICLE_H */
@@ -0,0 +1,105 @@
+#ifndef CYCLONE_SNAPSHOT_H
+#define CYCLONE_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Flat byte buffer for saving and restoring simulation state.
+ *
+ * Modules append their state with their own save function (for example
+ * cyclone_body_world_save) and read it back in the same order with the
+ * matching load function and a cursor. Everything is plain arrays copied
+ * with memcpy, so a snapshot costs a few large copies and, once its
+ * buffer has grown, no allocation. Snapshots only make sense within one
+ * build of one process: they hold raw reals and sizes.
+ *
+ * cyclone_SnapshotRing keeps the last few snapshots by tick for rollback:
+ * restore the snapshot of the tick to rewind to, apply the corrected
+ * input and simulate forward again.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct cyclone_Snapshot {
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+    uint64_t tick;                  /* simulation step the state belongs to */
+} cyclone_Snapshot;
+
+/*
+ * Initialise empty. Always succeeds.
+ */
+void cyclone_snapshot_init(cyclone_Snapshot *snapshot);
+
+/*
+ * Free the buffer and reset to empty.
+ */
+void cyclone_snapshot_free(cyclone_Snapshot *snapshot);
+
+/*
+ * Forget the contents but keep the buffer for the next save.
+ */
+void cyclone_snapshot_clear(cyclone_Snapshot *snapshot);
+
+/*
+ * Append size bytes. Returns false on allocation failure (the snapshot
+ * is unchanged).
+ */
+bool cyclone_snapshot_write(cyclone_Snapshot *snapshot, const void *data, size_t size);
+
+/*
+ * Copy size bytes from *cursor into data and advance the cursor.
+ * Returns false, leaving the cursor alone, if fewer bytes remain.
+ */
+bool cyclone_snapshot_read(const cyclone_Snapshot *snapshot, size_t *cursor, void *data, size_t size);
+
+/*
+ * Pointer to the next size bytes at *cursor, advancing the cursor, or NULL
+ * if fewer remain. Lets loaders copy straight into their own arrays.
+ */
+const void *cyclone_snapshot_view(const cyclone_Snapshot *snapshot, size_t *cursor, size_t size);
+
+/* === Rollback ring === */
+
+typedef struct cyclone_SnapshotRing {
+    cyclone_Snapshot *slots;
+    size_t length;                  /* slots allocated */
+    size_t count;                   /* slots holding a snapshot */
+    size_t head;                    /* slot of the newest snapshot */
+} cyclone_SnapshotRing;
+
+/*
+ * Allocate length slots. Returns false on allocation failure.
+ */
+bool cyclone_snapshot_ring_init(cyclone_SnapshotRing *ring, size_t length);
+
+void cyclone_snapshot_ring_free(cyclone_SnapshotRing *ring);
+
+/*
+ * Slot for a new snapshot of tick, replacing the oldest once the ring is
+ * full. The slot comes back cleared with its buffer kept, ready for save
+ * calls.
+ */
+cyclone_Snapshot *cyclone_snapshot_ring_push(cyclone_SnapshotRing *ring, uint64_t tick);
+
+/*
+ * Newest snapshot taken at or before tick, or NULL if the ring no longer
+ * reaches back that far.
+ */
+cyclone_Snapshot *cyclone_snapshot_ring_find(cyclone_SnapshotRing *ring, uint64_t tick);
+
+/*
+ * Drop every snapshot newer than tick, e.g. after rewinding to it.
+ */
+void cyclone_snapshot_ring_discard_after(cyclone_SnapshotRing *ring, uint64_t tick);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CYCLONE_SNAPSHOT_H */
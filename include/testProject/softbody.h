@@ -0,0 +1,183 @@
+#ifndef CYCLONE_SOFTBODY_H
+#define CYCLONE_SOFTBODY_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "core.h"
+#include "particle.h"
+#include "jobs.h"
+#include "Geometry3D/geom3d_types.h"
+
+/*
+ * Position-based cloth and soft bodies (XPBD).
+ *
+ * A soft body is a set of constraints over particles of a
+ * cyclone_ParticleWorld; the particles keep their usual SoA storage, mass,
+ * damping and force generators. Each step is split into substeps, and
+ * each substep
+ *
+ *   1. runs the particle world's force generators and integrates it
+ *      (cyclone_particle_world_run_physics) to predict positions,
+ *   2. projects the constraints onto the predicted positions,
+ *   3. pushes particles out of the colliders,
+ *   4. derives velocities from the distance moved.
+ *
+ * Constraints are stored as flat arrays per kind:
+ *
+ *   stretch  distance between two particles (cloth edges)
+ *   bend     distance between the far vertices of two triangles sharing
+ *            an edge, resisting folding across it
+ *   volume   signed volume of a tetrahedron (solid soft bodies)
+ *
+ * Compliance (inverse stiffness, 0 = rigid) is set per kind. Before the
+ * first step each kind is coloured so that no two constraints of one
+ * colour share a particle and then sorted by colour; every colour is
+ * projected in parallel on threads workers. The order depends only on how
+ * the constraints were added, so results are the same for any thread
+ * count.
+ *
+ * Particles collide with spheres, OBBs and triangle meshes from geom3d
+ * (using the mesh's BVH when it has one), keeping thickness away from
+ * their surfaces.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Colours tried per constraint; the rest are projected on one thread */
+#define CYCLONE_SOFT_MAX_COLORS 64
+
+/* Two-particle distance constraints, sorted by colour after preparation */
+typedef struct cyclone_SoftDistanceSet {
+    size_t *a;
+    size_t *b;
+    real *rest;
+    real *lambda;                   /* accumulated multiplier, per substep */
+    size_t count;
+    size_t capacity;
+
+    /* Colour c is [color_start[c], color_start[c + 1]); group color_count is sequential */
+    size_t color_start[CYCLONE_SOFT_MAX_COLORS + 2];
+    size_t color_count;
+} cyclone_SoftDistanceSet;
+
+/* Tetrahedron volume constraints */
+typedef struct cyclone_SoftVolumeSet {
+    size_t *index[4];
+    real *rest;                     /* rest volume */
+    real *lambda;
+    size_t count;
+    size_t capacity;
+
+    size_t color_start[CYCLONE_SOFT_MAX_COLORS + 2];
+    size_t color_count;
+} cyclone_SoftVolumeSet;
+
+typedef struct cyclone_SoftBody {
+    /* Settings; init fills in defaults */
+    int  substeps;                  /* default 8 */
+    int  iterations;                /* projection passes per substep, default 1 */
+    real stretch_compliance;        /* default 0 */
+    real bend_compliance;           /* default 0.01 */
+    real volume_compliance;         /* default 0 */
+    real thickness;                 /* distance kept from colliders, default 0.01 */
+    real friction;                  /* fraction of sliding removed on contact, default 0.3 */
+    int  threads;                   /* workers, default 1 */
+
+    cyclone_SoftDistanceSet stretch;
+    cyclone_SoftDistanceSet bend;
+    cyclone_SoftVolumeSet volume;
+    bool prepared;                  /* constraints coloured since the last add */
+
+    /* Colliders, copied in at add time except meshes */
+    Sphere *spheres;
+    size_t sphere_count;
+    size_t sphere_capacity;
+
+    OBB *boxes;
+    size_t box_count;
+    size_t box_capacity;
+
+    const Mesh **meshes;            /* not owned; must outlive the soft body */
+    size_t mesh_count;
+    size_t mesh_capacity;
+
+    /* Scratch */
+    real *previous[3];              /* positions before the substep */
+    size_t previous_capacity;
+    uint64_t *color_mask;
+    size_t color_mask_capacity;
+
+    cyclone_JobPool *pool;
+    int pool_threads;
+} cyclone_SoftBody;
+
+/*
+ * Initialise with default settings and no constraints. Always succeeds.
+ */
+void cyclone_soft_body_init(cyclone_SoftBody *body);
+
+/*
+ * Free all storage and stop the workers. The particles stay in their world.
+ */
+void cyclone_soft_body_free(cyclone_SoftBody *body);
+
+/*
+ * Constraints take their rest values from the particles' current
+ * positions in world. Each returns false on allocation failure.
+ */
+bool cyclone_soft_body_add_stretch(cyclone_SoftBody *body, const cyclone_ParticleWorld *world,
+                                   size_t a, size_t b);
+bool cyclone_soft_body_add_bend(cyclone_SoftBody *body, const cyclone_ParticleWorld *world,
+                                size_t a, size_t b);
+bool cyclone_soft_body_add_tetrahedron(cyclone_SoftBody *body, const cyclone_ParticleWorld *world,
+                                       size_t i0, size_t i1, size_t i2, size_t i3);
+
+/*
+ * Stretch constraints for every edge of a triangle mesh (three particle
+ * indices per triangle) and a bend constraint across every edge shared by
+ * two triangles. Edges shared by more triangles get no bend constraint.
+ */
+bool cyclone_soft_body_add_triangles(cyclone_SoftBody *body, const cyclone_ParticleWorld *world,
+                                     const size_t *indices, size_t triangle_count);
+
+/*
+ * Add a columns x rows grid of particles starting at origin, spaced by
+ * the u and v edge vectors, with triangles between them. Each particle
+ * gets the given mass and damping. Writes the first particle's index to
+ * *out_first (may be NULL); particle (c, r) is first + r * columns + c.
+ */
+bool cyclone_soft_body_add_cloth(cyclone_SoftBody *body, cyclone_ParticleWorld *world,
+                                 cyclone_Vector3 origin, cyclone_Vector3 u, cyclone_Vector3 v,
+                                 size_t columns, size_t rows, real mass, real damping,
+                                 size_t *out_first);
+
+/*
+ * Colliders. Spheres and boxes are copied; meshes are referenced.
+ */
+bool cyclone_soft_body_add_sphere(cyclone_SoftBody *body, const Sphere *sphere);
+bool cyclone_soft_body_add_obb(cyclone_SoftBody *body, const OBB *obb);
+bool cyclone_soft_body_add_mesh(cyclone_SoftBody *body, const Mesh *mesh);
+void cyclone_soft_body_clear_colliders(cyclone_SoftBody *body);
+
+/*
+ * Colour and sort the constraints. step() does this when needed; call it
+ * up front to keep the cost out of the first frame.
+ * Returns false on allocation failure.
+ */
+bool cyclone_soft_body_prepare(cyclone_SoftBody *body, const cyclone_ParticleWorld *world);
+
+/*
+ * Advance the particles of world by duration in substeps, as described
+ * above. Particles that belong to no constraint still fall and collide.
+ * Returns false on allocation failure (the world is not advanced).
+ */
+bool cyclone_soft_body_step(cyclone_SoftBody *body, cyclone_ParticleWorld *world, real duration);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CYCLONE_SOFTBODY_H */
@@ -0,0 +1,111 @@
+#ifndef CYCLONE_TIMESTEP_H
+#define CYCLONE_TIMESTEP_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "core.h"
+#include "body.h"
+#include "particle.h"
+
+/*
+ * Fixed-step simulation clock and render interpolation.
+ *
+ * The render loop feeds wall-clock time into cyclone_fixed_step_advance(),
+ * which says how many fixed steps to simulate; the leftover time, as a
+ * fraction of a step, blends the last two simulated states for drawing:
+ *
+ *   int steps = cyclone_fixed_step_advance(&clock, frame_seconds);
+ *   for (int s = 0; s < steps; ++s)
+ *   {
+ *       cyclone_pose_history_store_bodies(&history, &world);
+ *       ... simulate one clock.step ...
+ *   }
+ *   real alpha = cyclone_fixed_step_alpha(&clock);
+ *   ... draw cyclone_pose_history_body_transform(&history, &world, i, alpha) ...
+ *
+ * The simulation then costs the same at any refresh rate and behaves the
+ * same for any frame timing. Drawing lags the simulation by up to a step.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Defaults for new clocks */
+#define CYCLONE_FIXED_STEP_MAX_FRAME ((real)0.25)
+#define CYCLONE_FIXED_STEP_MAX_STEPS 8
+
+typedef struct cyclone_FixedStep {
+    real step;                      /* seconds per simulation step */
+    real accumulator;               /* time not yet simulated, < step after advance */
+    real max_frame;                 /* longer frames (breakpoints, tab switches) are cut */
+    int  max_steps;                 /* steps per advance; time beyond is dropped */
+    uint64_t tick;                  /* steps taken; set it when rolling back */
+} cyclone_FixedStep;
+
+/*
+ * Start at tick 0 with nothing accumulated. step must be positive.
+ */
+void cyclone_fixed_step_init(cyclone_FixedStep *clock, real step);
+
+/*
+ * Add elapsed wall-clock seconds and return how many steps to simulate
+ * now, advancing tick by that many. When more than max_steps are due,
+ * the surplus is dropped so a slow machine slows the simulation down
+ * instead of falling ever further behind.
+ */
+int cyclone_fixed_step_advance(cyclone_FixedStep *clock, real elapsed);
+
+/*
+ * Fraction of a step accumulated since the last one, in [0, 1): the
+ * blend factor from the previous to the current state.
+ */
+real cyclone_fixed_step_alpha(const cyclone_FixedStep *clock);
+
+/* === Interpolation === */
+
+/*
+ * Positions and orientations from before the latest step, SoA like the
+ * worlds. Particle histories leave the orientations unused.
+ */
+typedef struct cyclone_PoseHistory {
+    real *position[3];
+    real *orientation[4];
+    size_t count;
+    size_t capacity;
+} cyclone_PoseHistory;
+
+void cyclone_pose_history_init(cyclone_PoseHistory *history);
+void cyclone_pose_history_free(cyclone_PoseHistory *history);
+
+/*
+ * Copy the current poses; call right before each step.
+ * Returns false on allocation failure.
+ */
+bool cyclone_pose_history_store_bodies(cyclone_PoseHistory *history, const cyclone_BodyWorld *world);
+bool cyclone_pose_history_store_particles(cyclone_PoseHistory *history, const cyclone_ParticleWorld *world);
+
+/*
+ * Pose of entry i blended alpha of the way from the stored one to the
+ * current one: positions linearly, orientations by normalised lerp along
+ * the shorter arc. Entries added after the store give the current pose.
+ */
+cyclone_Vector3 cyclone_pose_history_body_position(const cyclone_PoseHistory *history,
+                                                   const cyclone_BodyWorld *world,
+                                                   size_t i, real alpha);
+cyclone_Quaternion cyclone_pose_history_body_orientation(const cyclone_PoseHistory *history,
+                                                         const cyclone_BodyWorld *world,
+                                                         size_t i, real alpha);
+cyclone_Matrix4 cyclone_pose_history_body_transform(const cyclone_PoseHistory *history,
+                                                    const cyclone_BodyWorld *world,
+                                                    size_t i, real alpha);
+cyclone_Vector3 cyclone_pose_history_particle_position(const cyclone_PoseHistory *history,
+                                                       const cyclone_ParticleWorld *world,
+                                                       size_t i, real alpha);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CYCLONE_TIMESTEP_H */
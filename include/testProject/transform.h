@@ -0,0 +1,153 @@
+#ifndef MATH_TRANSFORM_H_
+#define MATH_TRANSFORM_H_
+
+#include "vectors.h"
+#include "matrices.h"
+
+/*
+ * Translation, rotation and scale kept apart, so poses can be chained,
+ * inverted and blended without building a 4x4. A Transform maps
+ *
+ *   p  ->  rotate(rotation, scale * p) + translation
+ *
+ * which is the same order as TransformEuler (scale, rotate, translate)
+ * and the same matrix transform_to_mat4 returns. Angles are in degrees as
+ * in the rotation builders of matrices.h.
+ *
+ * A TRS cannot hold shear, so transform_compose is exact only when the
+ * parent's scale is uniform (or the child does not rotate), and
+ * transform_inverse only when the scale is uniform; otherwise both drop
+ * the shear a matrix product would have.
+ */
+
+struct cyclone_Matrix4;
+struct cyclone_Vector3;
+struct cyclone_Quaternion;
+
+/* Unit quaternion for rotations: w + xi + yj + zk */
+typedef struct quat {
+    union {
+        struct {
+            float x;
+            float y;
+            float z;
+            float w;
+        };
+        float asArray[4];
+    };
+} quat;
+
+typedef struct Transform {
+    vec3 translation;
+    quat rotation;
+    vec3 scale;
+} Transform;
+
+/* Same scheme as MATH_VECTORS_INLINE: transform.c emits the out-of-line copies */
+#ifdef MATH_TRANSFORM_IMPLEMENTATION
+#define MATH_TRANSFORM_INLINE
+#else
+#define MATH_TRANSFORM_INLINE static inline
+#endif
+
+/* ============================================================================
+ *  Quaternions
+ * ==========================================================================*/
+
+quat quat_identity(void);
+
+/* Rotation by degrees about axis (need not be unit length), as AxisAngle */
+quat quat_from_axis_angle(vec3 axis, float degrees);
+
+/* Same rotation as Rotation(pitch, yaw, roll): Z, then X, then Y */
+quat quat_from_euler(float pitch, float yaw, float roll);
+
+quat quat_normalized(quat q);
+
+MATH_TRANSFORM_INLINE quat quat_conjugate(quat q) {
+    quat r;
+    r.x = -q.x;
+    r.y = -q.y;
+    r.z = -q.z;
+    r.w = q.w;
+    return r;
+}
+
+/* Hamilton product: rotating by r, then by l */
+MATH_TRANSFORM_INLINE quat quat_mul(quat l, quat r) {
+    quat q;
+    q.x = l.w * r.x + l.x * r.w + l.y * r.z - l.z * r.y;
+    q.y = l.w * r.y - l.x * r.z + l.y * r.w + l.z * r.x;
+    q.z = l.w * r.z + l.x * r.y - l.y * r.x + l.z * r.w;
+    q.w = l.w * r.w - l.x * r.x - l.y * r.y - l.z * r.z;
+    return q;
+}
+
+/* q v q* for unit q, as v + w t + (q.xyz x t) with t = 2 (q.xyz x v) */
+MATH_TRANSFORM_INLINE vec3 quat_rotate(quat q, vec3 v) {
+    vec3 u = vec3_make(q.x, q.y, q.z);
+    vec3 t = vec3_mul_scalar(vec3_cross(u, v), 2.0f);
+    return vec3_add(vec3_add(v, vec3_mul_scalar(t, q.w)), vec3_cross(u, t));
+}
+
+/* Blends along the shorter arc; nlerp is normalised lerp, slerp keeps constant speed */
+quat quat_nlerp(quat a, quat b, float t);
+quat quat_slerp(quat a, quat b, float t);
+
+/* ============================================================================
+ *  Transforms
+ * ==========================================================================*/
+
+Transform transform_identity(void);
+Transform transform_make(vec3 translation, quat rotation, vec3 scale);
+
+/* Position and Euler angles as stored by Model, unit scale */
+Transform transform_from_euler(vec3 translation, vec3 euler_degrees);
+
+MATH_TRANSFORM_INLINE vec3 transform_point(Transform t, vec3 p) {
+    return vec3_add(quat_rotate(t.rotation, vec3_mul(t.scale, p)), t.translation);
+}
+
+/* Scale and rotation only, as mat4_multiply_vector */
+MATH_TRANSFORM_INLINE vec3 transform_direction(Transform t, vec3 d) {
+    return quat_rotate(t.rotation, vec3_mul(t.scale, d));
+}
+
+/*
+ * The transform applying child, then parent: transform_point of the result
+ * equals transform_point(parent, transform_point(child, p)), and its matrix
+ * is mat4_mul(child matrix, parent matrix).
+ */
+MATH_TRANSFORM_INLINE Transform transform_compose(Transform parent, Transform child) {
+    Transform r;
+    r.translation = transform_point(parent, child.translation);
+    r.rotation    = quat_mul(parent.rotation, child.rotation);
+    r.scale       = vec3_mul(parent.scale, child.scale);
+    return r;
+}
+
+/* transform_point(transform_inverse(t), transform_point(t, p)) == p; scale must be non-zero */
+Transform transform_inverse(Transform t);
+
+/* Translation and scale blend linearly, rotation by quat_nlerp or quat_slerp */
+Transform transform_lerp(Transform a, Transform b, float t);
+Transform transform_slerp(Transform a, Transform b, float t);
+
+/* ============================================================================
+ *  Conversions
+ * ==========================================================================*/
+
+/* Row-vector matrix, as TransformEuler builds: scale, rotation, translation rows */
+mat4 transform_to_mat4(Transform t);
+
+/*
+ * The physics core's 3x4 matrix (column vectors), mapping points as
+ * transform_point does.
+ */
+void transform_to_cyclone_matrix4(Transform t, struct cyclone_Matrix4 *out);
+
+/* A rigid body pose: position and orientation as set by cyclone_matrix4_set_orientation_and_pos */
+Transform transform_from_cyclone(const struct cyclone_Vector3 *position,
+                                 const struct cyclone_Quaternion *orientation);
+
+#endif /* MATH_TRANSFORM_H_ */
@@ -3,6 +3,8 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <math.h>
+#include "fastmath.h"
 
 #ifndef NO_EXTRAS
 #include <stdio.h>
@@ -37,9 +39,109 @@ typedef struct vec3 {
     };
 } vec3;
 
+/*
+ * Hot vec3 operations, defined here so geometry loops in other translation
+ * units inline them without LTO. vectors.c defines
+ * MATH_VECTORS_IMPLEMENTATION before including this header, which emits the
+ * same definitions as the exported out-of-line symbols. A build may define
+ * MATH_VECTORS_INLINE itself; bench/ makes it noinline to time the calls.
+ */
+#ifdef MATH_VECTORS_IMPLEMENTATION
+#undef MATH_VECTORS_INLINE
+#define MATH_VECTORS_INLINE
+#elif !defined(MATH_VECTORS_INLINE)
+#define MATH_VECTORS_INLINE static inline
+#endif
+
+MATH_VECTORS_INLINE vec3 vec3_make(float x, float y, float z) {
+    vec3 v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+}
+
+MATH_VECTORS_INLINE vec3 vec3_add(vec3 l, vec3 r) {
+    vec3 out;
+    out.x = l.x + r.x;
+    out.y = l.y + r.y;
+    out.z = l.z + r.z;
+    return out;
+}
+
+MATH_VECTORS_INLINE vec3 vec3_sub(vec3 l, vec3 r) {
+    vec3 out;
+    out.x = l.x - r.x;
+    out.y = l.y - r.y;
+    out.z = l.z - r.z;
+    return out;
+}
+
+/* Component-wise multiply */
+MATH_VECTORS_INLINE vec3 vec3_mul(vec3 l, vec3 r) {
+    vec3 out;
+    out.x = l.x * r.x;
+    out.y = l.y * r.y;
+    out.z = l.z * r.z;
+    return out;
+}
+
+MATH_VECTORS_INLINE vec3 vec3_mul_scalar(vec3 v, float s) {
+    vec3 out;
+    out.x = v.x * s;
+    out.y = v.y * s;
+    out.z = v.z * s;
+    return out;
+}
+
+MATH_VECTORS_INLINE vec3 vec3_scale(vec3 v, float scalar) {
+    return vec3_mul_scalar(v, scalar);
+}
+
+MATH_VECTORS_INLINE float vec3_dot(vec3 l, vec3 r) {
+    return l.x * r.x + l.y * r.y + l.z * r.z;
+}
+
+MATH_VECTORS_INLINE float vec3_magnitude_sq(vec3 v) {
+    return vec3_dot(v, v);
+}
+
+MATH_VECTORS_INLINE float vec3_magnitude(vec3 v) {
+    return sqrtf(vec3_dot(v, v));
+}
+
+MATH_VECTORS_INLINE vec3 vec3_normalized(vec3 v) {
+    return vec3_mul_scalar(v, math_rsqrt(vec3_dot(v, v)));
+}
+
+/* 3D cross product */
+MATH_VECTORS_INLINE vec3 vec3_cross(vec3 l, vec3 r) {
+    vec3 result;
+    result.x = l.y * r.z - l.z * r.y;
+    result.y = l.z * r.x - l.x * r.z;
+    result.z = l.x * r.y - l.y * r.x;
+    return result;
+}
+
+/* Compatibility wrappers for matrices.c */
+MATH_VECTORS_INLINE float Dot(vec3 a, vec3 b) {
+    return vec3_dot(a, b);
+}
+
+MATH_VECTORS_INLINE vec3 Cross(vec3 a, vec3 b) {
+    return vec3_cross(a, b);
+}
+
+MATH_VECTORS_INLINE float Magnitude(vec3 v) {
+    return vec3_magnitude(v);
+}
+
+MATH_VECTORS_INLINE float MagnitudeSq(vec3 v) {
+    return vec3_magnitude_sq(v);
+}
+
 /* Constructors / helpers */
 vec2 vec2_make(float x, float y);
-vec3 vec3_make(float x, float y, float z);
 
 /* Safe indexed access */
 float vec2_get(const vec2 *v, size_t index);
@@ -50,22 +152,17 @@ void  vec3_set(vec3 *v, size_t index, float value);
 
 /* Arithmetic (returns new vectors) */
 vec2 vec2_add(vec2 l, vec2 r);
-vec3 vec3_add(vec3 l, vec3 r);
 
 vec2 vec2_sub(vec2 l, vec2 r);
-vec3 vec3_sub(vec3 l, vec3 r);
 
 /* Component-wise multiply */
 vec2 vec2_mul(vec2 l, vec2 r);
-vec3 vec3_mul(vec3 l, vec3 r);
 
 /* Scalar multiply */
 vec2 vec2_mul_scalar(vec2 v, float s);
-vec3 vec3_mul_scalar(vec3 v, float s);
 
 /* Convenience scaling aliases used by geometry code */
 vec2 vec2_scale(vec2 v, float scalar);
-vec3 vec3_scale(vec3 v, float scalar);
 
 #ifndef NO_EXTRAS
 /* Component-wise divide */
@@ -106,14 +203,11 @@ void vec3_div_scalar_inplace(vec3 *l, float s);
 
 /* Dot product */
 float vec2_dot(vec2 l, vec2 r);
-float vec3_dot(vec3 l, vec3 r);
 
 /* Length and squared length */
 float vec2_magnitude(vec2 v);
-float vec3_magnitude(vec3 v);
 
 float vec2_magnitude_sq(vec2 v);
-float vec3_magnitude_sq(vec3 v);
 
 #ifndef NO_EXTRAS
 /* Distance between two points */
@@ -134,10 +228,6 @@ void vec3_normalize(vec3 *v);
 
 /* Normalized copies (does not modify input) */
 vec2 vec2_normalized(vec2 v);
-vec3 vec3_normalized(vec3 v);
-
-/* 3D cross product */
-vec3 vec3_cross(vec3 l, vec3 r);
 
 /* Angle between vectors, in radians */
 float vec2_angle(vec2 l, vec2 r);
@@ -155,11 +245,7 @@ vec3 vec3_perpendicular(vec3 length, vec3 direction);
 vec2 vec2_reflect(vec2 sourceVector, vec2 normal);
 vec3 vec3_reflect(vec3 sourceVector, vec3 normal);
 
-/* Compatibility wrappers for matrices.c */
-float Dot(vec3 a, vec3 b);
-vec3  Cross(vec3 a, vec3 b);
-float Magnitude(vec3 v);
-float MagnitudeSq(vec3 v);
+/* Compatibility wrapper for matrices.c */
 vec3  Normalized(vec3 v);
 
 #endif /* MATH_VECTORS_H_ */
@@ -146,4 +146,79 @@ void collision_manifold_reset(CollisionManifold* result) {
         result->depth = FLT_MAX;
         contact_array_clear(&result->contacts);
     }
-}
\ No newline at end of file
+}
+
+/*******************************************************************************
+ * FixedManifold / ManifoldPool
+ ******************************************************************************/
+
+bool fixed_contact_array_push(FixedContactArray* arr, vec3 point) {
+    if (arr->count >= FIXED_MANIFOLD_MAX_CONTACTS) {
+        return false;
+    }
+    arr->data[arr->count++] = point;
+    return true;
+}
+
+void fixed_contact_array_swap_remove(FixedContactArray* arr, int index) {
+    if (index >= 0 && index < arr->count) {
+        arr->data[index] = arr->data[--arr->count];
+    }
+}
+
+void fixed_manifold_init(FixedManifold* result) {
+    if (result) {
+        result->colliding = false;
+        result->truncated = false;
+        result->normal = vec3_make(0, 0, 1);
+        result->depth = FLT_MAX;
+        result->contacts.count = 0;
+    }
+}
+
+void manifold_pool_init(ManifoldPool* pool) {
+    pool->data = NULL;
+    pool->count = 0;
+    pool->capacity = 0;
+}
+
+void manifold_pool_free(ManifoldPool* pool) {
+    if (pool->data) {
+        free(pool->data);
+        pool->data = NULL;
+    }
+    pool->count = 0;
+    pool->capacity = 0;
+}
+
+bool manifold_pool_reserve(ManifoldPool* pool, int capacity) {
+    if (capacity > pool->capacity) {
+        FixedManifold* data = realloc(pool->data, (size_t)capacity * sizeof(FixedManifold));
+        if (!data) {
+            return false;
+        }
+        pool->data = data;
+        pool->capacity = capacity;
+    }
+    return true;
+}
+
+void manifold_pool_clear(ManifoldPool* pool) {
+    pool->count = 0;
+}
+
+FixedManifold* manifold_pool_next(ManifoldPool* pool) {
+    if (pool->count >= pool->capacity) {
+        int new_cap = pool->capacity == 0 ? 64 : pool->capacity * 2;
+        if (!manifold_pool_reserve(pool, new_cap)) {
+            return &pool->overflow;
+        }
+    }
+    return &pool->data[pool->count];
+}
+
+void manifold_pool_commit(ManifoldPool* pool) {
+    if (pool->count < pool->capacity) {
+        pool->count++;
+    }
+}
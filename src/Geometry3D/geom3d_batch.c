@@ -0,0 +1,460 @@
+/**
+ * @file geom3d_batch.c
+ * @brief Structure-of-arrays shape sets and batched narrowphase tests
+ */
+#include "geom3d_batch.h"
+#include "geom3d_sat.h"
+#include "geom3d_simd.h"
+
+#include <stdlib.h>
+
+/*******************************************************************************
+ * Shape Sets
+ ******************************************************************************/
+
+/*
+ * On failure the arrays grown so far keep their larger buffers and the rest
+ * their old ones; the set's capacity only moves once every array has grown.
+ */
+static bool soa_arrays_reserve(float** arrays, int num_arrays, int capacity) {
+    for (int i = 0; i < num_arrays; ++i) {
+        float* data = realloc(arrays[i], (size_t)capacity * sizeof(float));
+        if (!data) {
+            return false;
+        }
+        arrays[i] = data;
+    }
+    return true;
+}
+
+static void soa_arrays_free(float** arrays, int num_arrays) {
+    for (int i = 0; i < num_arrays; ++i) {
+        free(arrays[i]);
+        arrays[i] = NULL;
+    }
+}
+
+static int soa_grow(int count, int capacity) {
+    if (count < capacity) {
+        return capacity;
+    }
+    return capacity == 0 ? 64 : capacity * 2;
+}
+
+void sphere_soa_init(SphereSoA* set) {
+    for (int i = 0; i < 3; ++i) {
+        set->position[i] = NULL;
+    }
+    set->radius = NULL;
+    set->count = 0;
+    set->capacity = 0;
+}
+
+void sphere_soa_free(SphereSoA* set) {
+    soa_arrays_free(set->position, 3);
+    free(set->radius);
+    set->radius = NULL;
+    set->count = 0;
+    set->capacity = 0;
+}
+
+bool sphere_soa_reserve(SphereSoA* set, int capacity) {
+    if (capacity > set->capacity) {
+        if (!soa_arrays_reserve(set->position, 3, capacity) ||
+            !soa_arrays_reserve(&set->radius, 1, capacity)) {
+            return false;
+        }
+        set->capacity = capacity;
+    }
+    return true;
+}
+
+void sphere_soa_clear(SphereSoA* set) {
+    set->count = 0;
+}
+
+int sphere_soa_push(SphereSoA* set, Sphere sphere) {
+    if (!sphere_soa_reserve(set, soa_grow(set->count, set->capacity))) {
+        return -1;
+    }
+    sphere_soa_set(set, set->count, sphere);
+    return set->count++;
+}
+
+void sphere_soa_set(SphereSoA* set, int index, Sphere sphere) {
+    for (int i = 0; i < 3; ++i) {
+        set->position[i][index] = sphere.position.v[i];
+    }
+    set->radius[index] = sphere.radius;
+}
+
+Sphere sphere_soa_get(const SphereSoA* set, int index) {
+    Sphere sphere;
+    for (int i = 0; i < 3; ++i) {
+        sphere.position.v[i] = set->position[i][index];
+    }
+    sphere.radius = set->radius[index];
+    return sphere;
+}
+
+void aabb_soa_init(AABBSoA* set) {
+    for (int i = 0; i < 3; ++i) {
+        set->position[i] = NULL;
+        set->size[i] = NULL;
+    }
+    set->count = 0;
+    set->capacity = 0;
+}
+
+void aabb_soa_free(AABBSoA* set) {
+    soa_arrays_free(set->position, 3);
+    soa_arrays_free(set->size, 3);
+    set->count = 0;
+    set->capacity = 0;
+}
+
+bool aabb_soa_reserve(AABBSoA* set, int capacity) {
+    if (capacity > set->capacity) {
+        if (!soa_arrays_reserve(set->position, 3, capacity) ||
+            !soa_arrays_reserve(set->size, 3, capacity)) {
+            return false;
+        }
+        set->capacity = capacity;
+    }
+    return true;
+}
+
+void aabb_soa_clear(AABBSoA* set) {
+    set->count = 0;
+}
+
+int aabb_soa_push(AABBSoA* set, AABB aabb) {
+    if (!aabb_soa_reserve(set, soa_grow(set->count, set->capacity))) {
+        return -1;
+    }
+    aabb_soa_set(set, set->count, aabb);
+    return set->count++;
+}
+
+void aabb_soa_set(AABBSoA* set, int index, AABB aabb) {
+    for (int i = 0; i < 3; ++i) {
+        set->position[i][index] = aabb.position.v[i];
+        set->size[i][index] = aabb.size.v[i];
+    }
+}
+
+AABB aabb_soa_get(const AABBSoA* set, int index) {
+    AABB aabb;
+    for (int i = 0; i < 3; ++i) {
+        aabb.position.v[i] = set->position[i][index];
+        aabb.size.v[i] = set->size[i][index];
+    }
+    return aabb;
+}
+
+void obb_soa_init(OBBSoA* set) {
+    for (int i = 0; i < 3; ++i) {
+        set->position[i] = NULL;
+        set->size[i] = NULL;
+    }
+    for (int i = 0; i < 9; ++i) {
+        set->orientation[i] = NULL;
+    }
+    set->count = 0;
+    set->capacity = 0;
+}
+
+void obb_soa_free(OBBSoA* set) {
+    soa_arrays_free(set->position, 3);
+    soa_arrays_free(set->size, 3);
+    soa_arrays_free(set->orientation, 9);
+    set->count = 0;
+    set->capacity = 0;
+}
+
+bool obb_soa_reserve(OBBSoA* set, int capacity) {
+    if (capacity > set->capacity) {
+        if (!soa_arrays_reserve(set->position, 3, capacity) ||
+            !soa_arrays_reserve(set->size, 3, capacity) ||
+            !soa_arrays_reserve(set->orientation, 9, capacity)) {
+            return false;
+        }
+        set->capacity = capacity;
+    }
+    return true;
+}
+
+void obb_soa_clear(OBBSoA* set) {
+    set->count = 0;
+}
+
+int obb_soa_push(OBBSoA* set, OBB obb) {
+    if (!obb_soa_reserve(set, soa_grow(set->count, set->capacity))) {
+        return -1;
+    }
+    obb_soa_set(set, set->count, obb);
+    return set->count++;
+}
+
+void obb_soa_set(OBBSoA* set, int index, OBB obb) {
+    for (int i = 0; i < 3; ++i) {
+        set->position[i][index] = obb.position.v[i];
+        set->size[i][index] = obb.size.v[i];
+        for (int j = 0; j < 3; ++j) {
+            set->orientation[i * 3 + j][index] = obb.orientation.m[i][j];
+        }
+    }
+}
+
+OBB obb_soa_get(const OBBSoA* set, int index) {
+    OBB obb;
+    for (int i = 0; i < 3; ++i) {
+        obb.position.v[i] = set->position[i][index];
+        obb.size.v[i] = set->size[i][index];
+        for (int j = 0; j < 3; ++j) {
+            obb.orientation.m[i][j] = set->orientation[i * 3 + j][index];
+        }
+    }
+    return obb;
+}
+
+/*******************************************************************************
+ * Lane Gathers
+ ******************************************************************************/
+
+/* One shape per lane; index holds the four shape indices of a group */
+static inline simd4f gather4(const float* src, const int index[4]) {
+    float lanes[4] = { src[index[0]], src[index[1]], src[index[2]], src[index[3]] };
+    return simd4f_load(lanes);
+}
+
+static inline void gather4_vec3(float* const src[3], const int index[4], simd4f out[3]) {
+    for (int i = 0; i < 3; ++i) {
+        out[i] = gather4(src[i], index);
+    }
+}
+
+/* x * x + y * y + z * z, in the same order as vec3_magnitude_sq */
+static inline simd4f simd4_length_sq(const simd4f v[3]) {
+    return simd4f_madd(v[2], v[2], simd4f_madd(v[1], v[1], simd4f_mul(v[0], v[0])));
+}
+
+/*******************************************************************************
+ * Group Kernels
+ *
+ * Each tests one group of four pairs and returns the overlap bits. The
+ * arithmetic follows the scalar tests operation for operation so the two
+ * agree on touching and grazing pairs.
+ ******************************************************************************/
+
+typedef int (*BatchKernel)(const void* a, const void* b, const int ia[4], const int ib[4]);
+
+static int sphere_sphere_group(const void* a, const void* b, const int ia[4], const int ib[4]) {
+    const SphereSoA* s1 = (const SphereSoA*)a;
+    const SphereSoA* s2 = (const SphereSoA*)b;
+
+    simd4f p1[3], p2[3], d[3];
+    gather4_vec3(s1->position, ia, p1);
+    gather4_vec3(s2->position, ib, p2);
+    for (int i = 0; i < 3; ++i) {
+        d[i] = simd4f_sub(p1[i], p2[i]);
+    }
+    simd4f radii_sum = simd4f_add(gather4(s1->radius, ia), gather4(s2->radius, ib));
+    return simd4m_bits(simd4f_lt(simd4_length_sq(d), simd4f_mul(radii_sum, radii_sum)));
+}
+
+static int sphere_aabb_group(const void* a, const void* b, const int ia[4], const int ib[4]) {
+    const SphereSoA* spheres = (const SphereSoA*)a;
+    const AABBSoA* boxes = (const AABBSoA*)b;
+
+    simd4f p[3], c[3], h[3], d[3];
+    gather4_vec3(spheres->position, ia, p);
+    gather4_vec3(boxes->position, ib, c);
+    gather4_vec3(boxes->size, ib, h);
+    for (int i = 0; i < 3; ++i) {
+        simd4f hi = simd4f_add(c[i], h[i]);
+        simd4f lo = simd4f_sub(c[i], h[i]);
+        simd4f closest = simd4f_max(simd4f_min(hi, lo), p[i]);
+        closest = simd4f_min(simd4f_max(hi, lo), closest);
+        d[i] = simd4f_sub(p[i], closest);
+    }
+    simd4f r = gather4(spheres->radius, ia);
+    return simd4m_bits(simd4f_lt(simd4_length_sq(d), simd4f_mul(r, r)));
+}
+
+static int sphere_obb_group(const void* a, const void* b, const int ia[4], const int ib[4]) {
+    const SphereSoA* spheres = (const SphereSoA*)a;
+    const OBBSoA* boxes = (const OBBSoA*)b;
+
+    simd4f p[3], c[3], dir[3], closest[3], d[3];
+    gather4_vec3(spheres->position, ia, p);
+    gather4_vec3(boxes->position, ib, c);
+    for (int i = 0; i < 3; ++i) {
+        dir[i] = simd4f_sub(p[i], c[i]);
+        closest[i] = c[i];
+    }
+    for (int i = 0; i < 3; ++i) {
+        simd4f axis[3];
+        for (int j = 0; j < 3; ++j) {
+            axis[j] = gather4(boxes->orientation[i * 3 + j], ib);
+        }
+        simd4f extent = gather4(boxes->size[i], ib);
+        simd4f distance = simd4f_madd(dir[2], axis[2], simd4f_madd(dir[1], axis[1], simd4f_mul(dir[0], axis[0])));
+        distance = simd4f_max(simd4f_neg(extent), simd4f_min(extent, distance));
+        for (int j = 0; j < 3; ++j) {
+            closest[j] = simd4f_madd(axis[j], distance, closest[j]);
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        d[i] = simd4f_sub(p[i], closest[i]);
+    }
+    simd4f r = gather4(spheres->radius, ia);
+    return simd4m_bits(simd4f_lt(simd4_length_sq(d), simd4f_mul(r, r)));
+}
+
+static int aabb_aabb_group(const void* a, const void* b, const int ia[4], const int ib[4]) {
+    const AABBSoA* a1 = (const AABBSoA*)a;
+    const AABBSoA* a2 = (const AABBSoA*)b;
+
+    simd4f c1[3], h1[3], c2[3], h2[3];
+    gather4_vec3(a1->position, ia, c1);
+    gather4_vec3(a1->size, ia, h1);
+    gather4_vec3(a2->position, ib, c2);
+    gather4_vec3(a2->size, ib, h2);
+
+    simd4m separated = simd4m_none();
+    for (int i = 0; i < 3; ++i) {
+        simd4f p1 = simd4f_add(c1[i], h1[i]), q1 = simd4f_sub(c1[i], h1[i]);
+        simd4f p2 = simd4f_add(c2[i], h2[i]), q2 = simd4f_sub(c2[i], h2[i]);
+        simd4f a_min = simd4f_min(p1, q1), a_max = simd4f_max(p1, q1);
+        simd4f b_min = simd4f_min(p2, q2), b_max = simd4f_max(p2, q2);
+        separated = simd4m_or(separated, simd4m_or(simd4f_gt(a_min, b_max), simd4f_gt(b_min, a_max)));
+    }
+    return ~simd4m_bits(separated) & 0xF;
+}
+
+/* obb_obb_sat without the axis tracking; a lane is out once any axis has depth < 0 */
+static int obb_obb_group(const void* a, const void* b, const int ia[4], const int ib[4]) {
+    const OBBSoA* o1 = (const OBBSoA*)a;
+    const OBBSoA* o2 = (const OBBSoA*)b;
+
+    simd4f ma[3][3], mb[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            ma[i][j] = gather4(o1->orientation[i * 3 + j], ia);
+            mb[i][j] = gather4(o2->orientation[i * 3 + j], ib);
+        }
+    }
+
+    simd4f eps = simd4f_set1(OBB_SAT_EPSILON);
+    simd4f R[3][3], AbsR[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            R[i][j] = simd4f_madd(ma[i][2], mb[j][2], simd4f_madd(ma[i][1], mb[j][1], simd4f_mul(ma[i][0], mb[j][0])));
+            AbsR[i][j] = simd4f_add(simd4f_abs(R[i][j]), eps);
+        }
+    }
+
+    simd4f pa[3], pb[3], d[3], t[3], ea[3], eb[3];
+    gather4_vec3(o1->position, ia, pa);
+    gather4_vec3(o2->position, ib, pb);
+    gather4_vec3(o1->size, ia, ea);
+    gather4_vec3(o2->size, ib, eb);
+    for (int i = 0; i < 3; ++i) {
+        d[i] = simd4f_sub(pb[i], pa[i]);
+    }
+    for (int i = 0; i < 3; ++i) {
+        t[i] = simd4f_madd(ma[i][2], d[2], simd4f_madd(ma[i][1], d[1], simd4f_mul(ma[i][0], d[0])));
+    }
+
+    simd4f zero = simd4f_zero();
+    simd4m separated = simd4m_none();
+
+    /* A's face axes */
+    for (int i = 0; i < 3; ++i) {
+        simd4f rb = simd4f_madd(eb[2], AbsR[i][2], simd4f_madd(eb[1], AbsR[i][1], simd4f_mul(eb[0], AbsR[i][0])));
+        simd4f depth = simd4f_sub(simd4f_add(ea[i], rb), simd4f_abs(t[i]));
+        separated = simd4m_or(separated, simd4f_lt(depth, zero));
+    }
+
+    /* B's face axes */
+    for (int j = 0; j < 3; ++j) {
+        simd4f ra = simd4f_madd(ea[2], AbsR[2][j], simd4f_madd(ea[1], AbsR[1][j], simd4f_mul(ea[0], AbsR[0][j])));
+        simd4f dist = simd4f_madd(t[2], R[2][j], simd4f_madd(t[1], R[1][j], simd4f_mul(t[0], R[0][j])));
+        simd4f depth = simd4f_sub(simd4f_add(ra, eb[j]), simd4f_abs(dist));
+        separated = simd4m_or(separated, simd4f_lt(depth, zero));
+    }
+
+    /* Edge-edge axes */
+    for (int i = 0; i < 3; ++i) {
+        if (simd4m_bits(separated) == 0xF) {
+            return 0;
+        }
+        int i1 = (i + 1) % 3;
+        int i2 = (i + 2) % 3;
+        for (int j = 0; j < 3; ++j) {
+            int j1 = (j + 1) % 3;
+            int j2 = (j + 2) % 3;
+            simd4f ra = simd4f_madd(ea[i2], AbsR[i1][j], simd4f_mul(ea[i1], AbsR[i2][j]));
+            simd4f rb = simd4f_madd(eb[j2], AbsR[i][j1], simd4f_mul(eb[j1], AbsR[i][j2]));
+            simd4f dist = simd4f_sub(simd4f_mul(t[i2], R[i1][j]), simd4f_mul(t[i1], R[i2][j]));
+            simd4f overlap = simd4f_sub(simd4f_add(ra, rb), simd4f_abs(dist));
+            separated = simd4m_or(separated, simd4f_lt(overlap, zero));
+        }
+    }
+    return ~simd4m_bits(separated) & 0xF;
+}
+
+/*******************************************************************************
+ * Batched Tests
+ ******************************************************************************/
+
+static const int group_popcount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+/* A short last group repeats its final pair in the spare lanes and masks them off */
+static int batch_run(const void* a, const void* b, const CollisionPair* pairs, int count,
+                     uint32_t* out_mask, BatchKernel kernel) {
+    int hits = 0;
+    for (int i = 0; i < count; i += 4) {
+        int lanes = count - i < 4 ? count - i : 4;
+        int ia[4], ib[4];
+        for (int l = 0; l < 4; ++l) {
+            const CollisionPair* pair = &pairs[i + (l < lanes ? l : lanes - 1)];
+            ia[l] = pair->a;
+            ib[l] = pair->b;
+        }
+
+        int bits = kernel(a, b, ia, ib) & ((1 << lanes) - 1);
+        if ((i & 31) == 0) {
+            out_mask[i >> 5] = 0;
+        }
+        out_mask[i >> 5] |= (uint32_t)bits << (i & 31);
+        hits += group_popcount[bits];
+    }
+    return hits;
+}
+
+int sphere_sphere_batch(const SphereSoA* a, const SphereSoA* b,
+                        const CollisionPair* pairs, int count, uint32_t* out_mask) {
+    return batch_run(a, b, pairs, count, out_mask, sphere_sphere_group);
+}
+
+int sphere_aabb_batch(const SphereSoA* spheres, const AABBSoA* boxes,
+                      const CollisionPair* pairs, int count, uint32_t* out_mask) {
+    return batch_run(spheres, boxes, pairs, count, out_mask, sphere_aabb_group);
+}
+
+int sphere_obb_batch(const SphereSoA* spheres, const OBBSoA* boxes,
+                     const CollisionPair* pairs, int count, uint32_t* out_mask) {
+    return batch_run(spheres, boxes, pairs, count, out_mask, sphere_obb_group);
+}
+
+int aabb_aabb_batch(const AABBSoA* a, const AABBSoA* b,
+                    const CollisionPair* pairs, int count, uint32_t* out_mask) {
+    return batch_run(a, b, pairs, count, out_mask, aabb_aabb_group);
+}
+
+int obb_obb_batch(const OBBSoA* a, const OBBSoA* b,
+                  const CollisionPair* pairs, int count, uint32_t* out_mask) {
+    return batch_run(a, b, pairs, count, out_mask, obb_obb_group);
+}
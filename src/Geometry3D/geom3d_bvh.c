@@ -6,8 +6,12 @@
 #include "geom3d_primitives.h"
 #include "geom3d_intersect.h"
 #include "geom3d_raycast.h"
+#include "geom3d_collision.h"
+#include "geom3d_arrays.h"
+#include "geom3d_sweep.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 /*******************************************************************************
@@ -82,11 +86,20 @@ void mesh_accelerate(Mesh* mesh) {
         mesh->accelerator->triangles[i] = i;
     }
 
-    bvhnode_split(mesh->accelerator, mesh, 3);
+    bvhnode_split(mesh->accelerator, mesh, BVH_MAX_DEPTH);
+}
+
+static bool aabb_coincident(AABB a, AABB b) {
+    for (int i = 0; i < 3; ++i) {
+        if (a.position.v[i] != b.position.v[i] || a.size.v[i] != b.size.v[i]) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void bvhnode_split(BVHNode* node, const Mesh* mesh, int depth) {
-    if (depth-- <= 0) {
+    if (depth-- <= 0 || node->num_triangles <= BVH_LEAF_TRIANGLES) {
         return;
     }
 
@@ -115,27 +128,48 @@ void bvhnode_split(BVHNode* node, const Mesh* mesh, int depth) {
     }
 
     if (node->children != NULL && node->num_triangles > 0) {
+        int* scratch = malloc((size_t)node->num_triangles * sizeof(int));
+        bool all_shared = true;
+
         for (int i = 0; i < 8; ++i) {
-            node->children[i].num_triangles = 0;
-            for (int j = 0; j < node->num_triangles; ++j) {
-                Triangle t = mesh->triangles[node->triangles[j]];
-                if (triangle_aabb(t, node->children[i].bounds)) {
-                    node->children[i].num_triangles += 1;
-                }
+            /*
+             * A flat node (e.g. a floor) splits into coincident children; only
+             * the first of each gets the triangles, or every query would walk
+             * and test the same leaf once per coincident copy.
+             */
+            bool coincident = false;
+            for (int j = 0; j < i && !coincident; ++j) {
+                coincident = aabb_coincident(node->children[i].bounds, node->children[j].bounds);
+            }
+            if (coincident) {
+                continue;
             }
 
-            if (node->children[i].num_triangles == 0) {
+            int count = triangle_aabb_batch(mesh->triangles, node->triangles, node->num_triangles,
+                                            node->children[i].bounds, scratch);
+            node->children[i].num_triangles = count;
+            all_shared = all_shared && count == node->num_triangles;
+            if (count == 0) {
                 continue;
             }
 
-            node->children[i].triangles = malloc((size_t)node->children[i].num_triangles * sizeof(int));
-            int index = 0;
-            for (int j = 0; j < node->num_triangles; ++j) {
-                Triangle t = mesh->triangles[node->triangles[j]];
-                if (triangle_aabb(t, node->children[i].bounds)) {
-                    node->children[i].triangles[index++] = node->triangles[j];
-                }
+            node->children[i].triangles = malloc((size_t)count * sizeof(int));
+            memcpy(node->children[i].triangles, scratch, (size_t)count * sizeof(int));
+        }
+        free(scratch);
+
+        /*
+         * Every child got every triangle: splitting further only copies them.
+         * One child holding them all (a fan around a vertex) still narrows
+         * the others, so it keeps splitting.
+         */
+        if (all_shared) {
+            for (int i = 0; i < 8; ++i) {
+                bvhnode_free(&node->children[i]);
             }
+            free(node->children);
+            node->children = NULL;
+            return;
         }
 
         node->num_triangles = 0;
@@ -180,13 +214,10 @@ bool mesh_aabb(const Mesh* mesh, AABB aabb) {
         while (!bvh_stack_empty(&stack)) {
             BVHNode* node = bvh_stack_pop(&stack);
 
-            if (node->num_triangles >= 0) {
-                for (int i = 0; i < node->num_triangles; ++i) {
-                    if (triangle_aabb(mesh->triangles[node->triangles[i]], aabb)) {
-                        bvh_stack_free(&stack);
-                        return true;
-                    }
-                }
+            if (node->num_triangles > 0 &&
+                triangle_aabb_batch(mesh->triangles, node->triangles, node->num_triangles, aabb, NULL) > 0) {
+                bvh_stack_free(&stack);
+                return true;
             }
 
             if (node->children != NULL) {
@@ -294,13 +325,10 @@ bool mesh_obb(const Mesh* mesh, OBB obb) {
         while (!bvh_stack_empty(&stack)) {
             BVHNode* node = bvh_stack_pop(&stack);
 
-            if (node->num_triangles >= 0) {
-                for (int i = 0; i < node->num_triangles; ++i) {
-                    if (triangle_obb(mesh->triangles[node->triangles[i]], obb)) {
-                        bvh_stack_free(&stack);
-                        return true;
-                    }
-                }
+            if (node->num_triangles > 0 &&
+                triangle_obb_batch(mesh->triangles, node->triangles, node->num_triangles, obb, NULL) > 0) {
+                bvh_stack_free(&stack);
+                return true;
             }
 
             if (node->children != NULL) {
@@ -392,6 +420,45 @@ bool mesh_triangle(const Mesh* mesh, Triangle triangle) {
     return false;
 }
 
+bool mesh_capsule(const Mesh* mesh, Capsule capsule) {
+    if (mesh->accelerator == NULL) {
+        for (int i = 0; i < mesh->num_triangles; ++i) {
+            if (triangle_capsule(mesh->triangles[i], capsule)) {
+                return true;
+            }
+        }
+    }
+    else {
+        AABB bounds = capsule_get_bounds(capsule);
+        BVHStack stack;
+        bvh_stack_init(&stack, 64);
+        bvh_stack_push(&stack, mesh->accelerator);
+
+        while (!bvh_stack_empty(&stack)) {
+            BVHNode* node = bvh_stack_pop(&stack);
+
+            if (node->num_triangles >= 0) {
+                for (int i = 0; i < node->num_triangles; ++i) {
+                    if (triangle_capsule(mesh->triangles[node->triangles[i]], capsule)) {
+                        bvh_stack_free(&stack);
+                        return true;
+                    }
+                }
+            }
+
+            if (node->children != NULL) {
+                for (int i = 7; i >= 0; --i) {
+                    if (aabb_aabb(node->children[i].bounds, bounds)) {
+                        bvh_stack_push(&stack, &node->children[i]);
+                    }
+                }
+            }
+        }
+        bvh_stack_free(&stack);
+    }
+    return false;
+}
+
 float mesh_ray(const Mesh* mesh, Ray3D ray) {
     if (mesh->accelerator == NULL) {
         for (int i = 0; i < mesh->num_triangles; ++i) {
@@ -442,4 +509,311 @@ float mesh_ray(const Mesh* mesh, Ray3D ray) {
 float raycast_mesh(const Mesh* mesh, Ray3D ray) {
     return mesh_ray(mesh, ray);
 }
-#endif
\ No newline at end of file
+#endif
+
+/*******************************************************************************
+ * Mesh Shape Casts
+ ******************************************************************************/
+
+typedef bool (*TriangleSweep)(const void* shape, vec3 motion, Triangle triangle, RaycastResult* out_result);
+
+static bool sweep_sphere_callback(const void* shape, vec3 motion, Triangle triangle, RaycastResult* out_result) {
+    return sweep_sphere_triangle(*(const Sphere*)shape, motion, triangle, out_result);
+}
+
+static bool sweep_capsule_callback(const void* shape, vec3 motion, Triangle triangle, RaycastResult* out_result) {
+    return sweep_capsule_triangle(*(const Capsule*)shape, motion, triangle, out_result);
+}
+
+static bool sweep_obb_callback(const void* shape, vec3 motion, Triangle triangle, RaycastResult* out_result) {
+    return sweep_obb_triangle(*(const OBB*)shape, motion, triangle, out_result);
+}
+
+static bool triangle_in_bounds(Triangle t, AABB bounds) {
+    vec3 min = aabb_get_min(bounds);
+    vec3 max = aabb_get_max(bounds);
+    for (int i = 0; i < 3; ++i) {
+        if (fminf(fminf(t.a.v[i], t.b.v[i]), t.c.v[i]) > max.v[i] ||
+            fmaxf(fmaxf(t.a.v[i], t.b.v[i]), t.c.v[i]) < min.v[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Nearest hit over the triangles touched by the swept bounds. Each hit
+ * shortens the remaining cast, which shrinks the bounds used for pruning.
+ */
+static bool mesh_sweep(const Mesh* mesh, const void* shape, AABB bounds, vec3 motion,
+                       TriangleSweep sweep, RaycastResult* out_result) {
+    raycast_result_reset(out_result);
+
+    float t_best = 1.0f;
+    bool hit = false;
+    AABB swept = aabb_swept(bounds, motion);
+    RaycastResult result;
+
+    if (mesh->accelerator == NULL) {
+        for (int i = 0; i < mesh->num_triangles && t_best > 0.0f; ++i) {
+            Triangle t = mesh->triangles[i];
+            if (triangle_in_bounds(t, swept) && sweep(shape, vec3_scale(motion, t_best), t, &result)) {
+                result.t *= t_best;
+                t_best = result.t;
+                swept = aabb_swept(bounds, vec3_scale(motion, t_best));
+                hit = true;
+                if (out_result) {
+                    *out_result = result;
+                }
+            }
+        }
+    }
+    else {
+        BVHStack stack;
+        bvh_stack_init(&stack, 64);
+        bvh_stack_push(&stack, mesh->accelerator);
+
+        while (!bvh_stack_empty(&stack) && t_best > 0.0f) {
+            BVHNode* node = bvh_stack_pop(&stack);
+
+            if (node->num_triangles >= 0) {
+                for (int i = 0; i < node->num_triangles && t_best > 0.0f; ++i) {
+                    Triangle t = mesh->triangles[node->triangles[i]];
+                    if (triangle_in_bounds(t, swept) && sweep(shape, vec3_scale(motion, t_best), t, &result)) {
+                        result.t *= t_best;
+                        t_best = result.t;
+                        swept = aabb_swept(bounds, vec3_scale(motion, t_best));
+                        hit = true;
+                        if (out_result) {
+                            *out_result = result;
+                        }
+                    }
+                }
+            }
+
+            if (node->children != NULL) {
+                for (int i = 7; i >= 0; --i) {
+                    if (aabb_aabb(node->children[i].bounds, swept)) {
+                        bvh_stack_push(&stack, &node->children[i]);
+                    }
+                }
+            }
+        }
+        bvh_stack_free(&stack);
+    }
+    return hit;
+}
+
+bool mesh_sweep_sphere(const Mesh* mesh, Sphere sphere, vec3 motion, RaycastResult* out_result) {
+    AABB bounds = aabb_create(sphere.position, vec3_make(sphere.radius, sphere.radius, sphere.radius));
+    return mesh_sweep(mesh, &sphere, bounds, motion, sweep_sphere_callback, out_result);
+}
+
+bool mesh_sweep_capsule(const Mesh* mesh, Capsule capsule, vec3 motion, RaycastResult* out_result) {
+    return mesh_sweep(mesh, &capsule, capsule_get_bounds(capsule), motion, sweep_capsule_callback, out_result);
+}
+
+bool mesh_sweep_obb(const Mesh* mesh, OBB obb, vec3 motion, RaycastResult* out_result) {
+    return mesh_sweep(mesh, &obb, obb_get_bounds(obb), motion, sweep_obb_callback, out_result);
+}
+
+/*******************************************************************************
+ * Mesh Collision Manifolds
+ ******************************************************************************/
+
+#define MESH_MANIFOLD_MAX_POINTS    64
+#define MESH_MANIFOLD_MAX_TRIANGLES 128
+#define MESH_MANIFOLD_NORMAL_COS    0.95f   /* Triangle contacts merged into the reference one's plane */
+#define MESH_MANIFOLD_FACE_COS      0.999f  /* Contact normal taken as the triangle's face normal */
+
+typedef struct MeshContacts {
+    Point3D points[MESH_MANIFOLD_MAX_POINTS];
+    float   depths[MESH_MANIFOLD_MAX_POINTS];
+    vec3    normals[MESH_MANIFOLD_MAX_POINTS];
+    bool    faces[MESH_MANIFOLD_MAX_POINTS];
+    int     count;
+    bool    truncated;      /* A new contact found the points full */
+    int     visited[MESH_MANIFOLD_MAX_TRIANGLES];
+    int     num_visited;
+} MeshContacts;
+
+/*
+ * Octree leaves share straddling triangles (a flat mesh lands in every
+ * leaf of a column), so each triangle is only generated once per query.
+ * Past the visited capacity nothing is dropped: triangles are generated
+ * again and their repeated points fold in mesh_contacts_has.
+ */
+static bool mesh_contacts_visit(MeshContacts* contacts, int triangle) {
+    for (int i = 0; i < contacts->num_visited; ++i) {
+        if (contacts->visited[i] == triangle) {
+            return false;
+        }
+    }
+    if (contacts->num_visited < MESH_MANIFOLD_MAX_TRIANGLES) {
+        contacts->visited[contacts->num_visited++] = triangle;
+    }
+    return true;
+}
+
+static bool mesh_contacts_has(const MeshContacts* contacts, Point3D point) {
+    for (int i = 0; i < contacts->count; ++i) {
+        if (vec3_magnitude_sq(vec3_sub(contacts->points[i], point)) < 1.0e-8f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void mesh_contacts_add(MeshContacts* contacts, const FixedManifold* m, Triangle triangle) {
+    vec3 n = vec3_cross(vec3_sub(triangle.b, triangle.a), vec3_sub(triangle.c, triangle.a));
+    float n_len = vec3_magnitude(n);
+    bool face = n_len > 0.0f && fabsf(vec3_dot(m->normal, n)) > MESH_MANIFOLD_FACE_COS * n_len;
+
+    for (int i = 0; i < m->contacts.count; ++i) {
+        if (mesh_contacts_has(contacts, m->contacts.data[i])) {
+            continue;
+        }
+        if (contacts->count == MESH_MANIFOLD_MAX_POINTS) {
+            contacts->truncated = true;
+            return;
+        }
+        contacts->points[contacts->count] = m->contacts.data[i];
+        contacts->depths[contacts->count] = m->depth;
+        contacts->normals[contacts->count] = m->normal;
+        contacts->faces[contacts->count] = face;
+        ++contacts->count;
+    }
+}
+
+/*
+ * The deepest face contact sets the normal; edge and vertex normals only
+ * when no triangle is hit on its face. On a tessellated surface the edges
+ * between triangles are interior, and their normals would tip the shape
+ * sideways. Contacts facing like the reference are kept and reduced,
+ * with the normal seen from the mesh.
+ */
+static bool mesh_contacts_resolve(MeshContacts* contacts, FixedManifold* out) {
+    if (contacts->count == 0) {
+        return false;
+    }
+
+    int reference = -1;
+    for (int i = 0; i < contacts->count; ++i) {
+        if (contacts->faces[i] && (reference < 0 || contacts->depths[i] > contacts->depths[reference])) {
+            reference = i;
+        }
+    }
+    if (reference < 0) {
+        reference = 0;
+        for (int i = 1; i < contacts->count; ++i) {
+            if (contacts->depths[i] > contacts->depths[reference]) {
+                reference = i;
+            }
+        }
+    }
+    vec3 normal = contacts->normals[reference];
+    float depth = contacts->depths[reference];
+
+    int count = 0;
+    for (int i = 0; i < contacts->count; ++i) {
+        if (vec3_dot(contacts->normals[i], normal) > MESH_MANIFOLD_NORMAL_COS) {
+            contacts->points[count] = contacts->points[i];
+            contacts->depths[count] = contacts->depths[i];
+            ++count;
+        }
+    }
+    count = reduce_contacts(contacts->points, contacts->depths, count, normal);
+
+    out->colliding = true;
+    out->truncated = contacts->truncated;
+    out->normal = vec3_scale(normal, -1.0f);
+    out->depth = depth;
+    for (int i = 0; i < count; ++i) {
+        fixed_contact_array_push(&out->contacts, contacts->points[i]);
+    }
+    return true;
+}
+
+typedef bool (*TriangleContacts)(const void* shape, Triangle triangle, FixedManifold* out);
+
+static bool capsule_contacts_callback(const void* shape, Triangle triangle, FixedManifold* out) {
+    return find_collision_features_capsule_triangle_fixed(*(const Capsule*)shape, triangle, out);
+}
+
+static bool sphere_contacts_callback(const void* shape, Triangle triangle, FixedManifold* out) {
+    return find_collision_features_sphere_triangle_fixed(*(const Sphere*)shape, triangle, out);
+}
+
+static bool obb_contacts_callback(const void* shape, Triangle triangle, FixedManifold* out) {
+    return find_collision_features_obb_triangle_fixed(*(const OBB*)shape, triangle, out);
+}
+
+#define MESH_CONTACT_BATCH 64
+
+/*
+ * Contacts from the triangles under bounds. Leaf triangles go through
+ * triangle_aabb_batch first, so only the few that touch the shape's bounds
+ * pay for contact generation.
+ */
+static bool mesh_gather_contacts(const Mesh* mesh, const void* shape, AABB bounds,
+                                 TriangleContacts generate, FixedManifold* out) {
+    fixed_manifold_init(out);
+
+    MeshContacts contacts;
+    FixedManifold m;
+    contacts.count = 0;
+    contacts.truncated = false;
+    contacts.num_visited = 0;
+
+    if (mesh->accelerator == NULL) {
+        for (int i = 0; i < mesh->num_triangles; ++i) {
+            if (triangle_in_bounds(mesh->triangles[i], bounds) && generate(shape, mesh->triangles[i], &m)) {
+                mesh_contacts_add(&contacts, &m, mesh->triangles[i]);
+            }
+        }
+    }
+    else {
+        int candidates[MESH_CONTACT_BATCH];
+        BVHStack stack;
+        bvh_stack_init(&stack, 64);
+        bvh_stack_push(&stack, mesh->accelerator);
+
+        while (!bvh_stack_empty(&stack)) {
+            BVHNode* node = bvh_stack_pop(&stack);
+
+            for (int i = 0; i < node->num_triangles; i += MESH_CONTACT_BATCH) {
+                int chunk = node->num_triangles - i < MESH_CONTACT_BATCH ? node->num_triangles - i : MESH_CONTACT_BATCH;
+                int hits = triangle_aabb_batch(mesh->triangles, node->triangles + i, chunk, bounds, candidates);
+                for (int j = 0; j < hits; ++j) {
+                    Triangle t = mesh->triangles[candidates[j]];
+                    if (mesh_contacts_visit(&contacts, candidates[j]) && generate(shape, t, &m)) {
+                        mesh_contacts_add(&contacts, &m, t);
+                    }
+                }
+            }
+
+            if (node->children != NULL) {
+                for (int i = 7; i >= 0; --i) {
+                    if (aabb_aabb(node->children[i].bounds, bounds)) {
+                        bvh_stack_push(&stack, &node->children[i]);
+                    }
+                }
+            }
+        }
+        bvh_stack_free(&stack);
+    }
+    return mesh_contacts_resolve(&contacts, out);
+}
+
+bool find_collision_features_mesh_capsule(const Mesh* mesh, Capsule capsule, FixedManifold* out) {
+    return mesh_gather_contacts(mesh, &capsule, capsule_get_bounds(capsule), capsule_contacts_callback, out);
+}
+
+bool find_collision_features_mesh_sphere(const Mesh* mesh, Sphere sphere, FixedManifold* out) {
+    AABB bounds = aabb_create(sphere.position, vec3_make(sphere.radius, sphere.radius, sphere.radius));
+    return mesh_gather_contacts(mesh, &sphere, bounds, sphere_contacts_callback, out);
+}
+
+bool find_collision_features_mesh_obb(const Mesh* mesh, OBB obb, FixedManifold* out) {
+    return mesh_gather_contacts(mesh, &obb, obb_get_bounds(obb), obb_contacts_callback, out);
+}
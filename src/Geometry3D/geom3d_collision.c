@@ -4,9 +4,11 @@
  */
 #include "geom3d_collision.h"
 #include "geom3d_arrays.h"
+#include "geom3d_primitives.h"
 #include "geom3d_queries.h"
 #include "geom3d_intersect.h"
 #include "geom3d_sat.h"
+#include "geom3d_gjk.h"
 #include "compare.h"
 
 #include <math.h>
@@ -108,9 +110,36 @@ int clip_edges_to_obb(const Line3D* edges, int num_edges, OBB obb,
     return count;
 }
 
+int clip_polygon_to_plane(const Point3D* in, int count, Plane plane, Point3D* out, int max_points) {
+    if (count == 0) {
+        return 0;
+    }
+
+    int result = 0;
+    Point3D a = in[count - 1];
+    float da = vec3_dot(plane.normal, a) - plane.distance;
+
+    for (int i = 0; i < count && result < max_points - 1; ++i) {
+        Point3D b = in[i];
+        float db = vec3_dot(plane.normal, b) - plane.distance;
+
+        if ((da <= 0.0f) != (db <= 0.0f)) {
+            float t = da / (da - db);
+            out[result++] = vec3_add(a, vec3_scale(vec3_sub(b, a), t));
+        }
+        if (db <= 0.0f) {
+            out[result++] = b;
+        }
+        a = b;
+        da = db;
+    }
+    return result;
+}
+
 float penetration_depth(OBB o1, OBB o2, vec3 axis, bool* out_should_flip) {
-    Interval3D i1 = interval3d_from_obb(o1, vec3_normalized(axis));
-    Interval3D i2 = interval3d_from_obb(o2, vec3_normalized(axis));
+    axis = vec3_normalized(axis);
+    Interval3D i1 = interval3d_from_obb(o1, axis);
+    Interval3D i2 = interval3d_from_obb(o2, axis);
 
     if (!((i2.min <= i1.max) && (i1.min <= i2.max))) {
         return 0.0f;
@@ -130,48 +159,156 @@ float penetration_depth(OBB o1, OBB o2, vec3 axis, bool* out_should_flip) {
 }
 
 /*******************************************************************************
- * Collision Manifold Functions
+ * Contact Reduction
  ******************************************************************************/
 
-CollisionManifold find_collision_features_sphere_sphere(Sphere A, Sphere B) {
-    CollisionManifold result;
-    collision_manifold_init(&result);
+/* Picks up to MANIFOLD_REDUCED_CONTACTS indices into points; returns how many */
+static int select_reduced_contacts(const Point3D* points, const float* depths,
+                                   int count, vec3 normal, int* keep) {
+    int num_keep = 0;
+
+    /* 1: deepest point */
+    int best = 0;
+    for (int i = 1; i < count; ++i) {
+        if (depths[i] > depths[best]) {
+            best = i;
+        }
+    }
+    keep[num_keep++] = best;
+    Point3D p0 = points[best];
 
+    /* 2: farthest from the deepest point */
+    float best_value = 0.0f;
+    best = -1;
+    for (int i = 0; i < count; ++i) {
+        float d = vec3_magnitude_sq(vec3_sub(points[i], p0));
+        if (d > best_value) {
+            best_value = d;
+            best = i;
+        }
+    }
+    if (best < 0) {
+        return num_keep;
+    }
+    keep[num_keep++] = best;
+    Point3D p1 = points[best];
+
+    /* 3: largest triangle with the first two */
+    vec3 e01 = vec3_sub(p1, p0);
+    float signed_area = 0.0f;
+    best_value = 0.0f;
+    best = -1;
+    for (int i = 0; i < count; ++i) {
+        float area = vec3_dot(vec3_cross(e01, vec3_sub(points[i], p0)), normal);
+        if (fabsf(area) > best_value) {
+            best_value = fabsf(area);
+            signed_area = area;
+            best = i;
+        }
+    }
+    if (best < 0 || CMP(best_value, 0.0f)) {
+        /* Collinear: if the deepest point is interior, also keep the far end */
+        best_value = vec3_magnitude_sq(e01);
+        best = -1;
+        for (int i = 0; i < count; ++i) {
+            float d = vec3_magnitude_sq(vec3_sub(points[i], p1));
+            if (d > best_value) {
+                best_value = d;
+                best = i;
+            }
+        }
+        if (best >= 0) {
+            keep[num_keep++] = best;
+        }
+        return num_keep;
+    }
+    keep[num_keep++] = best;
+    Point3D p2 = points[best];
+
+    /*
+     * 4: the point furthest outside the triangle grows the quad the most.
+     * Edge areas are oriented so that interior points are positive.
+     */
+    float winding = signed_area > 0.0f ? 1.0f : -1.0f;
+    Point3D tri[3] = { p0, p1, p2 };
+    best_value = 0.0f;
+    best = -1;
+    for (int i = 0; i < count; ++i) {
+        float outside = 0.0f;
+        for (int e = 0; e < 3; ++e) {
+            vec3 edge = vec3_sub(tri[(e + 1) % 3], tri[e]);
+            float area = winding * vec3_dot(vec3_cross(edge, vec3_sub(points[i], tri[e])), normal);
+            if (-area > outside) {
+                outside = -area;
+            }
+        }
+        if (outside > best_value) {
+            best_value = outside;
+            best = i;
+        }
+    }
+    if (best >= 0 && !CMP(best_value, 0.0f)) {
+        keep[num_keep++] = best;
+    }
+    return num_keep;
+}
+
+int reduce_contacts(Point3D* points, float* depths, int count, vec3 normal) {
+    if (count <= MANIFOLD_REDUCED_CONTACTS) {
+        return count;
+    }
+
+    int keep[MANIFOLD_REDUCED_CONTACTS];
+    int num_keep = select_reduced_contacts(points, depths, count, normal, keep);
+
+    Point3D kept_points[MANIFOLD_REDUCED_CONTACTS];
+    float kept_depths[MANIFOLD_REDUCED_CONTACTS];
+    for (int i = 0; i < num_keep; ++i) {
+        kept_points[i] = points[keep[i]];
+        kept_depths[i] = depths[keep[i]];
+    }
+    for (int i = 0; i < num_keep; ++i) {
+        points[i] = kept_points[i];
+        depths[i] = kept_depths[i];
+    }
+    return num_keep;
+}
+
+/*******************************************************************************
+ * Contact Generation (shared by CollisionManifold and FixedManifold)
+ ******************************************************************************/
+
+static bool sphere_sphere_features(Sphere A, Sphere B, vec3* out_normal,
+                                   float* out_depth, Point3D* out_contact) {
     float r = A.radius + B.radius;
     vec3 d = vec3_sub(B.position, A.position);
 
     if (vec3_magnitude_sq(d) - r * r > 0 || vec3_magnitude_sq(d) == 0.0f) {
-        return result;
+        return false;
     }
     d = vec3_normalized(d);
 
-    result.colliding = true;
-    result.normal = d;
-    result.depth = fabsf(vec3_magnitude(d) - r) * 0.5f;
+    *out_normal = d;
+    *out_depth = fabsf(vec3_magnitude(d) - r) * 0.5f;
 
-    float dtp = A.radius - result.depth;
-    Point3D contact = vec3_add(A.position, vec3_scale(d, dtp));
-
-    contact_array_push(&result.contacts, contact);
-
-    return result;
+    float dtp = A.radius - *out_depth;
+    *out_contact = vec3_add(A.position, vec3_scale(d, dtp));
+    return true;
 }
 
-CollisionManifold find_collision_features_obb_sphere(OBB A, Sphere B) {
-    CollisionManifold result;
-    collision_manifold_init(&result);
-
+static bool obb_sphere_features(OBB A, Sphere B, vec3* out_normal,
+                                float* out_depth, Point3D* out_contact) {
     Point3D closest_point = closest_point_on_obb(A, B.position);
 
     float distance_sq = vec3_magnitude_sq(vec3_sub(closest_point, B.position));
     if (distance_sq > B.radius * B.radius) {
-        return result;
+        return false;
     }
 
     vec3 normal;
     if (CMP(distance_sq, 0.0f)) {
         if (CMP(vec3_magnitude_sq(vec3_sub(closest_point, A.position)), 0.0f)) {
-            return result;
+            return false;
         }
         normal = vec3_normalized(vec3_sub(closest_point, A.position));
     }
@@ -182,104 +319,851 @@ CollisionManifold find_collision_features_obb_sphere(OBB A, Sphere B) {
     Point3D outside_point = vec3_sub(B.position, vec3_scale(normal, B.radius));
     float distance = vec3_magnitude(vec3_sub(closest_point, outside_point));
 
-    result.colliding = true;
-    contact_array_push(&result.contacts, 
-        vec3_add(closest_point, vec3_scale(vec3_sub(outside_point, closest_point), 0.5f)));
-    result.normal = normal;
-    result.depth = distance * 0.5f;
-
-    return result;
+    *out_contact = vec3_add(closest_point, vec3_scale(vec3_sub(outside_point, closest_point), 0.5f));
+    *out_normal = normal;
+    *out_depth = distance * 0.5f;
+    return true;
 }
 
-CollisionManifold find_collision_features_obb_obb(OBB A, OBB B) {
-    CollisionManifold result;
-    collision_manifold_init(&result);
+/* out_points must hold OBB_OBB_MAX_CLIP_POINTS; duplicates are removed in place */
+#define OBB_OBB_MAX_CLIP_POINTS 72  /* 12 edges * 6 planes max */
+
+static bool obb_obb_features(OBB A, OBB B, vec3* out_normal, float* out_depth,
+                             Point3D* out_points, int* out_count) {
+    *out_count = 0;
 
     /* Early out with bounding sphere test */
     Sphere s1 = sphere_create(A.position, vec3_magnitude(A.size));
     Sphere s2 = sphere_create(B.position, vec3_magnitude(B.size));
 
     if (!sphere_sphere(s1, s2)) {
-        return result;
+        return false;
+    }
+
+    vec3 axis;
+    float min_depth;
+    if (!obb_obb_sat(A, B, &axis, &min_depth)) {
+        return false;
+    }
+
+    /* Clip edges */
+    Line3D edges_b[12], edges_a[12];
+    obb_get_edges(B, edges_b);
+    obb_get_edges(A, edges_a);
+
+    int c1_count = clip_edges_to_obb(edges_b, 12, A, out_points, OBB_OBB_MAX_CLIP_POINTS / 2);
+    int c2_count = clip_edges_to_obb(edges_a, 12, B, out_points + c1_count, OBB_OBB_MAX_CLIP_POINTS / 2);
+    int count = c1_count + c2_count;
+
+    Interval3D interval = interval3d_from_obb(A, axis);
+    float distance = (interval.max - interval.min) * 0.5f - min_depth * 0.5f;
+    vec3 point_on_plane = vec3_add(A.position, vec3_scale(axis, distance));
+
+    /*
+     * Project contacts onto collision plane and remove duplicates. Everything
+     * above i is already projected, so a duplicate can be replaced by the last
+     * point instead of shifting the tail down. The distance each point moved
+     * is kept as its depth for the reduction step.
+     */
+    float depths[OBB_OBB_MAX_CLIP_POINTS];
+    for (int i = count - 1; i >= 0; --i) {
+        vec3 contact = out_points[i];
+        float offset = vec3_dot(axis, vec3_sub(point_on_plane, contact));
+        out_points[i] = vec3_add(contact, vec3_scale(axis, offset));
+        depths[i] = fabsf(offset);
+
+        for (int j = count - 1; j > i; --j) {
+            if (vec3_magnitude_sq(vec3_sub(out_points[j], out_points[i])) < 0.0001f) {
+                --count;
+                out_points[j] = out_points[count];
+                depths[j] = depths[count];
+                break;
+            }
+        }
+    }
+
+    count = reduce_contacts(out_points, depths, count, axis);
+
+    *out_normal = axis;
+    *out_depth = min_depth;
+    *out_count = count;
+    return true;
+}
+
+/*******************************************************************************
+ * Capsule Contact Generation
+ *
+ * Each generator writes up to CAPSULE_MAX_CONTACTS points; a capsule resting
+ * along a face gets both clipped ends of its axis so it does not rock.
+ ******************************************************************************/
+
+#define CAPSULE_FACE_COS 0.95f  /* Contact normal this close to a face normal tries two points */
+
+static vec3 any_perpendicular(vec3 v) {
+    vec3 axis = fabsf(v.x) < 0.57735f ? vec3_make(1, 0, 0) : vec3_make(0, 1, 0);
+    vec3 p = vec3_cross(v, axis);
+    return vec3_magnitude_sq(p) > 0.0f ? vec3_normalized(p) : vec3_make(0, 1, 0);
+}
+
+/* Midway between the capsule surface and the other shape along normal */
+static Point3D capsule_contact_point(Point3D axis_point, vec3 normal, float radius, float depth) {
+    return vec3_add(axis_point, vec3_scale(normal, radius - depth * 0.5f));
+}
+
+/*
+ * Clips the capsule axis to the prism over a face (each side keeps
+ * dot(n, p) <= d) and keeps the clipped ends within radius of the face.
+ * face.normal points from the face towards the capsule.
+ */
+static int capsule_face_contacts(Capsule A, Plane face, const Plane* sides, int num_sides,
+                                 Point3D* out_points, float* out_depths) {
+    vec3 ab = vec3_sub(A.end, A.start);
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+
+    for (int i = 0; i < num_sides; ++i) {
+        float da = plane_equation(A.start, sides[i]);
+        float db = plane_equation(A.end, sides[i]);
+        if (da > 0.0f && db > 0.0f) {
+            return 0;
+        }
+        if (da > 0.0f) {
+            t0 = fmaxf(t0, da / (da - db));
+        }
+        else if (db > 0.0f) {
+            t1 = fminf(t1, da / (da - db));
+        }
+    }
+    if (t0 > t1) {
+        return 0;
     }
 
-    vec3 test[15];
-    test[0] = vec3_make(A.orientation.m[0][0], A.orientation.m[0][1], A.orientation.m[0][2]);
-    test[1] = vec3_make(A.orientation.m[1][0], A.orientation.m[1][1], A.orientation.m[1][2]);
-    test[2] = vec3_make(A.orientation.m[2][0], A.orientation.m[2][1], A.orientation.m[2][2]);
-    test[3] = vec3_make(B.orientation.m[0][0], B.orientation.m[0][1], B.orientation.m[0][2]);
-    test[4] = vec3_make(B.orientation.m[1][0], B.orientation.m[1][1], B.orientation.m[1][2]);
-    test[5] = vec3_make(B.orientation.m[2][0], B.orientation.m[2][1], B.orientation.m[2][2]);
+    int count = 0;
+    float ts[2] = { t0, t1 };
+    for (int i = 0; i < (t1 > t0 ? 2 : 1); ++i) {
+        Point3D p = vec3_add(A.start, vec3_scale(ab, ts[i]));
+        float s = plane_equation(p, face);
+        if (s < A.radius) {
+            out_points[count] = vec3_sub(p, vec3_scale(face.normal, (s + A.radius) * 0.5f));
+            out_depths[count] = A.radius - s;
+            ++count;
+        }
+    }
+    return count;
+}
+
+/* Replaces a single contact with a face-clipped pair when there are two */
+static void capsule_try_face_contacts(Capsule A, Plane face, const Plane* sides, int num_sides,
+                                      vec3* out_normal, float* out_depth,
+                                      Point3D* out_points, int* out_count) {
+    Point3D points[CAPSULE_MAX_CONTACTS];
+    float depths[CAPSULE_MAX_CONTACTS];
 
+    if (vec3_dot(face.normal, *out_normal) > -CAPSULE_FACE_COS) {
+        return;
+    }
+    if (capsule_face_contacts(A, face, sides, num_sides, points, depths) == 2) {
+        *out_normal = vec3_scale(face.normal, -1.0f);
+        *out_depth = fmaxf(depths[0], depths[1]);
+        out_points[0] = points[0];
+        out_points[1] = points[1];
+        *out_count = 2;
+    }
+}
+
+static bool capsule_sphere_features(Capsule A, Sphere B, vec3* out_normal, float* out_depth,
+                                    Point3D* out_points, int* out_count) {
+    Point3D axis_point = closest_point_on_line3d(line3d_create(A.start, A.end), B.position);
+    vec3 d = vec3_sub(B.position, axis_point);
+    float r = A.radius + B.radius;
+    float dist_sq = vec3_magnitude_sq(d);
+
+    if (dist_sq > r * r) {
+        return false;
+    }
+
+    float dist = sqrtf(dist_sq);
+    *out_normal = dist > FLT_EPSILON ? vec3_scale(d, 1.0f / dist)
+                                     : any_perpendicular(vec3_sub(A.end, A.start));
+    *out_depth = r - dist;
+    out_points[0] = capsule_contact_point(axis_point, *out_normal, A.radius, *out_depth);
+    *out_count = 1;
+    return true;
+}
+
+static bool capsule_capsule_features(Capsule A, Capsule B, vec3* out_normal, float* out_depth,
+                                     Point3D* out_points, int* out_count) {
+    Line3D la = line3d_create(A.start, A.end);
+    Line3D lb = line3d_create(B.start, B.end);
+    Point3D pa, pb;
+    float dist_sq = closest_points_line3d_line3d(la, lb, &pa, &pb);
+    float r = A.radius + B.radius;
+
+    if (dist_sq > r * r) {
+        return false;
+    }
+
+    vec3 da = vec3_sub(A.end, A.start);
+    vec3 db = vec3_sub(B.end, B.start);
+    float dist = sqrtf(dist_sq);
+    vec3 normal;
+    if (dist > FLT_EPSILON) {
+        normal = vec3_scale(vec3_sub(pb, pa), 1.0f / dist);
+    }
+    else {
+        vec3 c = vec3_cross(da, db);
+        normal = vec3_magnitude_sq(c) > FLT_EPSILON ? vec3_normalized(c) : any_perpendicular(da);
+    }
+
+    *out_normal = normal;
+    *out_depth = r - dist;
+    out_points[0] = capsule_contact_point(pa, normal, A.radius, *out_depth);
+    *out_count = 1;
+
+    /* Parallel axes: contact at both ends of their overlap */
+    float da_sq = vec3_magnitude_sq(da);
+    float db_sq = vec3_magnitude_sq(db);
+    if (da_sq > FLT_EPSILON && db_sq > FLT_EPSILON &&
+        vec3_magnitude_sq(vec3_cross(da, db)) < 1.0e-6f * da_sq * db_sq) {
+        float t0 = vec3_dot(vec3_sub(B.start, A.start), da) / da_sq;
+        float t1 = vec3_dot(vec3_sub(B.end, A.start), da) / da_sq;
+        float lo = fmaxf(0.0f, fminf(t0, t1));
+        float hi = fminf(1.0f, fmaxf(t0, t1));
+        if (hi - lo > 1.0e-4f) {
+            out_points[0] = capsule_contact_point(vec3_add(A.start, vec3_scale(da, lo)), normal, A.radius, *out_depth);
+            out_points[1] = capsule_contact_point(vec3_add(A.start, vec3_scale(da, hi)), normal, A.radius, *out_depth);
+            *out_count = 2;
+        }
+    }
+    return true;
+}
+
+static bool capsule_obb_features(Capsule A, OBB B, vec3* out_normal, float* out_depth,
+                                 Point3D* out_points, int* out_count) {
+    GJKResult result;
+    if (!gjk_query(convex_shape_capsule(&A), convex_shape_obb(&B), NULL, &result)) {
+        return false;
+    }
+
+    *out_normal = result.normal;
+    *out_depth = result.depth;
+    out_points[0] = vec3_scale(vec3_add(result.point_a, result.point_b), 0.5f);
+    *out_count = 1;
+
+    /* Box face turned most towards the capsule, with its four side slabs */
+    vec3 axes[3];
+    int best = 0;
+    float best_dot = -FLT_MAX;
     for (int i = 0; i < 3; ++i) {
-        test[6 + i * 3 + 0] = vec3_cross(test[i], test[3]);
-        test[6 + i * 3 + 1] = vec3_cross(test[i], test[4]);
-        test[6 + i * 3 + 2] = vec3_cross(test[i], test[5]);
+        axes[i] = vec3_make(B.orientation.m[i][0], B.orientation.m[i][1], B.orientation.m[i][2]);
+        float d = fabsf(vec3_dot(axes[i], result.normal));
+        if (d > best_dot) {
+            best_dot = d;
+            best = i;
+        }
+    }
+    vec3 face_normal = vec3_dot(axes[best], result.normal) < 0.0f ? axes[best] : vec3_scale(axes[best], -1.0f);
+    Plane face = plane_create(face_normal, vec3_dot(face_normal, B.position) + B.size.v[best]);
+
+    Plane sides[4];
+    int num_sides = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (i == best) {
+            continue;
+        }
+        float c = vec3_dot(axes[i], B.position);
+        sides[num_sides++] = plane_create(axes[i], c + B.size.v[i]);
+        sides[num_sides++] = plane_create(vec3_scale(axes[i], -1.0f), -c + B.size.v[i]);
+    }
+
+    capsule_try_face_contacts(A, face, sides, num_sides, out_normal, out_depth, out_points, out_count);
+    return true;
+}
+
+static bool capsule_plane_features(Capsule A, Plane B, vec3* out_normal, float* out_depth,
+                                   Point3D* out_points, int* out_count) {
+    const Point3D ends[2] = { A.start, A.end };
+    int count = 0;
+
+    /* Two-sided like capsule_plane: push out on the side the capsule's centre is on */
+    Point3D center = vec3_scale(vec3_add(A.start, A.end), 0.5f);
+    if (plane_equation(center, B) < 0.0f) {
+        B = plane_create(vec3_scale(B.normal, -1.0f), -B.distance);
+    }
+
+    *out_depth = 0.0f;
+    for (int i = 0; i < 2; ++i) {
+        float s = plane_equation(ends[i], B);
+        if (s < A.radius) {
+            out_points[count++] = vec3_sub(ends[i], vec3_scale(B.normal, (s + A.radius) * 0.5f));
+            *out_depth = fmaxf(*out_depth, A.radius - s);
+        }
+    }
+    if (count == 2 && vec3_magnitude_sq(vec3_sub(A.end, A.start)) <= FLT_EPSILON) {
+        count = 1;
+    }
+
+    *out_normal = vec3_scale(B.normal, -1.0f);
+    *out_count = count;
+    return count > 0;
+}
+
+static bool capsule_triangle_features(Capsule A, Triangle B, vec3* out_normal, float* out_depth,
+                                      Point3D* out_points, int* out_count) {
+    Point3D pa, pb;
+    float dist_sq = closest_points_line3d_triangle(line3d_create(A.start, A.end), B, &pa, &pb);
+    if (dist_sq > A.radius * A.radius) {
+        return false;
     }
 
-    vec3* hit_normal = NULL;
-    bool should_flip;
+    vec3 n = vec3_cross(vec3_sub(B.b, B.a), vec3_sub(B.c, B.a));
+    bool has_plane = vec3_magnitude_sq(n) > FLT_EPSILON * FLT_EPSILON;
+    Plane plane = has_plane ? plane_from_triangle(B) : plane_create(vec3_make(0, 1, 0), 0.0f);
 
-    for (int i = 0; i < 15; ++i) {
-        if (test[i].x < 0.000001f) test[i].x = 0.0f;
-        if (test[i].y < 0.000001f) test[i].y = 0.0f;
-        if (test[i].z < 0.000001f) test[i].z = 0.0f;
-        if (vec3_magnitude_sq(test[i]) < 0.001f) {
+    /* Triangle normal turned towards the capsule */
+    Point3D center = vec3_scale(vec3_add(A.start, A.end), 0.5f);
+    if (plane_equation(center, plane) < 0.0f) {
+        plane = plane_create(vec3_scale(plane.normal, -1.0f), -plane.distance);
+    }
+
+    float dist = sqrtf(dist_sq);
+    if (dist > FLT_EPSILON) {
+        *out_normal = vec3_scale(vec3_sub(pb, pa), 1.0f / dist);
+        *out_depth = A.radius - dist;
+    }
+    else {
+        /* Axis pierces the triangle: push out along the face */
+        *out_normal = has_plane ? vec3_scale(plane.normal, -1.0f) : any_perpendicular(vec3_sub(A.end, A.start));
+        *out_depth = A.radius - fminf(plane_equation(A.start, plane), plane_equation(A.end, plane));
+    }
+    out_points[0] = capsule_contact_point(pa, *out_normal, A.radius, *out_depth);
+    *out_count = 1;
+
+    if (has_plane) {
+        Plane sides[3];
+        vec3 winding = vec3_normalized(n);
+        for (int i = 0; i < 3; ++i) {
+            Point3D p = B.points[i];
+            Point3D q = B.points[(i + 1) % 3];
+            vec3 side = vec3_normalized(vec3_cross(vec3_sub(q, p), winding));
+            sides[i] = plane_create(side, vec3_dot(side, p));
+        }
+        capsule_try_face_contacts(A, plane, sides, 3, out_normal, out_depth, out_points, out_count);
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Triangle Contact Generation
+ *
+ * Triangles are two-sided: the face normal is turned towards the other
+ * shape. Normals point from the shape towards the triangle.
+ ******************************************************************************/
+
+#define OBB_TRIANGLE_MAX_CLIP_POINTS 16
+#define OBB_TRIANGLE_FACE_TOLERANCE  0.98f  /* Relative bias towards face axes, and towards the triangle */
+#define OBB_TRIANGLE_LINEAR_SLOP     0.001f
+
+static bool sphere_triangle_features(Sphere A, Triangle B, vec3* out_normal,
+                                     float* out_depth, Point3D* out_contact) {
+    Point3D closest = closest_point_on_triangle(B, A.position);
+    vec3 diff = vec3_sub(closest, A.position);
+    float dist_sq = vec3_magnitude_sq(diff);
+    if (dist_sq > A.radius * A.radius) {
+        return false;
+    }
+
+    float dist = sqrtf(dist_sq);
+    if (dist > FLT_EPSILON) {
+        *out_normal = vec3_scale(diff, 1.0f / dist);
+        *out_depth = A.radius - dist;
+    }
+    else {
+        /* Centre on the triangle: push out along the face */
+        vec3 n = vec3_cross(vec3_sub(B.b, B.a), vec3_sub(B.c, B.a));
+        if (vec3_magnitude_sq(n) <= FLT_EPSILON * FLT_EPSILON) {
+            return false;
+        }
+        *out_normal = vec3_scale(vec3_normalized(n), -1.0f);
+        *out_depth = A.radius;
+    }
+    *out_contact = vec3_add(A.position, vec3_scale(*out_normal, A.radius - *out_depth * 0.5f));
+    return true;
+}
+
+/* Points of a clipped incident polygon below the reference plane, moved halfway onto it */
+static int reference_face_contacts(const Point3D* polygon, int count, Plane reference,
+                                   Point3D* out_points, float* out_depths) {
+    int num_points = 0;
+    for (int i = 0; i < count; ++i) {
+        float separation = plane_equation(polygon[i], reference);
+        if (separation <= 0.0f) {
+            out_points[num_points] = vec3_sub(polygon[i], vec3_scale(reference.normal, 0.5f * separation));
+            out_depths[num_points] = -separation;
+            ++num_points;
+        }
+    }
+    return num_points;
+}
+
+/* Box face most anti-parallel to the triangle normal, clipped to the triangle's prism */
+static int obb_triangle_face_contacts(OBB A, const vec3 u[3], Triangle B, vec3 n,
+                                      Point3D* out_points, float* out_depths) {
+    int k = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (fabsf(vec3_dot(u[i], n)) > fabsf(vec3_dot(u[k], n))) {
+            k = i;
+        }
+    }
+    int k1 = (k + 1) % 3;
+    int k2 = (k + 2) % 3;
+    vec3 f = vec3_dot(u[k], n) > 0.0f ? vec3_scale(u[k], -1.0f) : u[k];
+    Point3D center = vec3_add(A.position, vec3_scale(f, A.size.v[k]));
+    vec3 s1 = vec3_scale(u[k1], A.size.v[k1]);
+    vec3 s2 = vec3_scale(u[k2], A.size.v[k2]);
+
+    Point3D buffers[2][OBB_TRIANGLE_MAX_CLIP_POINTS];
+    Point3D* input = buffers[0];
+    Point3D* output = buffers[1];
+    input[0] = vec3_add(vec3_add(center, s1), s2);
+    input[1] = vec3_sub(vec3_add(center, s1), s2);
+    input[2] = vec3_sub(vec3_sub(center, s1), s2);
+    input[3] = vec3_add(vec3_sub(center, s1), s2);
+    int count = 4;
+
+    Point3D centroid = vec3_scale(vec3_add(vec3_add(B.a, B.b), B.c), 1.0f / 3.0f);
+    for (int i = 0; i < 3 && count > 0; ++i) {
+        Point3D p = B.points[i];
+        vec3 side = vec3_cross(vec3_sub(B.points[(i + 1) % 3], p), n);
+        if (vec3_dot(side, vec3_sub(centroid, p)) > 0.0f) {
+            side = vec3_scale(side, -1.0f);
+        }
+        count = clip_polygon_to_plane(input, count, plane_create(side, vec3_dot(side, p)), output,
+                                      OBB_TRIANGLE_MAX_CLIP_POINTS);
+        Point3D* swap = input;
+        input = output;
+        output = swap;
+    }
+    return reference_face_contacts(input, count, plane_create(n, vec3_dot(n, B.a)), out_points, out_depths);
+}
+
+/* Triangle clipped to the side planes of box face f = sign * u[k] */
+static int obb_face_triangle_contacts(OBB A, const vec3 u[3], int k, float sign, Triangle B,
+                                      Point3D* out_points, float* out_depths) {
+    Point3D buffers[2][OBB_TRIANGLE_MAX_CLIP_POINTS];
+    Point3D* input = buffers[0];
+    Point3D* output = buffers[1];
+    int count = 3;
+    for (int i = 0; i < 3; ++i) {
+        input[i] = B.points[i];
+    }
+
+    for (int j = 0; j < 3 && count > 0; ++j) {
+        if (j == k) {
             continue;
         }
+        for (int s = 0; s < 2 && count > 0; ++s) {
+            vec3 side = s == 0 ? u[j] : vec3_scale(u[j], -1.0f);
+            Plane plane = plane_create(side, vec3_dot(side, A.position) + A.size.v[j]);
+            count = clip_polygon_to_plane(input, count, plane, output, OBB_TRIANGLE_MAX_CLIP_POINTS);
+            Point3D* swap = input;
+            input = output;
+            output = swap;
+        }
+    }
+
+    vec3 f = vec3_scale(u[k], sign);
+    Plane reference = plane_create(f, vec3_dot(f, A.position) + A.size.v[k]);
+    return reference_face_contacts(input, count, reference, out_points, out_depths);
+}
+
+/*
+ * SAT over the triangle normal, the box axes and the nine edge cross
+ * products. Face axes win near-ties so resting contacts clip a face
+ * (up to MANIFOLD_REDUCED_CONTACTS points); edge axes give one point.
+ */
+static bool obb_triangle_features(OBB A, Triangle B, vec3* out_normal, float* out_depth,
+                                  Point3D* out_points, int* out_count) {
+    *out_count = 0;
+
+    vec3 u[3];
+    for (int i = 0; i < 3; ++i) {
+        u[i] = vec3_make(A.orientation.m[i][0], A.orientation.m[i][1], A.orientation.m[i][2]);
+    }
+    vec3 e[3];
+    for (int j = 0; j < 3; ++j) {
+        e[j] = vec3_sub(B.points[(j + 1) % 3], B.points[j]);
+    }
 
-        float depth = penetration_depth(A, B, test[i], &should_flip);
-        if (depth <= 0.0f) {
-            return result;
+    vec3 n = vec3_cross(e[0], e[1]);
+    float n_len = vec3_magnitude(n);
+    if (n_len <= FLT_EPSILON) {
+        return false;
+    }
+    n = vec3_scale(n, 1.0f / n_len);
+    if (vec3_dot(n, vec3_sub(A.position, B.a)) < 0.0f) {
+        n = vec3_scale(n, -1.0f);
+    }
+
+    /* Triangle face: how far the box reaches below the plane */
+    float box_radius = A.size.x * fabsf(vec3_dot(u[0], n)) +
+                       A.size.y * fabsf(vec3_dot(u[1], n)) +
+                       A.size.z * fabsf(vec3_dot(u[2], n));
+    float tri_depth = box_radius - vec3_dot(n, vec3_sub(A.position, B.a));
+    if (tri_depth < 0.0f) {
+        return false;
+    }
+
+    /* Box faces */
+    int box_axis = 0;
+    float box_sign = 1.0f;
+    float box_depth = FLT_MAX;
+    for (int i = 0; i < 3; ++i) {
+        float lo = FLT_MAX, hi = -FLT_MAX;
+        for (int k = 0; k < 3; ++k) {
+            float p = vec3_dot(u[i], vec3_sub(B.points[k], A.position));
+            lo = fminf(lo, p);
+            hi = fmaxf(hi, p);
+        }
+        float above = A.size.v[i] - lo;
+        float below = hi + A.size.v[i];
+        float depth = fminf(above, below);
+        if (depth < 0.0f) {
+            return false;
+        }
+        if (depth < box_depth) {
+            box_depth = depth;
+            box_axis = i;
+            box_sign = above < below ? 1.0f : -1.0f;
         }
-        else if (depth < result.depth) {
-            if (should_flip) {
-                test[i] = vec3_scale(test[i], -1.0f);
+    }
+
+    /* Edge-edge axes, oriented from the box towards the triangle */
+    int edge_box = -1, edge_tri = -1;
+    float edge_depth = FLT_MAX;
+    vec3 edge_axis = n;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            vec3 axis = vec3_cross(u[i], e[j]);
+            float len = vec3_magnitude(axis);
+            if (len <= 1.0e-6f * vec3_magnitude(e[j])) {
+                continue;
+            }
+            axis = vec3_scale(axis, 1.0f / len);
+
+            float r = A.size.x * fabsf(vec3_dot(u[0], axis)) +
+                      A.size.y * fabsf(vec3_dot(u[1], axis)) +
+                      A.size.z * fabsf(vec3_dot(u[2], axis));
+            float lo = FLT_MAX, hi = -FLT_MAX;
+            for (int k = 0; k < 3; ++k) {
+                float p = vec3_dot(axis, vec3_sub(B.points[k], A.position));
+                lo = fminf(lo, p);
+                hi = fmaxf(hi, p);
+            }
+            float above = r - lo;
+            float below = hi + r;
+            float depth = fminf(above, below);
+            if (depth < 0.0f) {
+                return false;
+            }
+            if (depth < edge_depth) {
+                edge_depth = depth;
+                edge_axis = above < below ? axis : vec3_scale(axis, -1.0f);
+                edge_box = i;
+                edge_tri = j;
             }
-            result.depth = depth;
-            hit_normal = &test[i];
         }
     }
 
-    if (hit_normal == NULL) {
-        return result;
+    float face_depth = fminf(tri_depth, box_depth);
+    float depths[OBB_TRIANGLE_MAX_CLIP_POINTS];
+    int count = 0;
+
+    if (edge_box < 0 || edge_depth >= OBB_TRIANGLE_FACE_TOLERANCE * face_depth - OBB_TRIANGLE_LINEAR_SLOP) {
+        if (box_depth < OBB_TRIANGLE_FACE_TOLERANCE * tri_depth - OBB_TRIANGLE_LINEAR_SLOP) {
+            *out_normal = vec3_scale(u[box_axis], box_sign);
+            *out_depth = box_depth;
+            count = obb_face_triangle_contacts(A, u, box_axis, box_sign, B, out_points, depths);
+        }
+        else {
+            *out_normal = vec3_scale(n, -1.0f);
+            *out_depth = tri_depth;
+            count = obb_triangle_face_contacts(A, u, B, n, out_points, depths);
+        }
+        if (count > 0) {
+            *out_count = reduce_contacts(out_points, depths, count, *out_normal);
+            return true;
+        }
     }
-    vec3 axis = vec3_normalized(*hit_normal);
 
-    /* Clip edges */
-    Line3D edges_b[12], edges_a[12];
-    obb_get_edges(B, edges_b);
-    obb_get_edges(A, edges_a);
+    if (edge_box >= 0) {
+        /* Box edge parallel to u[edge_box] on the side the axis points to */
+        Point3D corner = A.position;
+        for (int k = 0; k < 3; ++k) {
+            if (k != edge_box) {
+                float extent = vec3_dot(u[k], edge_axis) > 0.0f ? A.size.v[k] : -A.size.v[k];
+                corner = vec3_add(corner, vec3_scale(u[k], extent));
+            }
+        }
+        vec3 half = vec3_scale(u[edge_box], A.size.v[edge_box]);
+        Line3D box_edge = line3d_create(vec3_sub(corner, half), vec3_add(corner, half));
+        Line3D tri_edge = line3d_create(B.points[edge_tri], B.points[(edge_tri + 1) % 3]);
+        Point3D pa, pb;
+        closest_points_line3d_line3d(box_edge, tri_edge, &pa, &pb);
+
+        *out_normal = edge_axis;
+        *out_depth = edge_depth;
+        out_points[0] = vec3_scale(vec3_add(pa, pb), 0.5f);
+        *out_count = 1;
+        return true;
+    }
 
-    Point3D clip_buffer[72];  /* 12 edges * 6 planes max */
-    int c1_count = clip_edges_to_obb(edges_b, 12, A, clip_buffer, 36);
-    int c2_count = clip_edges_to_obb(edges_a, 12, B, clip_buffer + c1_count, 36);
+    /* Clipping lost every point to round-off: use the deepest box vertex */
+    Point3D deepest = support_obb(&A, *out_normal);
+    out_points[0] = vec3_sub(deepest, vec3_scale(*out_normal, *out_depth * 0.5f));
+    *out_count = 1;
+    return true;
+}
+
+/*******************************************************************************
+ * Collision Manifold Functions
+ ******************************************************************************/
 
-    contact_array_reserve(&result.contacts, c1_count + c2_count);
-    for (int i = 0; i < c1_count + c2_count; ++i) {
-        contact_array_push(&result.contacts, clip_buffer[i]);
+CollisionManifold find_collision_features_sphere_sphere(Sphere A, Sphere B) {
+    CollisionManifold result;
+    collision_manifold_init(&result);
+
+    Point3D contact;
+    if (sphere_sphere_features(A, B, &result.normal, &result.depth, &contact)) {
+        result.colliding = true;
+        contact_array_push(&result.contacts, contact);
     }
+    return result;
+}
 
-    Interval3D interval = interval3d_from_obb(A, axis);
-    float distance = (interval.max - interval.min) * 0.5f - result.depth * 0.5f;
-    vec3 point_on_plane = vec3_add(A.position, vec3_scale(axis, distance));
+CollisionManifold find_collision_features_obb_sphere(OBB A, Sphere B) {
+    CollisionManifold result;
+    collision_manifold_init(&result);
 
-    /* Project contacts onto collision plane and remove duplicates */
-    for (int i = result.contacts.count - 1; i >= 0; --i) {
-        vec3 contact = result.contacts.data[i];
-        result.contacts.data[i] = vec3_add(contact, 
-            vec3_scale(axis, vec3_dot(axis, vec3_sub(point_on_plane, contact))));
+    Point3D contact;
+    if (obb_sphere_features(A, B, &result.normal, &result.depth, &contact)) {
+        result.colliding = true;
+        contact_array_push(&result.contacts, contact);
+    }
+    return result;
+}
 
-        for (int j = result.contacts.count - 1; j > i; --j) {
-            if (vec3_magnitude_sq(vec3_sub(result.contacts.data[j], result.contacts.data[i])) < 0.0001f) {
-                contact_array_erase(&result.contacts, j);
-                break;
+CollisionManifold find_collision_features_obb_obb(OBB A, OBB B) {
+    CollisionManifold result;
+    collision_manifold_init(&result);
+
+    Point3D points[OBB_OBB_MAX_CLIP_POINTS];
+    int count;
+    if (obb_obb_features(A, B, &result.normal, &result.depth, points, &count)) {
+        result.colliding = true;
+        contact_array_reserve(&result.contacts, count);
+        for (int i = 0; i < count; ++i) {
+            contact_array_push(&result.contacts, points[i]);
+        }
+    }
+    return result;
+}
+
+/*
+ * Every capsule pair has a heap and a _fixed form; both run the generator
+ * into a CapsuleFeatures and hand it here with the manifold to fill, heap
+ * or fixed (the other NULL). Returns colliding.
+ */
+typedef struct CapsuleFeatures {
+    vec3    normal;
+    float   depth;
+    Point3D points[CAPSULE_MAX_CONTACTS];
+    int     count;
+} CapsuleFeatures;
+
+static bool capsule_manifold_emit(bool colliding, const CapsuleFeatures* f,
+                                  CollisionManifold* heap, FixedManifold* fixed) {
+    if (heap) {
+        collision_manifold_init(heap);
+        if (colliding) {
+            heap->colliding = true;
+            heap->normal = f->normal;
+            heap->depth = f->depth;
+            contact_array_reserve(&heap->contacts, f->count);
+            for (int i = 0; i < f->count; ++i) {
+                contact_array_push(&heap->contacts, f->points[i]);
             }
         }
+    } else {
+        fixed_manifold_init(fixed);
+        if (colliding) {
+            fixed->colliding = true;
+            fixed->normal = f->normal;
+            fixed->depth = f->depth;
+            for (int i = 0; i < f->count; ++i) {
+                fixed_contact_array_push(&fixed->contacts, f->points[i]);
+            }
+        }
+    }
+    return colliding;
+}
+
+CollisionManifold find_collision_features_capsule_sphere(Capsule A, Sphere B) {
+    CapsuleFeatures f;
+    CollisionManifold result;
+    capsule_manifold_emit(capsule_sphere_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, &result, NULL);
+    return result;
+}
+
+CollisionManifold find_collision_features_capsule_capsule(Capsule A, Capsule B) {
+    CapsuleFeatures f;
+    CollisionManifold result;
+    capsule_manifold_emit(capsule_capsule_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, &result, NULL);
+    return result;
+}
+
+CollisionManifold find_collision_features_capsule_obb(Capsule A, OBB B) {
+    CapsuleFeatures f;
+    CollisionManifold result;
+    capsule_manifold_emit(capsule_obb_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, &result, NULL);
+    return result;
+}
+
+CollisionManifold find_collision_features_capsule_plane(Capsule A, Plane B) {
+    CapsuleFeatures f;
+    CollisionManifold result;
+    capsule_manifold_emit(capsule_plane_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, &result, NULL);
+    return result;
+}
+
+CollisionManifold find_collision_features_capsule_triangle(Capsule A, Triangle B) {
+    CapsuleFeatures f;
+    CollisionManifold result;
+    capsule_manifold_emit(capsule_triangle_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, &result, NULL);
+    return result;
+}
+
+CollisionManifold find_collision_features_sphere_triangle(Sphere A, Triangle B) {
+    CollisionManifold result;
+    collision_manifold_init(&result);
+
+    Point3D contact;
+    if (sphere_triangle_features(A, B, &result.normal, &result.depth, &contact)) {
+        result.colliding = true;
+        contact_array_push(&result.contacts, contact);
     }
+    return result;
+}
 
-    result.colliding = true;
-    result.normal = axis;
+CollisionManifold find_collision_features_obb_triangle(OBB A, Triangle B) {
+    CollisionManifold result;
+    collision_manifold_init(&result);
 
+    Point3D points[OBB_TRIANGLE_MAX_CLIP_POINTS];
+    int count;
+    if (obb_triangle_features(A, B, &result.normal, &result.depth, points, &count)) {
+        result.colliding = true;
+        for (int i = 0; i < count; ++i) {
+            contact_array_push(&result.contacts, points[i]);
+        }
+    }
     return result;
-}
\ No newline at end of file
+}
+
+CollisionManifold find_collision_features_capsule_aabb(Capsule A, AABB B) {
+    return find_collision_features_capsule_obb(A, obb_create_simple(B.position, B.size));
+}
+
+/*******************************************************************************
+ * Fixed Manifold Functions (no heap allocation)
+ ******************************************************************************/
+
+bool find_collision_features_sphere_sphere_fixed(Sphere A, Sphere B, FixedManifold* out) {
+    fixed_manifold_init(out);
+
+    Point3D contact;
+    if (sphere_sphere_features(A, B, &out->normal, &out->depth, &contact)) {
+        out->colliding = true;
+        fixed_contact_array_push(&out->contacts, contact);
+    }
+    return out->colliding;
+}
+
+bool find_collision_features_obb_sphere_fixed(OBB A, Sphere B, FixedManifold* out) {
+    fixed_manifold_init(out);
+
+    Point3D contact;
+    if (obb_sphere_features(A, B, &out->normal, &out->depth, &contact)) {
+        out->colliding = true;
+        fixed_contact_array_push(&out->contacts, contact);
+    }
+    return out->colliding;
+}
+
+bool find_collision_features_obb_obb_fixed(OBB A, OBB B, FixedManifold* out) {
+    fixed_manifold_init(out);
+
+    Point3D points[OBB_OBB_MAX_CLIP_POINTS];
+    int count;
+    if (obb_obb_features(A, B, &out->normal, &out->depth, points, &count)) {
+        out->colliding = true;
+        for (int i = 0; i < count; ++i) {
+            fixed_contact_array_push(&out->contacts, points[i]);
+        }
+    }
+    return out->colliding;
+}
+
+bool find_collision_features_capsule_sphere_fixed(Capsule A, Sphere B, FixedManifold* out) {
+    CapsuleFeatures f;
+    return capsule_manifold_emit(capsule_sphere_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, NULL, out);
+}
+
+bool find_collision_features_capsule_capsule_fixed(Capsule A, Capsule B, FixedManifold* out) {
+    CapsuleFeatures f;
+    return capsule_manifold_emit(capsule_capsule_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, NULL, out);
+}
+
+bool find_collision_features_capsule_obb_fixed(Capsule A, OBB B, FixedManifold* out) {
+    CapsuleFeatures f;
+    return capsule_manifold_emit(capsule_obb_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, NULL, out);
+}
+
+bool find_collision_features_capsule_plane_fixed(Capsule A, Plane B, FixedManifold* out) {
+    CapsuleFeatures f;
+    return capsule_manifold_emit(capsule_plane_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, NULL, out);
+}
+
+bool find_collision_features_capsule_triangle_fixed(Capsule A, Triangle B, FixedManifold* out) {
+    CapsuleFeatures f;
+    return capsule_manifold_emit(capsule_triangle_features(A, B, &f.normal, &f.depth, f.points, &f.count), &f, NULL, out);
+}
+
+bool find_collision_features_sphere_triangle_fixed(Sphere A, Triangle B, FixedManifold* out) {
+    fixed_manifold_init(out);
+
+    Point3D contact;
+    if (sphere_triangle_features(A, B, &out->normal, &out->depth, &contact)) {
+        out->colliding = true;
+        fixed_contact_array_push(&out->contacts, contact);
+    }
+    return out->colliding;
+}
+
+bool find_collision_features_obb_triangle_fixed(OBB A, Triangle B, FixedManifold* out) {
+    fixed_manifold_init(out);
+
+    Point3D points[OBB_TRIANGLE_MAX_CLIP_POINTS];
+    int count;
+    if (obb_triangle_features(A, B, &out->normal, &out->depth, points, &count)) {
+        out->colliding = true;
+        for (int i = 0; i < count; ++i) {
+            fixed_contact_array_push(&out->contacts, points[i]);
+        }
+    }
+    return out->colliding;
+}
+
+bool find_collision_features_capsule_aabb_fixed(Capsule A, AABB B, FixedManifold* out) {
+    return find_collision_features_capsule_obb_fixed(A, obb_create_simple(B.position, B.size), out);
+}
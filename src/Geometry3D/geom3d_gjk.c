@@ -0,0 +1,721 @@
+/**
+ * @file geom3d_gjk.c
+ * @brief GJK distance / overlap and EPA penetration over support functions
+ */
+#include "geom3d_gjk.h"
+#include "geom3d_arrays.h"
+
+#include <math.h>
+#include <float.h>
+
+#define GJK_MAX_ITERATIONS  64
+#define GJK_TOLERANCE       1.0e-5f     /* Relative convergence on |v|^2 */
+#define GJK_EPSILON_SQ      1.0e-12f    /* |v|^2 below this counts as touching */
+
+#define EPA_MAX_ITERATIONS  64
+#define EPA_MAX_VERTICES    (EPA_MAX_ITERATIONS + 4)
+#define EPA_MAX_FACES       (2 * EPA_MAX_VERTICES)
+#define EPA_TOLERANCE       1.0e-4f
+
+/*******************************************************************************
+ * Support Functions
+ ******************************************************************************/
+
+vec3 support_sphere(const void* shape, vec3 direction) {
+    (void)direction;
+    return ((const Sphere*)shape)->position;
+}
+
+vec3 support_capsule(const void* shape, vec3 direction) {
+    const Capsule* capsule = (const Capsule*)shape;
+    return vec3_dot(capsule->start, direction) > vec3_dot(capsule->end, direction)
+        ? capsule->start : capsule->end;
+}
+
+vec3 support_obb(const void* shape, vec3 direction) {
+    const OBB* obb = (const OBB*)shape;
+    vec3 result = obb->position;
+
+    for (int i = 0; i < 3; ++i) {
+        vec3 axis = vec3_make(obb->orientation.m[i][0], obb->orientation.m[i][1], obb->orientation.m[i][2]);
+        float extent = vec3_dot(axis, direction) >= 0.0f ? obb->size.v[i] : -obb->size.v[i];
+        result = vec3_add(result, vec3_scale(axis, extent));
+    }
+    return result;
+}
+
+vec3 support_aabb(const void* shape, vec3 direction) {
+    const AABB* aabb = (const AABB*)shape;
+    return vec3_make(
+        aabb->position.x + (direction.x >= 0.0f ? aabb->size.x : -aabb->size.x),
+        aabb->position.y + (direction.y >= 0.0f ? aabb->size.y : -aabb->size.y),
+        aabb->position.z + (direction.z >= 0.0f ? aabb->size.z : -aabb->size.z)
+    );
+}
+
+vec3 support_triangle(const void* shape, vec3 direction) {
+    const Triangle* t = (const Triangle*)shape;
+    int best = 0;
+    float best_dot = vec3_dot(t->points[0], direction);
+
+    for (int i = 1; i < 3; ++i) {
+        float d = vec3_dot(t->points[i], direction);
+        if (d > best_dot) {
+            best_dot = d;
+            best = i;
+        }
+    }
+    return t->points[best];
+}
+
+vec3 support_convex_points(const void* shape, vec3 direction) {
+    const ConvexPoints* hull = (const ConvexPoints*)shape;
+    int best = 0;
+    float best_dot = vec3_dot(hull->points[0], direction);
+
+    for (int i = 1; i < hull->count; ++i) {
+        float d = vec3_dot(hull->points[i], direction);
+        if (d > best_dot) {
+            best_dot = d;
+            best = i;
+        }
+    }
+    return hull->points[best];
+}
+
+/*******************************************************************************
+ * Simplex
+ ******************************************************************************/
+
+typedef struct SimplexVertex {
+    vec3 w;     /* a - b, a point of the Minkowski difference */
+    vec3 a;     /* Support point on A */
+    vec3 b;     /* Support point on B */
+    vec3 d;     /* Search direction that produced this vertex */
+} SimplexVertex;
+
+typedef struct Simplex {
+    SimplexVertex v[4];
+    float         lambda[4];    /* Barycentric weights of the closest point */
+    int           count;
+} Simplex;
+
+static SimplexVertex support_pair(const ConvexShape* a, const ConvexShape* b,
+                                  vec3 d, bool with_margin) {
+    SimplexVertex sv;
+    sv.a = a->support(a->data, d);
+    sv.b = b->support(b->data, vec3_scale(d, -1.0f));
+    sv.d = d;
+
+    if (with_margin) {
+        float len_sq = vec3_magnitude_sq(d);
+        if (len_sq > GJK_EPSILON_SQ) {
+            vec3 n = vec3_scale(d, 1.0f / sqrtf(len_sq));
+            sv.a = vec3_add(sv.a, vec3_scale(n, a->margin));
+            sv.b = vec3_sub(sv.b, vec3_scale(n, b->margin));
+        }
+    }
+
+    sv.w = vec3_sub(sv.a, sv.b);
+    return sv;
+}
+
+static float safe_ratio(float num, float den) {
+    return den > 0.0f ? num / den : 0.0f;
+}
+
+static void simplex_set1(Simplex* s, SimplexVertex a) {
+    s->v[0] = a;
+    s->lambda[0] = 1.0f;
+    s->count = 1;
+}
+
+static void simplex_set2(Simplex* s, SimplexVertex a, SimplexVertex b, float t) {
+    s->v[0] = a;
+    s->v[1] = b;
+    s->lambda[0] = 1.0f - t;
+    s->lambda[1] = t;
+    s->count = 2;
+}
+
+static vec3 simplex_point(const Simplex* s) {
+    vec3 p = vec3_make(0, 0, 0);
+    for (int i = 0; i < s->count; ++i) {
+        p = vec3_add(p, vec3_scale(s->v[i].w, s->lambda[i]));
+    }
+    return p;
+}
+
+static void simplex_witness(const Simplex* s, vec3* out_a, vec3* out_b) {
+    vec3 pa = vec3_make(0, 0, 0);
+    vec3 pb = vec3_make(0, 0, 0);
+    for (int i = 0; i < s->count; ++i) {
+        pa = vec3_add(pa, vec3_scale(s->v[i].a, s->lambda[i]));
+        pb = vec3_add(pb, vec3_scale(s->v[i].b, s->lambda[i]));
+    }
+    *out_a = pa;
+    *out_b = pb;
+}
+
+static void closest_segment(Simplex* s) {
+    SimplexVertex A = s->v[0];
+    SimplexVertex B = s->v[1];
+    vec3 ab = vec3_sub(B.w, A.w);
+    float t = safe_ratio(-vec3_dot(A.w, ab), vec3_dot(ab, ab));
+
+    if (t <= 0.0f) {
+        simplex_set1(s, A);
+    }
+    else if (t >= 1.0f) {
+        simplex_set1(s, B);
+    }
+    else {
+        simplex_set2(s, A, B, t);
+    }
+}
+
+/* Closest point on triangle to the origin (Ericson, RTCD 5.1.5) */
+static void closest_triangle(Simplex* s) {
+    SimplexVertex A = s->v[0];
+    SimplexVertex B = s->v[1];
+    SimplexVertex C = s->v[2];
+
+    vec3 ab = vec3_sub(B.w, A.w);
+    vec3 ac = vec3_sub(C.w, A.w);
+
+    vec3 ap = vec3_scale(A.w, -1.0f);
+    float d1 = vec3_dot(ab, ap);
+    float d2 = vec3_dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        simplex_set1(s, A);
+        return;
+    }
+
+    vec3 bp = vec3_scale(B.w, -1.0f);
+    float d3 = vec3_dot(ab, bp);
+    float d4 = vec3_dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        simplex_set1(s, B);
+        return;
+    }
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        simplex_set2(s, A, B, safe_ratio(d1, d1 - d3));
+        return;
+    }
+
+    vec3 cp = vec3_scale(C.w, -1.0f);
+    float d5 = vec3_dot(ab, cp);
+    float d6 = vec3_dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        simplex_set1(s, C);
+        return;
+    }
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        simplex_set2(s, A, C, safe_ratio(d2, d2 - d6));
+        return;
+    }
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        simplex_set2(s, B, C, safe_ratio(d4 - d3, (d4 - d3) + (d5 - d6)));
+        return;
+    }
+
+    float sum = va + vb + vc;
+    if (sum <= 0.0f) {
+        /* Degenerate (collinear) triangle */
+        s->count = 2;
+        closest_segment(s);
+        return;
+    }
+
+    float v = vb / sum;
+    float w = vc / sum;
+    s->lambda[0] = 1.0f - v - w;
+    s->lambda[1] = v;
+    s->lambda[2] = w;
+    s->count = 3;
+}
+
+/* True when the origin and d lie on opposite sides of plane abc */
+static bool origin_outside_plane(vec3 a, vec3 b, vec3 c, vec3 d) {
+    vec3 n = vec3_cross(vec3_sub(b, a), vec3_sub(c, a));
+    float sign_p = -vec3_dot(a, n);
+    float sign_d = vec3_dot(vec3_sub(d, a), n);
+    return sign_d == 0.0f || sign_p * sign_d < 0.0f;
+}
+
+/* Returns true when the origin is inside the tetrahedron */
+static bool closest_tetrahedron(Simplex* s) {
+    static const int faces[4][4] = {
+        {0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}
+    };
+
+    Simplex best = *s;
+    float best_dist = FLT_MAX;
+    bool outside_any = false;
+
+    /*
+     * A new vertex landing in the plane of the closest face gives a flat
+     * tetrahedron whose face signs are noise; never report enclosure then.
+     */
+    vec3 ab = vec3_sub(s->v[1].w, s->v[0].w);
+    vec3 ac = vec3_sub(s->v[2].w, s->v[0].w);
+    vec3 ad = vec3_sub(s->v[3].w, s->v[0].w);
+    float volume = fabsf(vec3_dot(ab, vec3_cross(ac, ad)));
+    bool flat = volume <= GJK_TOLERANCE * vec3_magnitude(ab) * vec3_magnitude(ac) * vec3_magnitude(ad);
+
+    for (int f = 0; f < 4; ++f) {
+        const int* idx = faces[f];
+        if (!flat && !origin_outside_plane(s->v[idx[0]].w, s->v[idx[1]].w, s->v[idx[2]].w, s->v[idx[3]].w)) {
+            continue;
+        }
+
+        Simplex face = { .v = { s->v[idx[0]], s->v[idx[1]], s->v[idx[2]] }, .count = 3 };
+        closest_triangle(&face);
+
+        /* The first face outside always counts, so a NaN distance cannot leave best unset */
+        float dist = vec3_magnitude_sq(simplex_point(&face));
+        if (!outside_any || dist < best_dist) {
+            best_dist = dist;
+            best = face;
+        }
+        outside_any = true;
+    }
+
+    if (!outside_any) {
+        for (int i = 0; i < 4; ++i) {
+            s->lambda[i] = 0.25f;
+        }
+        return true;
+    }
+
+    *s = best;
+    return false;
+}
+
+static bool simplex_contains(const Simplex* s, vec3 w) {
+    for (int i = 0; i < s->count; ++i) {
+        if (vec3_magnitude_sq(vec3_sub(s->v[i].w, w)) < GJK_EPSILON_SQ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Reduces the simplex to the feature closest to the origin; true if enclosed */
+static bool simplex_reduce(Simplex* s) {
+    switch (s->count) {
+        case 2: closest_segment(s); break;
+        case 3: closest_triangle(s); break;
+        case 4: return closest_tetrahedron(s);
+        default: break;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ * GJK
+ ******************************************************************************/
+
+/*
+ * Runs GJK on A - B. Returns true when the origin is enclosed (or touching).
+ * With separation_bound >= 0 the run stops as soon as the distance is proven
+ * larger than the bound. out_v receives the closest point of A - B.
+ */
+static bool gjk_run(const ConvexShape* a, const ConvexShape* b, GJKCache* cache,
+                    bool with_margin, float separation_bound,
+                    Simplex* s, vec3* out_v, int* out_iterations) {
+    s->count = 0;
+
+    if (cache != NULL) {
+        for (int i = 0; i < cache->count; ++i) {
+            SimplexVertex sv = support_pair(a, b, cache->directions[i], with_margin);
+            if (!simplex_contains(s, sv.w)) {
+                s->v[s->count] = sv;
+                s->lambda[s->count] = 0.0f;
+                s->count++;
+            }
+        }
+    }
+
+    bool enclosed = false;
+    if (s->count == 0) {
+        simplex_set1(s, support_pair(a, b, vec3_make(1, 0, 0), with_margin));
+    }
+    else {
+        enclosed = simplex_reduce(s);
+        if (s->count == 1) {
+            s->lambda[0] = 1.0f;
+        }
+    }
+
+    vec3 v = simplex_point(s);
+    int iterations = 0;
+
+    while (!enclosed && iterations < GJK_MAX_ITERATIONS) {
+        ++iterations;
+
+        float v_sq = vec3_magnitude_sq(v);
+        if (v_sq < GJK_EPSILON_SQ) {
+            enclosed = true;
+            break;
+        }
+
+        SimplexVertex w = support_pair(a, b, vec3_scale(v, -1.0f), with_margin);
+        float vw = vec3_dot(v, w.w);
+
+        if (separation_bound >= 0.0f && vw > 0.0f &&
+            vw * vw > v_sq * separation_bound * separation_bound) {
+            break;
+        }
+        if (v_sq - vw <= GJK_TOLERANCE * v_sq || simplex_contains(s, w.w)) {
+            break;
+        }
+
+        s->v[s->count] = w;
+        s->lambda[s->count] = 0.0f;
+        s->count++;
+        enclosed = simplex_reduce(s);
+
+        vec3 next = simplex_point(s);
+        if (!enclosed && vec3_magnitude_sq(next) >= v_sq) {
+            break;  /* No progress, numerical floor reached */
+        }
+        v = next;
+    }
+
+    if (cache != NULL) {
+        cache->count = s->count;
+        for (int i = 0; i < s->count; ++i) {
+            cache->directions[i] = s->v[i].d;
+        }
+    }
+
+    *out_v = v;
+    if (out_iterations != NULL) {
+        *out_iterations = iterations;
+    }
+    return enclosed;
+}
+
+bool gjk_intersect(ConvexShape a, ConvexShape b, GJKCache* cache) {
+    Simplex s;
+    vec3 v;
+    float margin = a.margin + b.margin;
+
+    if (gjk_run(&a, &b, cache, false, margin, &s, &v, NULL)) {
+        return true;
+    }
+    return vec3_magnitude_sq(v) <= margin * margin;
+}
+
+/*******************************************************************************
+ * EPA
+ ******************************************************************************/
+
+typedef struct EPAFace {
+    int   i[3];
+    vec3  normal;
+    float distance;
+} EPAFace;
+
+typedef struct EPAEdge {
+    int a;
+    int b;
+} EPAEdge;
+
+typedef struct EPAPolytope {
+    SimplexVertex vertices[EPA_MAX_VERTICES];
+    EPAFace       faces[EPA_MAX_FACES];
+    int           num_vertices;
+    int           num_faces;
+} EPAPolytope;
+
+static bool epa_add_face(EPAPolytope* p, int i0, int i1, int i2) {
+    if (p->num_faces >= EPA_MAX_FACES) {
+        return false;
+    }
+
+    vec3 a = p->vertices[i0].w;
+    vec3 n = vec3_cross(vec3_sub(p->vertices[i1].w, a), vec3_sub(p->vertices[i2].w, a));
+    float len = vec3_magnitude(n);
+
+    EPAFace* face = &p->faces[p->num_faces++];
+    face->i[0] = i0;
+    face->i[1] = i1;
+    face->i[2] = i2;
+
+    if (len > 0.0f) {
+        face->normal = vec3_scale(n, 1.0f / len);
+        face->distance = vec3_dot(face->normal, a);
+    }
+    else {
+        face->normal = vec3_make(0, 0, 0);
+        face->distance = FLT_MAX;
+    }
+    return true;
+}
+
+/* Adds horizon edge a->b, or cancels it against an existing b->a */
+static void epa_add_edge(EPAEdge* edges, int* count, int a, int b) {
+    for (int i = 0; i < *count; ++i) {
+        if (edges[i].a == b && edges[i].b == a) {
+            edges[i] = edges[--(*count)];
+            return;
+        }
+    }
+    if (*count < EPA_MAX_FACES) {
+        edges[*count].a = a;
+        edges[*count].b = b;
+        (*count)++;
+    }
+}
+
+/* Grows a degenerate GJK simplex that touches the origin into a tetrahedron */
+static bool epa_expand_simplex(const ConvexShape* a, const ConvexShape* b, Simplex* s) {
+    static const vec3 axes[6] = {
+        {{{1, 0, 0}}}, {{{-1, 0, 0}}}, {{{0, 1, 0}}},
+        {{{0, -1, 0}}}, {{{0, 0, 1}}}, {{{0, 0, -1}}}
+    };
+
+    if (s->count == 1) {
+        for (int i = 0; i < 6 && s->count == 1; ++i) {
+            SimplexVertex sv = support_pair(a, b, axes[i], true);
+            if (!simplex_contains(s, sv.w)) {
+                s->v[s->count++] = sv;
+            }
+        }
+    }
+
+    if (s->count == 2) {
+        vec3 ab = vec3_sub(s->v[1].w, s->v[0].w);
+        vec3 axis = fabsf(ab.x) < fabsf(ab.y)
+            ? (fabsf(ab.x) < fabsf(ab.z) ? axes[0] : axes[4])
+            : (fabsf(ab.y) < fabsf(ab.z) ? axes[2] : axes[4]);
+        vec3 perp1 = vec3_cross(ab, axis);
+        vec3 perp2 = vec3_cross(ab, perp1);
+        vec3 dirs[4] = { perp1, vec3_scale(perp1, -1.0f), perp2, vec3_scale(perp2, -1.0f) };
+
+        for (int i = 0; i < 4 && s->count == 2; ++i) {
+            SimplexVertex sv = support_pair(a, b, dirs[i], true);
+            vec3 n = vec3_cross(ab, vec3_sub(sv.w, s->v[0].w));
+            if (vec3_magnitude_sq(n) > GJK_EPSILON_SQ) {
+                s->v[s->count++] = sv;
+            }
+        }
+    }
+
+    if (s->count == 3) {
+        vec3 n = vec3_cross(vec3_sub(s->v[1].w, s->v[0].w), vec3_sub(s->v[2].w, s->v[0].w));
+        vec3 dirs[2] = { n, vec3_scale(n, -1.0f) };
+
+        for (int i = 0; i < 2 && s->count == 3; ++i) {
+            SimplexVertex sv = support_pair(a, b, dirs[i], true);
+            float height = vec3_dot(vec3_sub(sv.w, s->v[0].w), n);
+            if (height * height > GJK_EPSILON_SQ * vec3_magnitude_sq(n)) {
+                s->v[s->count++] = sv;
+            }
+        }
+    }
+
+    return s->count == 4;
+}
+
+static bool epa_run(const ConvexShape* a, const ConvexShape* b, const Simplex* s,
+                    GJKResult* out_result) {
+    EPAPolytope p;
+    p.num_vertices = 4;
+    p.num_faces = 0;
+    for (int i = 0; i < 4; ++i) {
+        p.vertices[i] = s->v[i];
+    }
+
+    /* Initial tetrahedron, wound so that every normal points outwards */
+    static const int tetra[4][4] = {
+        {0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}
+    };
+    for (int f = 0; f < 4; ++f) {
+        int i0 = tetra[f][0], i1 = tetra[f][1], i2 = tetra[f][2], opposite = tetra[f][3];
+        vec3 n = vec3_cross(vec3_sub(p.vertices[i1].w, p.vertices[i0].w),
+                            vec3_sub(p.vertices[i2].w, p.vertices[i0].w));
+        if (vec3_dot(n, vec3_sub(p.vertices[opposite].w, p.vertices[i0].w)) > 0.0f) {
+            int tmp = i1;
+            i1 = i2;
+            i2 = tmp;
+        }
+        epa_add_face(&p, i0, i1, i2);
+    }
+
+    EPAEdge edges[EPA_MAX_FACES];
+    int closest = 0;
+    int iterations = 0;
+
+    for (; iterations < EPA_MAX_ITERATIONS; ++iterations) {
+        closest = 0;
+        for (int f = 1; f < p.num_faces; ++f) {
+            if (p.faces[f].distance < p.faces[closest].distance) {
+                closest = f;
+            }
+        }
+
+        EPAFace face = p.faces[closest];
+        SimplexVertex w = support_pair(a, b, face.normal, true);
+        if (vec3_dot(w.w, face.normal) - face.distance < EPA_TOLERANCE ||
+            p.num_vertices >= EPA_MAX_VERTICES) {
+            break;
+        }
+
+        int new_index = p.num_vertices++;
+        p.vertices[new_index] = w;
+
+        int num_edges = 0;
+        for (int f = p.num_faces - 1; f >= 0; --f) {
+            EPAFace* cur = &p.faces[f];
+            if (vec3_dot(cur->normal, vec3_sub(w.w, p.vertices[cur->i[0]].w)) > 0.0f) {
+                epa_add_edge(edges, &num_edges, cur->i[0], cur->i[1]);
+                epa_add_edge(edges, &num_edges, cur->i[1], cur->i[2]);
+                epa_add_edge(edges, &num_edges, cur->i[2], cur->i[0]);
+                p.faces[f] = p.faces[--p.num_faces];
+            }
+        }
+
+        bool full = false;
+        for (int e = 0; e < num_edges && !full; ++e) {
+            full = !epa_add_face(&p, edges[e].a, edges[e].b, new_index);
+        }
+        if (full || p.num_faces == 0) {
+            break;
+        }
+    }
+
+    if (p.num_faces == 0) {
+        return false;
+    }
+
+    closest = 0;
+    for (int f = 1; f < p.num_faces; ++f) {
+        if (p.faces[f].distance < p.faces[closest].distance) {
+            closest = f;
+        }
+    }
+    EPAFace face = p.faces[closest];
+
+    /* Barycentric coordinates of the origin's projection onto the face */
+    SimplexVertex A = p.vertices[face.i[0]];
+    SimplexVertex B = p.vertices[face.i[1]];
+    SimplexVertex C = p.vertices[face.i[2]];
+    vec3 proj = vec3_scale(face.normal, face.distance);
+    vec3 v0 = vec3_sub(B.w, A.w);
+    vec3 v1 = vec3_sub(C.w, A.w);
+    vec3 v2 = vec3_sub(proj, A.w);
+    float d00 = vec3_dot(v0, v0);
+    float d01 = vec3_dot(v0, v1);
+    float d11 = vec3_dot(v1, v1);
+    float d20 = vec3_dot(v2, v0);
+    float d21 = vec3_dot(v2, v1);
+    float denom = d00 * d11 - d01 * d01;
+
+    float v = 0.0f, w = 0.0f;
+    if (denom > 0.0f) {
+        v = (d11 * d20 - d01 * d21) / denom;
+        w = (d00 * d21 - d01 * d20) / denom;
+    }
+    float u = 1.0f - v - w;
+
+    out_result->point_a = vec3_add(vec3_add(vec3_scale(A.a, u), vec3_scale(B.a, v)), vec3_scale(C.a, w));
+    out_result->point_b = vec3_add(vec3_add(vec3_scale(A.b, u), vec3_scale(B.b, v)), vec3_scale(C.b, w));
+    out_result->normal = face.normal;
+    out_result->depth = fmaxf(face.distance, 0.0f);
+    out_result->iterations += iterations;
+    return true;
+}
+
+/*******************************************************************************
+ * Queries
+ ******************************************************************************/
+
+bool gjk_query(ConvexShape a, ConvexShape b, GJKCache* cache, GJKResult* out_result) {
+    GJKResult result;
+    result.intersecting = false;
+    result.distance = 0.0f;
+    result.depth = 0.0f;
+    result.normal = vec3_make(0, 0, 1);
+    result.point_a = vec3_make(0, 0, 0);
+    result.point_b = vec3_make(0, 0, 0);
+    result.iterations = 0;
+
+    Simplex s;
+    vec3 v;
+    bool cores_overlap = gjk_run(&a, &b, cache, false, -1.0f, &s, &v, &result.iterations);
+
+    if (!cores_overlap) {
+        vec3 pa, pb;
+        simplex_witness(&s, &pa, &pb);
+
+        float dist = vec3_magnitude(v);
+        float margin = a.margin + b.margin;
+        vec3 n = vec3_scale(v, -1.0f / dist);
+
+        result.normal = n;
+        result.point_a = vec3_add(pa, vec3_scale(n, a.margin));
+        result.point_b = vec3_sub(pb, vec3_scale(n, b.margin));
+
+        if (dist > margin) {
+            result.distance = dist - margin;
+        }
+        else {
+            /* Shallow contact: only the margins overlap, no EPA needed */
+            result.intersecting = true;
+            result.depth = margin - dist;
+        }
+    }
+    else {
+        result.intersecting = true;
+
+        /* Cores overlap: rebuild the simplex on the inflated shapes for EPA */
+        if (a.margin != 0.0f || b.margin != 0.0f) {
+            int extra = 0;
+            gjk_run(&a, &b, NULL, true, -1.0f, &s, &v, &extra);
+            result.iterations += extra;
+        }
+
+        if (s.count < 4 && !epa_expand_simplex(&a, &b, &s)) {
+            /* Flat Minkowski difference (e.g. coplanar triangles): touching */
+            if (s.count == 3) {
+                result.normal = vec3_normalized(vec3_cross(vec3_sub(s.v[1].w, s.v[0].w),
+                                                           vec3_sub(s.v[2].w, s.v[0].w)));
+            }
+            simplex_witness(&s, &result.point_a, &result.point_b);
+        }
+        else if (!epa_run(&a, &b, &s, &result)) {
+            simplex_witness(&s, &result.point_a, &result.point_b);
+        }
+    }
+
+    if (out_result != NULL) {
+        *out_result = result;
+    }
+    return result.intersecting;
+}
+
+bool find_collision_features_gjk(ConvexShape a, ConvexShape b, GJKCache* cache,
+                                 FixedManifold* out) {
+    fixed_manifold_init(out);
+
+    GJKResult result;
+    if (!gjk_query(a, b, cache, &result)) {
+        return false;
+    }
+
+    out->colliding = true;
+    out->normal = result.normal;
+    out->depth = result.depth;
+    fixed_contact_array_push(&out->contacts,
+        vec3_scale(vec3_add(result.point_a, result.point_b), 0.5f));
+    return true;
+}
@@ -0,0 +1,1126 @@
+/**
+ * @file geom3d_hull.c
+ * @brief Quickhull convex hull builder and convex hull collision
+ */
+#include "geom3d_hull.h"
+#include "geom3d_arrays.h"
+#include "geom3d_collision.h"
+#include "geom3d_queries.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#define HULL_COPLANAR_COS       0.9999f /* Triangles within ~0.8 deg of a face's seed merge... */
+#define HULL_COPLANAR_DISTANCE  1.0e-4f /* ...and within this fraction of the cloud size of its plane */
+#define HULL_MAX_CLIP_VERTICES  64
+#define HULL_FACE_TOLERANCE     0.98f   /* Relative bias towards face axes, and towards A */
+#define HULL_LINEAR_SLOP        0.001f
+
+/*******************************************************************************
+ * Quickhull
+ ******************************************************************************/
+
+typedef struct QHFace {
+    int   v[3];
+    int   neighbors[3];     /* Face across edge v[i] -> v[i + 1] */
+    vec3  normal;
+    float distance;
+    int   outside;          /* Head of the outside point list, -1 if empty */
+    bool  alive;
+    bool  visible;
+} QHFace;
+
+typedef struct QHHorizon {
+    int a;
+    int b;
+    int neighbor;           /* Non-visible face across a -> b */
+} QHHorizon;
+
+typedef struct QHBuilder {
+    const Point3D* points;
+    int            num_points;
+    int*           point_next;  /* Outside list links */
+    QHFace*        faces;
+    int            num_faces;
+    int            capacity;
+    int*           stack;       /* capacity entries */
+    QHHorizon*     horizon;     /* 3 * capacity entries */
+    int            num_horizon;
+    float          epsilon;
+    float          merge_distance;
+} QHBuilder;
+
+static float qh_distance(const QHBuilder* b, int face, Point3D p) {
+    return vec3_dot(b->faces[face].normal, p) - b->faces[face].distance;
+}
+
+static int qh_add_face(QHBuilder* b, int i0, int i1, int i2) {
+    if (b->num_faces == b->capacity) {
+        b->capacity = b->capacity > 0 ? b->capacity * 2 : 64;
+        b->faces = realloc(b->faces, (size_t)b->capacity * sizeof(QHFace));
+        b->stack = realloc(b->stack, (size_t)b->capacity * sizeof(int));
+        b->horizon = realloc(b->horizon, (size_t)b->capacity * 3 * sizeof(QHHorizon));
+    }
+
+    QHFace* f = &b->faces[b->num_faces];
+    Point3D p0 = b->points[i0];
+    vec3 n = vec3_cross(vec3_sub(b->points[i1], p0), vec3_sub(b->points[i2], p0));
+    float len = vec3_magnitude(n);
+
+    f->v[0] = i0;
+    f->v[1] = i1;
+    f->v[2] = i2;
+    f->neighbors[0] = f->neighbors[1] = f->neighbors[2] = -1;
+    f->normal = len > FLT_MIN ? vec3_scale(n, 1.0f / len) : vec3_make(0, 0, 0);
+    f->distance = vec3_dot(f->normal, p0);
+    f->outside = -1;
+    f->alive = true;
+    f->visible = false;
+    return b->num_faces++;
+}
+
+/* Files p under the face in [first, last) it is farthest above, if any */
+static void qh_assign_point(QHBuilder* b, int p, int first, int last) {
+    int best = -1;
+    float best_distance = b->epsilon;
+
+    for (int f = first; f < last; ++f) {
+        if (!b->faces[f].alive) {
+            continue;
+        }
+        float d = qh_distance(b, f, b->points[p]);
+        if (d > best_distance) {
+            best_distance = d;
+            best = f;
+        }
+    }
+    if (best >= 0) {
+        b->point_next[p] = b->faces[best].outside;
+        b->faces[best].outside = p;
+    }
+}
+
+static int qh_edge_slot(const QHFace* f, int a, int b) {
+    for (int k = 0; k < 3; ++k) {
+        if (f->v[k] == a && f->v[(k + 1) % 3] == b) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+static bool qh_init_simplex(QHBuilder* b) {
+    const Point3D* pts = b->points;
+    int n = b->num_points;
+    int extremes[6] = {0, 0, 0, 0, 0, 0};
+    vec3 max_abs = vec3_make(0, 0, 0);
+
+    for (int i = 0; i < n; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            if (pts[i].v[axis] < pts[extremes[axis * 2]].v[axis]) {
+                extremes[axis * 2] = i;
+            }
+            if (pts[i].v[axis] > pts[extremes[axis * 2 + 1]].v[axis]) {
+                extremes[axis * 2 + 1] = i;
+            }
+            max_abs.v[axis] = fmaxf(max_abs.v[axis], fabsf(pts[i].v[axis]));
+        }
+    }
+    b->epsilon = 3.0f * FLT_EPSILON * (max_abs.x + max_abs.y + max_abs.z);
+    b->merge_distance = HULL_COPLANAR_DISTANCE * (max_abs.x + max_abs.y + max_abs.z);
+
+    /* Most distant pair of axis extremes */
+    int i0 = 0, i1 = 0;
+    float best = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        float extent = pts[extremes[axis * 2 + 1]].v[axis] - pts[extremes[axis * 2]].v[axis];
+        if (extent > best) {
+            best = extent;
+            i0 = extremes[axis * 2];
+            i1 = extremes[axis * 2 + 1];
+        }
+    }
+    if (best <= b->epsilon) {
+        return false;
+    }
+
+    /* Farthest from the line i0-i1 */
+    vec3 dir = vec3_sub(pts[i1], pts[i0]);
+    int i2 = -1;
+    best = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        float d = vec3_magnitude_sq(vec3_cross(vec3_sub(pts[i], pts[i0]), dir));
+        if (d > best) {
+            best = d;
+            i2 = i;
+        }
+    }
+    if (i2 < 0 || sqrtf(best) / vec3_magnitude(dir) <= b->epsilon) {
+        return false;
+    }
+
+    /* Farthest from the plane i0-i1-i2 */
+    vec3 normal = vec3_normalized(vec3_cross(dir, vec3_sub(pts[i2], pts[i0])));
+    int i3 = -1;
+    best = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        float d = fabsf(vec3_dot(normal, vec3_sub(pts[i], pts[i0])));
+        if (d > best) {
+            best = d;
+            i3 = i;
+        }
+    }
+    if (i3 < 0 || best <= b->epsilon) {
+        return false;
+    }
+
+    /* Wind (i0, i1, i2) away from i3, then the other three faces follow */
+    if (vec3_dot(normal, vec3_sub(pts[i3], pts[i0])) > 0.0f) {
+        int t = i1;
+        i1 = i2;
+        i2 = t;
+    }
+    int f0 = qh_add_face(b, i0, i1, i2);
+    int f1 = qh_add_face(b, i0, i3, i1);
+    int f2 = qh_add_face(b, i1, i3, i2);
+    int f3 = qh_add_face(b, i2, i3, i0);
+
+    const int tris[4] = {f0, f1, f2, f3};
+    for (int t = 0; t < 4; ++t) {
+        QHFace* f = &b->faces[tris[t]];
+        for (int k = 0; k < 3; ++k) {
+            int a = f->v[k];
+            int c = f->v[(k + 1) % 3];
+            for (int o = 0; o < 4; ++o) {
+                if (o != t && qh_edge_slot(&b->faces[tris[o]], c, a) >= 0) {
+                    f->neighbors[k] = tris[o];
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (i != i0 && i != i1 && i != i2 && i != i3) {
+            qh_assign_point(b, i, 0, b->num_faces);
+        }
+    }
+    return true;
+}
+
+/* Flood fills the faces visible from eye and records the horizon edges */
+static void qh_find_horizon(QHBuilder* b, int start, Point3D eye) {
+    int top = 0;
+    b->num_horizon = 0;
+    b->faces[start].visible = true;
+    b->stack[top++] = start;
+
+    while (top > 0) {
+        int f = b->stack[--top];
+        for (int k = 0; k < 3; ++k) {
+            int n = b->faces[f].neighbors[k];
+            if (b->faces[n].visible) {
+                continue;
+            }
+            if (qh_distance(b, n, eye) > b->epsilon) {
+                b->faces[n].visible = true;
+                b->stack[top++] = n;
+            }
+            else {
+                QHHorizon* h = &b->horizon[b->num_horizon++];
+                h->a = b->faces[f].v[k];
+                h->b = b->faces[f].v[(k + 1) % 3];
+                h->neighbor = n;
+            }
+        }
+    }
+}
+
+static void qh_add_point(QHBuilder* b, int face) {
+    /* Farthest outside point of the face becomes the eye */
+    int eye = b->faces[face].outside;
+    float best = qh_distance(b, face, b->points[eye]);
+    for (int p = b->point_next[eye]; p >= 0; p = b->point_next[p]) {
+        float d = qh_distance(b, face, b->points[p]);
+        if (d > best) {
+            best = d;
+            eye = p;
+        }
+    }
+
+    qh_find_horizon(b, face, b->points[eye]);
+
+    /* Retire the visible faces, pooling their outside points */
+    int orphans = -1;
+    for (int f = 0; f < b->num_faces; ++f) {
+        QHFace* vf = &b->faces[f];
+        if (!vf->alive || !vf->visible) {
+            continue;
+        }
+        for (int p = vf->outside; p >= 0;) {
+            int next = b->point_next[p];
+            if (p != eye) {
+                b->point_next[p] = orphans;
+                orphans = p;
+            }
+            p = next;
+        }
+        vf->outside = -1;
+        vf->alive = false;
+    }
+
+    /* Cone of new faces from the horizon to the eye */
+    int first = b->num_faces;
+    int num_horizon = b->num_horizon;
+    for (int i = 0; i < num_horizon; ++i) {
+        QHHorizon h = b->horizon[i];
+        int nf = qh_add_face(b, h.a, h.b, eye);
+        b->faces[nf].neighbors[0] = h.neighbor;
+        QHFace* n = &b->faces[h.neighbor];
+        n->neighbors[qh_edge_slot(n, h.b, h.a)] = nf;
+    }
+    for (int i = first; i < b->num_faces; ++i) {
+        for (int j = first; j < b->num_faces; ++j) {
+            /* j's edge eye -> v[0] is the twin of i's edge v[1] -> eye */
+            if (b->faces[j].v[0] == b->faces[i].v[1]) {
+                b->faces[i].neighbors[1] = j;
+                b->faces[j].neighbors[2] = i;
+            }
+        }
+    }
+
+    for (int p = orphans; p >= 0;) {
+        int next = b->point_next[p];
+        qh_assign_point(b, p, first, b->num_faces);
+        p = next;
+    }
+}
+
+static int qh_next_face(const QHBuilder* b) {
+    for (int f = 0; f < b->num_faces; ++f) {
+        if (b->faces[f].alive && b->faces[f].outside >= 0) {
+            return f;
+        }
+    }
+    return -1;
+}
+
+/*******************************************************************************
+ * Half-Edge Construction
+ ******************************************************************************/
+
+/*
+ * Walks the boundary of a face group (triangles [members, members + count))
+ * into one CCW vertex loop. Fails for groups whose boundary is not a single
+ * simple loop, which are then emitted as separate triangles.
+ */
+static int qh_group_loop(const QHBuilder* b, const int* group, const int* members, int count,
+                         int id, int* out_loop, int* scratch) {
+    int num_boundary = 0;
+    for (int m = 0; m < count; ++m) {
+        const QHFace* f = &b->faces[members[m]];
+        for (int k = 0; k < 3; ++k) {
+            if (group[f->neighbors[k]] != id) {
+                scratch[num_boundary * 2] = f->v[k];
+                scratch[num_boundary * 2 + 1] = f->v[(k + 1) % 3];
+                ++num_boundary;
+            }
+        }
+    }
+
+    int length = 0;
+    int current = 0;
+    while (length < num_boundary) {
+        out_loop[length++] = scratch[current * 2];
+        int dest = scratch[current * 2 + 1];
+        int next = -1;
+        for (int e = 0; e < num_boundary; ++e) {
+            if (scratch[e * 2] == dest) {
+                if (next >= 0) {
+                    return 0;
+                }
+                next = e;
+            }
+        }
+        if (next < 0) {
+            return 0;
+        }
+        if (next == 0) {
+            break;
+        }
+        current = next;
+    }
+    return length == num_boundary ? length : 0;
+}
+
+static bool qh_mergeable(const QHBuilder* b, int seed, int face) {
+    const QHFace* s = &b->faces[seed];
+    const QHFace* f = &b->faces[face];
+    if (vec3_dot(f->normal, s->normal) <= HULL_COPLANAR_COS) {
+        return false;
+    }
+    for (int k = 0; k < 3; ++k) {
+        if (fabsf(qh_distance(b, seed, b->points[f->v[k]])) > b->merge_distance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Newell normal of the loop, pushed out to the farthest vertex of the group's triangles */
+static Plane qh_group_plane(const QHBuilder* b, const int* loop, int length, const int* members, int count) {
+    vec3 n = vec3_make(0, 0, 0);
+    for (int i = 0; i < length; ++i) {
+        Point3D p = b->points[loop[i]];
+        Point3D q = b->points[loop[(i + 1) % length]];
+        n.x += (p.y - q.y) * (p.z + q.z);
+        n.y += (p.z - q.z) * (p.x + q.x);
+        n.z += (p.x - q.x) * (p.y + q.y);
+    }
+    n = vec3_normalized(n);
+
+    float distance = -FLT_MAX;
+    for (int m = 0; m < count; ++m) {
+        for (int k = 0; k < 3; ++k) {
+            distance = fmaxf(distance, vec3_dot(n, b->points[b->faces[members[m]].v[k]]));
+        }
+    }
+    return plane_create(n, distance);
+}
+
+static bool qh_emit_hull(QHBuilder* b, ConvexHull* out) {
+    int nf = b->num_faces;
+    int* group = malloc((size_t)nf * sizeof(int));
+    int* members = malloc((size_t)nf * sizeof(int));
+    int* loops = malloc((size_t)nf * 3 * sizeof(int));
+    int* loop_start = malloc((size_t)(nf + 1) * sizeof(int));
+    Plane* planes = malloc((size_t)nf * sizeof(Plane));
+    int* scratch = malloc((size_t)nf * 6 * sizeof(int));
+    int* vmap = malloc((size_t)b->num_points * sizeof(int));
+    int num_loops = 0;
+    int num_loop_vertices = 0;
+    int num_groups = 0;
+    bool ok = true;
+
+    for (int f = 0; f < nf; ++f) {
+        group[f] = -1;
+    }
+
+    /* Grow coplanar regions around seed triangles */
+    for (int seed = 0; seed < nf; ++seed) {
+        if (!b->faces[seed].alive || group[seed] >= 0) {
+            continue;
+        }
+        int id = num_groups++;
+        int count = 0;
+        group[seed] = id;
+        members[count++] = seed;
+        for (int m = 0; m < count; ++m) {
+            const QHFace* f = &b->faces[members[m]];
+            for (int k = 0; k < 3; ++k) {
+                int n = f->neighbors[k];
+                if (group[n] < 0 && qh_mergeable(b, seed, n)) {
+                    group[n] = id;
+                    members[count++] = n;
+                }
+            }
+        }
+
+        int length = count > 1
+            ? qh_group_loop(b, group, members, count, id, &loops[num_loop_vertices], scratch)
+            : 0;
+        if (length > 0) {
+            planes[num_loops] = qh_group_plane(b, &loops[num_loop_vertices], length, members, count);
+            loop_start[num_loops++] = num_loop_vertices;
+            num_loop_vertices += length;
+            continue;
+        }
+
+        /* Single triangle, or a group that does not form one loop */
+        for (int m = 0; m < count; ++m) {
+            const QHFace* f = &b->faces[members[m]];
+            group[members[m]] = num_groups++;
+            planes[num_loops] = plane_create(f->normal, f->distance);
+            loop_start[num_loops++] = num_loop_vertices;
+            for (int k = 0; k < 3; ++k) {
+                loops[num_loop_vertices++] = f->v[k];
+            }
+        }
+    }
+    loop_start[num_loops] = num_loop_vertices;
+
+    /* Compact the vertices referenced by the loops */
+    int num_vertices = 0;
+    for (int i = 0; i < b->num_points; ++i) {
+        vmap[i] = -1;
+    }
+    for (int i = 0; i < num_loop_vertices; ++i) {
+        if (vmap[loops[i]] < 0) {
+            vmap[loops[i]] = num_vertices++;
+        }
+    }
+
+    out->num_vertices = num_vertices;
+    out->num_faces = num_loops;
+    out->num_edges = num_loop_vertices;
+    out->vertices = malloc((size_t)num_vertices * sizeof(Point3D));
+    out->faces = malloc((size_t)num_loops * sizeof(HullFace));
+    out->edges = malloc((size_t)num_loop_vertices * sizeof(HullHalfEdge));
+
+    for (int i = 0; i < b->num_points; ++i) {
+        if (vmap[i] >= 0) {
+            out->vertices[vmap[i]] = b->points[i];
+        }
+    }
+
+    /* Half-edges in loop order, with the outgoing edges of each vertex bucketed */
+    HullHalfEdge* edges = malloc((size_t)num_loop_vertices * sizeof(HullHalfEdge));
+    int* bucket_start = calloc((size_t)num_vertices + 1, sizeof(int));
+    int* bucket = malloc((size_t)num_loop_vertices * sizeof(int));
+    int* remap = malloc((size_t)num_loop_vertices * sizeof(int));
+
+    for (int f = 0; f < num_loops; ++f) {
+        int start = loop_start[f];
+        int length = loop_start[f + 1] - start;
+        for (int i = 0; i < length; ++i) {
+            edges[start + i].origin = vmap[loops[start + i]];
+            edges[start + i].next = start + (i + 1) % length;
+            edges[start + i].face = f;
+            edges[start + i].twin = -1;
+            ++bucket_start[edges[start + i].origin + 1];
+        }
+    }
+    for (int v = 0; v < num_vertices; ++v) {
+        bucket_start[v + 1] += bucket_start[v];
+    }
+    for (int e = 0; e < num_loop_vertices; ++e) {
+        bucket[bucket_start[edges[e].origin]++] = e;
+    }
+    for (int v = num_vertices; v > 0; --v) {
+        bucket_start[v] = bucket_start[v - 1];
+    }
+    bucket_start[0] = 0;
+
+    for (int e = 0; e < num_loop_vertices && ok; ++e) {
+        int from = edges[e].origin;
+        int to = edges[edges[e].next].origin;
+        for (int i = bucket_start[to]; i < bucket_start[to + 1]; ++i) {
+            int t = bucket[i];
+            if (edges[edges[t].next].origin == from) {
+                edges[e].twin = t;
+                break;
+            }
+        }
+        ok = edges[e].twin >= 0;
+    }
+
+    if (ok) {
+        /* Renumber so that twins sit at 2k / 2k + 1 */
+        int next_id = 0;
+        for (int e = 0; e < num_loop_vertices; ++e) {
+            remap[e] = -1;
+        }
+        for (int e = 0; e < num_loop_vertices; ++e) {
+            if (remap[e] < 0) {
+                remap[e] = next_id++;
+                remap[edges[e].twin] = next_id++;
+            }
+        }
+        for (int e = 0; e < num_loop_vertices; ++e) {
+            HullHalfEdge* dst = &out->edges[remap[e]];
+            dst->origin = edges[e].origin;
+            dst->twin = remap[edges[e].twin];
+            dst->next = remap[edges[e].next];
+            dst->face = edges[e].face;
+        }
+
+        for (int f = 0; f < num_loops; ++f) {
+            out->faces[f].plane = planes[f];
+            out->faces[f].edge = remap[loop_start[f]];
+        }
+    }
+
+    free(remap);
+    free(bucket);
+    free(bucket_start);
+    free(edges);
+    free(vmap);
+    free(scratch);
+    free(planes);
+    free(loop_start);
+    free(loops);
+    free(members);
+    free(group);
+    return ok;
+}
+
+static void convex_hull_update_bounds(ConvexHull* hull) {
+    vec3 min = hull->vertices[0];
+    vec3 max = hull->vertices[0];
+    vec3 sum = vec3_make(0, 0, 0);
+
+    for (int i = 0; i < hull->num_vertices; ++i) {
+        Point3D p = hull->vertices[i];
+        min = vec3_make(fminf(min.x, p.x), fminf(min.y, p.y), fminf(min.z, p.z));
+        max = vec3_make(fmaxf(max.x, p.x), fmaxf(max.y, p.y), fmaxf(max.z, p.z));
+        sum = vec3_add(sum, p);
+    }
+    hull->centroid = vec3_scale(sum, 1.0f / (float)hull->num_vertices);
+    hull->bounds = aabb_create(vec3_scale(vec3_add(min, max), 0.5f),
+                               vec3_scale(vec3_sub(max, min), 0.5f));
+}
+
+/*******************************************************************************
+ * Construction
+ ******************************************************************************/
+
+bool convex_hull_from_points(const Point3D* points, int count, ConvexHull* out_hull) {
+    *out_hull = convex_hull_default();
+    if (points == NULL || count < 4) {
+        return false;
+    }
+
+    QHBuilder b = {0};
+    b.points = points;
+    b.num_points = count;
+    b.point_next = malloc((size_t)count * sizeof(int));
+
+    bool ok = qh_init_simplex(&b);
+    int face;
+    while (ok && (face = qh_next_face(&b)) >= 0) {
+        qh_add_point(&b, face);
+    }
+    if (ok) {
+        ok = qh_emit_hull(&b, out_hull);
+    }
+
+    free(b.horizon);
+    free(b.stack);
+    free(b.faces);
+    free(b.point_next);
+
+    if (!ok) {
+        convex_hull_free(out_hull);
+        return false;
+    }
+    convex_hull_update_bounds(out_hull);
+    return true;
+}
+
+bool convex_hull_from_mesh(const Mesh* mesh, ConvexHull* out_hull) {
+    return convex_hull_from_points(mesh->vertices, mesh->num_triangles * 3, out_hull);
+}
+
+void convex_hull_free(ConvexHull* hull) {
+    free(hull->vertices);
+    free(hull->edges);
+    free(hull->faces);
+    *hull = convex_hull_default();
+}
+
+bool convex_hull_copy(const ConvexHull* src, ConvexHull* dst) {
+    *dst = *src;
+    dst->vertices = malloc((size_t)src->num_vertices * sizeof(Point3D));
+    dst->edges = malloc((size_t)src->num_edges * sizeof(HullHalfEdge));
+    dst->faces = malloc((size_t)src->num_faces * sizeof(HullFace));
+    if (dst->vertices == NULL || dst->edges == NULL || dst->faces == NULL) {
+        convex_hull_free(dst);
+        return false;
+    }
+    memcpy(dst->vertices, src->vertices, (size_t)src->num_vertices * sizeof(Point3D));
+    memcpy(dst->edges, src->edges, (size_t)src->num_edges * sizeof(HullHalfEdge));
+    memcpy(dst->faces, src->faces, (size_t)src->num_faces * sizeof(HullFace));
+    return true;
+}
+
+void convex_hull_transform(const ConvexHull* src, mat4 world, ConvexHull* dst) {
+    mat4_transform_points(&world, src->vertices, dst->vertices, (size_t)src->num_vertices, 0);
+    for (int f = 0; f < src->num_faces; ++f) {
+        vec3 n = vec3_normalized(mat4_multiply_vector(src->faces[f].plane.normal, world));
+        Point3D p = dst->vertices[src->edges[src->faces[f].edge].origin];
+        dst->faces[f].plane = plane_create(n, vec3_dot(n, p));
+    }
+    convex_hull_update_bounds(dst);
+}
+
+/*******************************************************************************
+ * Queries
+ ******************************************************************************/
+
+bool point_in_convex_hull(Point3D point, const ConvexHull* hull) {
+    for (int f = 0; f < hull->num_faces; ++f) {
+        Plane plane = hull->faces[f].plane;
+        if (vec3_dot(plane.normal, point) - plane.distance > 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Clips origin + t * direction to the hull; *out_exit_face is set when t_enter < 0 */
+static bool hull_clip_ray(const ConvexHull* hull, Point3D origin, vec3 direction,
+                          float* out_enter, float* out_exit, int* out_enter_face, int* out_exit_face) {
+    float t_enter = -FLT_MAX;
+    float t_exit = FLT_MAX;
+    int enter_face = -1;
+    int exit_face = -1;
+
+    for (int f = 0; f < hull->num_faces; ++f) {
+        Plane plane = hull->faces[f].plane;
+        float denom = vec3_dot(plane.normal, direction);
+        float dist = vec3_dot(plane.normal, origin) - plane.distance;
+
+        if (denom == 0.0f) {
+            if (dist > 0.0f) {
+                return false;
+            }
+            continue;
+        }
+
+        float t = -dist / denom;
+        if (denom < 0.0f) {
+            if (t > t_enter) {
+                t_enter = t;
+                enter_face = f;
+            }
+        }
+        else if (t < t_exit) {
+            t_exit = t;
+            exit_face = f;
+        }
+        if (t_enter > t_exit) {
+            return false;
+        }
+    }
+
+    *out_enter = t_enter;
+    *out_exit = t_exit;
+    *out_enter_face = enter_face;
+    *out_exit_face = exit_face;
+    return true;
+}
+
+bool raycast_convex_hull(const ConvexHull* hull, Ray3D ray, RaycastResult* out_result) {
+    raycast_result_reset(out_result);
+
+    float t_enter, t_exit;
+    int enter_face, exit_face;
+    if (!hull_clip_ray(hull, ray.origin, ray.direction, &t_enter, &t_exit, &enter_face, &exit_face)) {
+        return false;
+    }
+    if (t_exit < 0.0f) {
+        return false;
+    }
+
+    /* Origin inside the hull: report the exit like raycast_obb does */
+    float t = t_enter >= 0.0f ? t_enter : t_exit;
+    int face = t_enter >= 0.0f ? enter_face : exit_face;
+    if (face < 0) {
+        return false;
+    }
+
+    if (out_result != NULL) {
+        out_result->t = t;
+        out_result->hit = true;
+        out_result->point = vec3_add(ray.origin, vec3_scale(ray.direction, t));
+        out_result->normal = hull->faces[face].plane.normal;
+    }
+    return true;
+}
+
+bool linetest_convex_hull(const ConvexHull* hull, Line3D line) {
+    float t_enter, t_exit;
+    int enter_face, exit_face;
+    vec3 direction = vec3_sub(line.end, line.start);
+
+    if (!hull_clip_ray(hull, line.start, direction, &t_enter, &t_exit, &enter_face, &exit_face)) {
+        return false;
+    }
+    return t_enter <= 1.0f && t_exit >= 0.0f;
+}
+
+vec3 support_convex_hull(const void* shape, vec3 direction) {
+    const ConvexHull* hull = (const ConvexHull*)shape;
+    int best = 0;
+    float best_dot = vec3_dot(hull->vertices[0], direction);
+
+    for (int i = 1; i < hull->num_vertices; ++i) {
+        float d = vec3_dot(hull->vertices[i], direction);
+        if (d > best_dot) {
+            best_dot = d;
+            best = i;
+        }
+    }
+    return hull->vertices[best];
+}
+
+/*******************************************************************************
+ * SAT
+ ******************************************************************************/
+
+typedef struct HullQuery {
+    float separation;
+    int   index_a;
+    int   index_b;
+} HullQuery;
+
+static float hull_face_separation(const ConvexHull* A, int face, const ConvexHull* B) {
+    Plane plane = A->faces[face].plane;
+    Point3D support = support_convex_hull(B, vec3_scale(plane.normal, -1.0f));
+    return vec3_dot(plane.normal, support) - plane.distance;
+}
+
+static HullQuery hull_query_faces(const ConvexHull* A, const ConvexHull* B) {
+    HullQuery query = { -FLT_MAX, -1, -1 };
+    for (int f = 0; f < A->num_faces; ++f) {
+        float separation = hull_face_separation(A, f, B);
+        if (separation > query.separation) {
+            query.separation = separation;
+            query.index_a = f;
+        }
+    }
+    return query;
+}
+
+/* Do the arcs a-b and c-d intersect on the Gauss map (i.e. form a face of A - B) */
+static bool hull_is_minkowski_face(vec3 a, vec3 b, vec3 c, vec3 d) {
+    vec3 b_x_a = vec3_cross(b, a);
+    vec3 d_x_c = vec3_cross(d, c);
+    float cba = vec3_dot(c, b_x_a);
+    float dba = vec3_dot(d, b_x_a);
+    float adc = vec3_dot(a, d_x_c);
+    float bdc = vec3_dot(b, d_x_c);
+    return cba * dba < 0.0f && adc * bdc < 0.0f && cba * bdc > 0.0f;
+}
+
+static float hull_edge_separation(const ConvexHull* A, int edge_a, const ConvexHull* B, int edge_b,
+                                  vec3* out_axis) {
+    Point3D pa = A->vertices[A->edges[edge_a].origin];
+    Point3D pb = B->vertices[B->edges[edge_b].origin];
+    vec3 ea = vec3_sub(A->vertices[A->edges[edge_a ^ 1].origin], pa);
+    vec3 eb = vec3_sub(B->vertices[B->edges[edge_b ^ 1].origin], pb);
+    vec3 axis = vec3_cross(ea, eb);
+    float len_sq = vec3_magnitude_sq(axis);
+
+    /* Parallel edges are covered by the face axes */
+    if (len_sq < 1.0e-10f * vec3_magnitude_sq(ea) * vec3_magnitude_sq(eb)) {
+        return -FLT_MAX;
+    }
+
+    axis = vec3_scale(axis, 1.0f / sqrtf(len_sq));
+    if (vec3_dot(axis, vec3_sub(pa, A->centroid)) < 0.0f) {
+        axis = vec3_scale(axis, -1.0f);
+    }
+    if (out_axis != NULL) {
+        *out_axis = axis;
+    }
+    return vec3_dot(axis, vec3_sub(pb, pa));
+}
+
+static HullQuery hull_query_edges(const ConvexHull* A, const ConvexHull* B) {
+    HullQuery query = { -FLT_MAX, -1, -1 };
+
+    for (int i = 0; i < A->num_edges; i += 2) {
+        vec3 a = A->faces[A->edges[i].face].plane.normal;
+        vec3 b = A->faces[A->edges[i + 1].face].plane.normal;
+
+        for (int j = 0; j < B->num_edges; j += 2) {
+            vec3 c = vec3_scale(B->faces[B->edges[j].face].plane.normal, -1.0f);
+            vec3 d = vec3_scale(B->faces[B->edges[j + 1].face].plane.normal, -1.0f);
+
+            if (!hull_is_minkowski_face(a, b, c, d)) {
+                continue;
+            }
+            float separation = hull_edge_separation(A, i, B, j, NULL);
+            if (separation > query.separation) {
+                query.separation = separation;
+                query.index_a = i;
+                query.index_b = j;
+            }
+        }
+    }
+    return query;
+}
+
+static bool hull_cache_separates(const ConvexHull* A, const ConvexHull* B, const HullFeatureCache* cache) {
+    if (cache == NULL) {
+        return false;
+    }
+    switch (cache->type) {
+        case HULL_FEATURE_FACE_A:
+            return cache->index_a < A->num_faces && hull_face_separation(A, cache->index_a, B) > 0.0f;
+        case HULL_FEATURE_FACE_B:
+            return cache->index_b < B->num_faces && hull_face_separation(B, cache->index_b, A) > 0.0f;
+        case HULL_FEATURE_EDGES:
+            return cache->index_a < A->num_edges && cache->index_b < B->num_edges &&
+                   hull_edge_separation(A, cache->index_a, B, cache->index_b, NULL) > 0.0f;
+        default:
+            return false;
+    }
+}
+
+/* Contact feature, preferring faces over edges and A over B unless clearly worse */
+static HullFeatureType hull_select_feature(HullQuery face_a, HullQuery face_b, HullQuery edge) {
+    float face_max = fmaxf(face_a.separation, face_b.separation);
+    if (edge.index_a >= 0 && edge.separation > HULL_FACE_TOLERANCE * face_max + HULL_LINEAR_SLOP) {
+        return HULL_FEATURE_EDGES;
+    }
+    if (face_b.separation > HULL_FACE_TOLERANCE * face_a.separation + HULL_LINEAR_SLOP) {
+        return HULL_FEATURE_FACE_B;
+    }
+    return HULL_FEATURE_FACE_A;
+}
+
+static void hull_cache_store(HullFeatureCache* cache, HullFeatureType type, int index_a, int index_b) {
+    if (cache != NULL) {
+        cache->type = type;
+        cache->index_a = index_a;
+        cache->index_b = index_b;
+    }
+}
+
+static bool hull_sat(const ConvexHull* A, const ConvexHull* B, HullFeatureCache* cache,
+                     HullQuery* out_face_a, HullQuery* out_face_b, HullQuery* out_edge) {
+    if (hull_cache_separates(A, B, cache)) {
+        return false;
+    }
+
+    *out_face_a = hull_query_faces(A, B);
+    if (out_face_a->separation > 0.0f) {
+        hull_cache_store(cache, HULL_FEATURE_FACE_A, out_face_a->index_a, -1);
+        return false;
+    }
+
+    HullQuery face_b = hull_query_faces(B, A);
+    out_face_b->separation = face_b.separation;
+    out_face_b->index_a = -1;
+    out_face_b->index_b = face_b.index_a;
+    if (out_face_b->separation > 0.0f) {
+        hull_cache_store(cache, HULL_FEATURE_FACE_B, -1, out_face_b->index_b);
+        return false;
+    }
+
+    *out_edge = hull_query_edges(A, B);
+    if (out_edge->separation > 0.0f) {
+        hull_cache_store(cache, HULL_FEATURE_EDGES, out_edge->index_a, out_edge->index_b);
+        return false;
+    }
+
+    switch (hull_select_feature(*out_face_a, *out_face_b, *out_edge)) {
+        case HULL_FEATURE_EDGES:
+            hull_cache_store(cache, HULL_FEATURE_EDGES, out_edge->index_a, out_edge->index_b);
+            break;
+        case HULL_FEATURE_FACE_B:
+            hull_cache_store(cache, HULL_FEATURE_FACE_B, -1, out_face_b->index_b);
+            break;
+        default:
+            hull_cache_store(cache, HULL_FEATURE_FACE_A, out_face_a->index_a, -1);
+            break;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Contact Generation
+ ******************************************************************************/
+
+static bool hull_face_contacts(const ConvexHull* ref, int ref_face, const ConvexHull* inc,
+                               bool flip, FixedManifold* out) {
+    Plane plane = ref->faces[ref_face].plane;
+
+    /* Most anti-parallel face of the incident hull */
+    int inc_face = 0;
+    float min_dot = FLT_MAX;
+    for (int f = 0; f < inc->num_faces; ++f) {
+        float d = vec3_dot(plane.normal, inc->faces[f].plane.normal);
+        if (d < min_dot) {
+            min_dot = d;
+            inc_face = f;
+        }
+    }
+
+    Point3D buffers[2][HULL_MAX_CLIP_VERTICES];
+    Point3D* input = buffers[0];
+    Point3D* output = buffers[1];
+    int count = 0;
+
+    int start = inc->faces[inc_face].edge;
+    int e = start;
+    do {
+        if (count < HULL_MAX_CLIP_VERTICES) {
+            input[count++] = inc->vertices[inc->edges[e].origin];
+        }
+        e = inc->edges[e].next;
+    } while (e != start);
+
+    /* Clip against the side planes of the reference face */
+    start = ref->faces[ref_face].edge;
+    e = start;
+    do {
+        Point3D p = ref->vertices[ref->edges[e].origin];
+        Point3D q = ref->vertices[ref->edges[ref->edges[e].next].origin];
+        vec3 side = vec3_cross(vec3_sub(q, p), plane.normal);
+
+        count = clip_polygon_to_plane(input, count, plane_create(side, vec3_dot(side, p)), output,
+                                      HULL_MAX_CLIP_VERTICES);
+        Point3D* swap = input;
+        input = output;
+        output = swap;
+        e = ref->edges[e].next;
+    } while (e != start && count > 0);
+
+    /* Keep points below the reference face, moved halfway onto it */
+    Point3D points[HULL_MAX_CLIP_VERTICES];
+    float depths[HULL_MAX_CLIP_VERTICES];
+    int num_points = 0;
+    for (int i = 0; i < count; ++i) {
+        float separation = vec3_dot(plane.normal, input[i]) - plane.distance;
+        if (separation <= 0.0f) {
+            points[num_points] = vec3_sub(input[i], vec3_scale(plane.normal, 0.5f * separation));
+            depths[num_points] = -separation;
+            ++num_points;
+        }
+    }
+    if (num_points == 0) {
+        return false;
+    }
+
+    num_points = reduce_contacts(points, depths, num_points, plane.normal);
+
+    out->colliding = true;
+    out->normal = flip ? vec3_scale(plane.normal, -1.0f) : plane.normal;
+    out->depth = 0.0f;
+    for (int i = 0; i < num_points; ++i) {
+        out->depth = fmaxf(out->depth, depths[i]);
+        fixed_contact_array_push(&out->contacts, points[i]);
+    }
+    return true;
+}
+
+static bool hull_edge_contact(const ConvexHull* A, int edge_a, const ConvexHull* B, int edge_b,
+                              FixedManifold* out) {
+    vec3 axis = vec3_make(0, 0, 1);
+    float separation = hull_edge_separation(A, edge_a, B, edge_b, &axis);
+
+    Line3D la = line3d_create(A->vertices[A->edges[edge_a].origin], A->vertices[A->edges[edge_a ^ 1].origin]);
+    Line3D lb = line3d_create(B->vertices[B->edges[edge_b].origin], B->vertices[B->edges[edge_b ^ 1].origin]);
+    Point3D pa, pb;
+    closest_points_line3d_line3d(la, lb, &pa, &pb);
+
+    out->colliding = true;
+    out->normal = axis;
+    out->depth = -separation;
+    fixed_contact_array_push(&out->contacts, vec3_scale(vec3_add(pa, pb), 0.5f));
+    return true;
+}
+
+/*******************************************************************************
+ * OBB as Hull
+ ******************************************************************************/
+
+/* Vertex i sits at the (bit 0, 1, 2 -> +x, +y, +z) corner; faces are +X -X +Y -Y +Z -Z */
+static const HullHalfEdge box_hull_edges[24] = {
+    { 1,  1,  2, 0 }, { 3,  0, 21, 5 }, { 3,  3,  4, 0 }, { 7,  2, 18, 2 },
+    { 7,  5,  6, 0 }, { 5,  4, 17, 4 }, { 5,  7,  0, 0 }, { 1,  6, 22, 3 },
+    { 0,  9, 10, 1 }, { 4,  8, 20, 3 }, { 4, 11, 12, 1 }, { 6, 10, 23, 4 },
+    { 6, 13, 14, 1 }, { 2, 12, 16, 2 }, { 2, 15,  8, 1 }, { 0, 14, 19, 5 },
+    { 6, 17,  3, 2 }, { 7, 16, 11, 4 }, { 3, 19, 13, 2 }, { 2, 18,  1, 5 },
+    { 0, 21,  7, 3 }, { 1, 20, 15, 5 }, { 5, 23,  9, 3 }, { 4, 22,  5, 4 },
+};
+
+static const int box_hull_face_edges[6] = { 0, 8, 3, 7, 5, 1 };
+
+typedef struct BoxHull {
+    Point3D      vertices[8];
+    HullHalfEdge edges[24];
+    HullFace     faces[6];
+    ConvexHull   hull;
+} BoxHull;
+
+static void box_hull_from_obb(OBB obb, BoxHull* box) {
+    vec3 axes[3];
+    for (int i = 0; i < 3; ++i) {
+        axes[i] = vec3_make(obb.orientation.m[i][0], obb.orientation.m[i][1], obb.orientation.m[i][2]);
+    }
+
+    for (int v = 0; v < 8; ++v) {
+        Point3D p = obb.position;
+        for (int i = 0; i < 3; ++i) {
+            float extent = (v & (1 << i)) ? obb.size.v[i] : -obb.size.v[i];
+            p = vec3_add(p, vec3_scale(axes[i], extent));
+        }
+        box->vertices[v] = p;
+    }
+    for (int f = 0; f < 6; ++f) {
+        vec3 n = (f & 1) ? vec3_scale(axes[f / 2], -1.0f) : axes[f / 2];
+        box->faces[f].edge = box_hull_face_edges[f];
+        box->faces[f].plane = plane_create(n, vec3_dot(n, obb.position) + obb.size.v[f / 2]);
+    }
+    memcpy(box->edges, box_hull_edges, sizeof(box_hull_edges));
+
+    box->hull.vertices = box->vertices;
+    box->hull.edges = box->edges;
+    box->hull.faces = box->faces;
+    box->hull.num_vertices = 8;
+    box->hull.num_edges = 24;
+    box->hull.num_faces = 6;
+    box->hull.centroid = obb.position;
+    box->hull.bounds = aabb_create(obb.position, vec3_make(
+        fabsf(axes[0].x) * obb.size.x + fabsf(axes[1].x) * obb.size.y + fabsf(axes[2].x) * obb.size.z,
+        fabsf(axes[0].y) * obb.size.x + fabsf(axes[1].y) * obb.size.y + fabsf(axes[2].y) * obb.size.z,
+        fabsf(axes[0].z) * obb.size.x + fabsf(axes[1].z) * obb.size.y + fabsf(axes[2].z) * obb.size.z));
+}
+
+/*******************************************************************************
+ * Collision
+ ******************************************************************************/
+
+bool convex_hull_convex_hull(const ConvexHull* A, const ConvexHull* B, HullFeatureCache* cache) {
+    HullQuery face_a, face_b, edge;
+    return hull_sat(A, B, cache, &face_a, &face_b, &edge);
+}
+
+bool convex_hull_obb(const ConvexHull* hull, OBB obb, HullFeatureCache* cache) {
+    BoxHull box;
+    box_hull_from_obb(obb, &box);
+    return convex_hull_convex_hull(hull, &box.hull, cache);
+}
+
+bool convex_hull_sphere(const ConvexHull* hull, Sphere sphere) {
+    return gjk_intersect(convex_shape_hull(hull), convex_shape_sphere(&sphere), NULL);
+}
+
+bool convex_hull_triangle(const ConvexHull* hull, Triangle triangle) {
+    return gjk_intersect(convex_shape_hull(hull), convex_shape_triangle(&triangle), NULL);
+}
+
+bool find_collision_features_hull_hull(const ConvexHull* A, const ConvexHull* B,
+                                       HullFeatureCache* cache, FixedManifold* out) {
+    fixed_manifold_init(out);
+
+    HullQuery face_a, face_b, edge;
+    if (!hull_sat(A, B, cache, &face_a, &face_b, &edge)) {
+        return false;
+    }
+
+    switch (hull_select_feature(face_a, face_b, edge)) {
+        case HULL_FEATURE_EDGES:
+            return hull_edge_contact(A, edge.index_a, B, edge.index_b, out);
+        case HULL_FEATURE_FACE_B:
+            return hull_face_contacts(B, face_b.index_b, A, true, out);
+        default:
+            return hull_face_contacts(A, face_a.index_a, B, false, out);
+    }
+}
+
+bool find_collision_features_hull_obb(const ConvexHull* hull, OBB obb,
+                                      HullFeatureCache* cache, FixedManifold* out) {
+    BoxHull box;
+    box_hull_from_obb(obb, &box);
+    return find_collision_features_hull_hull(hull, &box.hull, cache, out);
+}
+
+bool find_collision_features_hull_sphere(const ConvexHull* hull, Sphere sphere, FixedManifold* out) {
+    return find_collision_features_gjk(convex_shape_hull(hull), convex_shape_sphere(&sphere), NULL, out);
+}
@@ -6,6 +6,8 @@
 #include "geom3d_primitives.h"
 #include "geom3d_queries.h"
 #include "geom3d_sat.h"
+#include "geom3d_gjk.h"
+#include "geom3d_simd.h"
 #include "compare.h"
 
 #include <math.h>
@@ -53,26 +55,7 @@ bool aabb_aabb(AABB a1, AABB a2) {
 }
 
 bool aabb_obb(AABB aabb, OBB obb) {
-    vec3 test[15];
-    test[0] = vec3_make(1, 0, 0);  /* AABB axis 1 */
-    test[1] = vec3_make(0, 1, 0);  /* AABB axis 2 */
-    test[2] = vec3_make(0, 0, 1);  /* AABB axis 3 */
-    test[3] = vec3_make(obb.orientation.m[0][0], obb.orientation.m[0][1], obb.orientation.m[0][2]);
-    test[4] = vec3_make(obb.orientation.m[1][0], obb.orientation.m[1][1], obb.orientation.m[1][2]);
-    test[5] = vec3_make(obb.orientation.m[2][0], obb.orientation.m[2][1], obb.orientation.m[2][2]);
-
-    for (int i = 0; i < 3; ++i) {
-        test[6 + i * 3 + 0] = vec3_cross(test[i], test[3]);
-        test[6 + i * 3 + 1] = vec3_cross(test[i], test[4]);
-        test[6 + i * 3 + 2] = vec3_cross(test[i], test[5]);
-    }
-
-    for (int i = 0; i < 15; ++i) {
-        if (!overlap_on_axis_aabb_obb(aabb, obb, test[i])) {
-            return false;
-        }
-    }
-    return true;
+    return obb_obb_sat(obb_create_simple(aabb.position, aabb.size), obb, NULL, NULL);
 }
 
 bool aabb_plane(AABB aabb, Plane plane) {
@@ -84,26 +67,7 @@ bool aabb_plane(AABB aabb, Plane plane) {
 }
 
 bool obb_obb(OBB o1, OBB o2) {
-    vec3 test[15];
-    test[0] = vec3_make(o1.orientation.m[0][0], o1.orientation.m[0][1], o1.orientation.m[0][2]);
-    test[1] = vec3_make(o1.orientation.m[1][0], o1.orientation.m[1][1], o1.orientation.m[1][2]);
-    test[2] = vec3_make(o1.orientation.m[2][0], o1.orientation.m[2][1], o1.orientation.m[2][2]);
-    test[3] = vec3_make(o2.orientation.m[0][0], o2.orientation.m[0][1], o2.orientation.m[0][2]);
-    test[4] = vec3_make(o2.orientation.m[1][0], o2.orientation.m[1][1], o2.orientation.m[1][2]);
-    test[5] = vec3_make(o2.orientation.m[2][0], o2.orientation.m[2][1], o2.orientation.m[2][2]);
-
-    for (int i = 0; i < 3; ++i) {
-        test[6 + i * 3 + 0] = vec3_cross(test[i], test[3]);
-        test[6 + i * 3 + 1] = vec3_cross(test[i], test[4]);
-        test[6 + i * 3 + 2] = vec3_cross(test[i], test[5]);
-    }
-
-    for (int i = 0; i < 15; ++i) {
-        if (!overlap_on_axis_obb_obb(o1, o2, test[i])) {
-            return false;
-        }
-    }
-    return true;
+    return obb_obb_sat(o1, o2, NULL, NULL);
 }
 
 bool obb_plane(OBB obb, Plane plane) {
@@ -124,62 +88,104 @@ bool plane_plane(Plane p1, Plane p2) {
     return !CMP(vec3_dot(d, d), 0.0f);
 }
 
+bool capsule_capsule(Capsule c1, Capsule c2) {
+    float radii_sum = c1.radius + c2.radius;
+    float dist_sq = closest_points_line3d_line3d(line3d_create(c1.start, c1.end),
+                                                 line3d_create(c2.start, c2.end), NULL, NULL);
+    return dist_sq < radii_sum * radii_sum;
+}
+
+bool capsule_sphere(Capsule capsule, Sphere sphere) {
+    Point3D closest = closest_point_on_line3d(line3d_create(capsule.start, capsule.end), sphere.position);
+    float radii_sum = capsule.radius + sphere.radius;
+    float dist_sq = vec3_magnitude_sq(vec3_sub(sphere.position, closest));
+    return dist_sq < radii_sum * radii_sum;
+}
+
+/* Segment-box distance has no cheap closed form; GJK on the core segment is exact */
+bool capsule_aabb(Capsule capsule, AABB aabb) {
+    return gjk_intersect(convex_shape_capsule(&capsule), convex_shape_aabb(&aabb), NULL);
+}
+
+bool capsule_obb(Capsule capsule, OBB obb) {
+    return gjk_intersect(convex_shape_capsule(&capsule), convex_shape_obb(&obb), NULL);
+}
+
+bool capsule_plane(Capsule capsule, Plane plane) {
+    float d1 = plane_equation(capsule.start, plane);
+    float d2 = plane_equation(capsule.end, plane);
+
+    if ((d1 <= 0.0f && d2 >= 0.0f) || (d1 >= 0.0f && d2 <= 0.0f)) {
+        return true;
+    }
+    return fminf(fabsf(d1), fabsf(d2)) < capsule.radius;
+}
+
 bool triangle_sphere(Triangle t, Sphere s) {
     Point3D closest = closest_point_on_triangle(t, s.position);
     float mag_sq = vec3_magnitude_sq(vec3_sub(closest, s.position));
     return mag_sq <= s.radius * s.radius;
 }
 
-bool triangle_aabb(Triangle t, AABB a) {
-    vec3 f0 = vec3_sub(t.b, t.a);
-    vec3 f1 = vec3_sub(t.c, t.b);
-    vec3 f2 = vec3_sub(t.a, t.c);
-
-    vec3 u0 = vec3_make(1.0f, 0.0f, 0.0f);
-    vec3 u1 = vec3_make(0.0f, 1.0f, 0.0f);
-    vec3 u2 = vec3_make(0.0f, 0.0f, 1.0f);
-
-    vec3 test[13] = {
-        u0, u1, u2,
-        vec3_cross(f0, f1),
-        vec3_cross(u0, f0), vec3_cross(u0, f1), vec3_cross(u0, f2),
-        vec3_cross(u1, f0), vec3_cross(u1, f1), vec3_cross(u1, f2),
-        vec3_cross(u2, f0), vec3_cross(u2, f1), vec3_cross(u2, f2)
-    };
-
-    for (int i = 0; i < 13; ++i) {
-        if (!overlap_on_axis_aabb_triangle(a, t, test[i])) {
+/*
+ * Akenine-Moller triangle-box overlap with the box at the origin, half size
+ * h: the three box axes (bounds of the vertices), the triangle's plane, then
+ * the nine box-axis x edge axes, each with the box's projected radius in
+ * closed form. Touching counts as overlapping.
+ */
+static bool triangle_box_local(vec3 v0, vec3 v1, vec3 v2, vec3 h) {
+    for (int i = 0; i < 3; ++i) {
+        if (fminf(fminf(v0.v[i], v1.v[i]), v2.v[i]) > h.v[i] ||
+            fmaxf(fmaxf(v0.v[i], v1.v[i]), v2.v[i]) < -h.v[i]) {
             return false;
         }
     }
-    return true;
-}
 
-bool triangle_obb(Triangle t, OBB o) {
-    vec3 f0 = vec3_sub(t.b, t.a);
-    vec3 f1 = vec3_sub(t.c, t.b);
-    vec3 f2 = vec3_sub(t.a, t.c);
-
-    vec3 u0 = vec3_make(o.orientation.m[0][0], o.orientation.m[0][1], o.orientation.m[0][2]);
-    vec3 u1 = vec3_make(o.orientation.m[1][0], o.orientation.m[1][1], o.orientation.m[1][2]);
-    vec3 u2 = vec3_make(o.orientation.m[2][0], o.orientation.m[2][1], o.orientation.m[2][2]);
-
-    vec3 test[13] = {
-        u0, u1, u2,
-        vec3_cross(f0, f1),
-        vec3_cross(u0, f0), vec3_cross(u0, f1), vec3_cross(u0, f2),
-        vec3_cross(u1, f0), vec3_cross(u1, f1), vec3_cross(u1, f2),
-        vec3_cross(u2, f0), vec3_cross(u2, f1), vec3_cross(u2, f2)
-    };
+    vec3 e[3] = { vec3_sub(v1, v0), vec3_sub(v2, v1), vec3_sub(v0, v2) };
 
-    for (int i = 0; i < 13; ++i) {
-        if (!overlap_on_axis_obb_triangle(o, t, test[i])) {
-            return false;
+    vec3 n = vec3_cross(e[0], e[1]);
+    float r = h.x * fabsf(n.x) + h.y * fabsf(n.y) + h.z * fabsf(n.z);
+    if (fabsf(vec3_dot(n, v0)) > r) {
+        return false;
+    }
+
+    /* Axis u_k x e: components follow from the zero in u_k */
+    for (int k = 0; k < 3; ++k) {
+        int k1 = (k + 1) % 3;
+        int k2 = (k + 2) % 3;
+        for (int i = 0; i < 3; ++i) {
+            float a1 = -e[i].v[k2];     /* axis.v[k1] */
+            float a2 = e[i].v[k1];      /* axis.v[k2] */
+            float p0 = a1 * v0.v[k1] + a2 * v0.v[k2];
+            float p1 = a1 * v1.v[k1] + a2 * v1.v[k2];
+            float p2 = a1 * v2.v[k1] + a2 * v2.v[k2];
+            float rad = h.v[k1] * fabsf(a1) + h.v[k2] * fabsf(a2);
+            if (fminf(fminf(p0, p1), p2) > rad || fmaxf(fmaxf(p0, p1), p2) < -rad) {
+                return false;
+            }
         }
     }
     return true;
 }
 
+static vec3 obb_to_local(OBB o, Point3D p) {
+    vec3 d = vec3_sub(p, o.position);
+    return vec3_make(
+        o.orientation.m[0][0] * d.x + o.orientation.m[0][1] * d.y + o.orientation.m[0][2] * d.z,
+        o.orientation.m[1][0] * d.x + o.orientation.m[1][1] * d.y + o.orientation.m[1][2] * d.z,
+        o.orientation.m[2][0] * d.x + o.orientation.m[2][1] * d.y + o.orientation.m[2][2] * d.z
+    );
+}
+
+bool triangle_aabb(Triangle t, AABB a) {
+    return triangle_box_local(vec3_sub(t.a, a.position), vec3_sub(t.b, a.position),
+                              vec3_sub(t.c, a.position), a.size);
+}
+
+bool triangle_obb(Triangle t, OBB o) {
+    return triangle_box_local(obb_to_local(o, t.a), obb_to_local(o, t.b), obb_to_local(o, t.c), o.size);
+}
+
 bool triangle_plane(Triangle t, Plane p) {
     float side1 = plane_equation(t.a, p);
     float side2 = plane_equation(t.b, p);
@@ -197,6 +203,29 @@ bool triangle_plane(Triangle t, Plane p) {
     return true;
 }
 
+bool triangle_capsule(Triangle t, Capsule c) {
+    /* Cheap rejects before the segment-triangle distance: bounds, then the triangle's plane */
+    for (int i = 0; i < 3; ++i) {
+        float t_min = fminf(fminf(t.a.v[i], t.b.v[i]), t.c.v[i]);
+        float t_max = fmaxf(fmaxf(t.a.v[i], t.b.v[i]), t.c.v[i]);
+        if (fminf(c.start.v[i], c.end.v[i]) - c.radius > t_max ||
+            fmaxf(c.start.v[i], c.end.v[i]) + c.radius < t_min) {
+            return false;
+        }
+    }
+
+    vec3 n = vec3_cross(vec3_sub(t.b, t.a), vec3_sub(t.c, t.a));
+    float d0 = vec3_dot(n, vec3_sub(c.start, t.a));
+    float d1 = vec3_dot(n, vec3_sub(c.end, t.a));
+    float d_min = fminf(fabsf(d0), fabsf(d1));
+    if (d0 * d1 > 0.0f && d_min * d_min > c.radius * c.radius * vec3_magnitude_sq(n)) {
+        return false;
+    }
+
+    float dist_sq = closest_points_line3d_triangle(line3d_create(c.start, c.end), t, NULL, NULL);
+    return dist_sq < c.radius * c.radius;
+}
+
 bool triangle_triangle(Triangle t1, Triangle t2) {
     vec3 t1_f0 = vec3_sub(t1.b, t1.a);
     vec3 t1_f1 = vec3_sub(t1.c, t1.b);
@@ -245,4 +274,143 @@ bool triangle_triangle_robust(Triangle t1, Triangle t2) {
         }
     }
     return true;
-}
\ No newline at end of file
+}
+
+/*******************************************************************************
+ * Batched Triangle-Box Tests
+ ******************************************************************************/
+
+/* Vertices of triangles[indices[i]] (or triangles[i]) in the box's frame */
+static void triangle_box_gather(const Triangle* triangles, const int* indices, int i,
+                                vec3 center, const mat3* orientation, vec3 out_v[3]) {
+    const Triangle* t = &triangles[indices != NULL ? indices[i] : i];
+    for (int k = 0; k < 3; ++k) {
+        vec3 d = vec3_sub(t->points[k], center);
+        if (orientation != NULL) {
+            d = vec3_make(
+                orientation->m[0][0] * d.x + orientation->m[0][1] * d.y + orientation->m[0][2] * d.z,
+                orientation->m[1][0] * d.x + orientation->m[1][1] * d.y + orientation->m[1][2] * d.z,
+                orientation->m[2][0] * d.x + orientation->m[2][1] * d.y + orientation->m[2][2] * d.z
+            );
+        }
+        out_v[k] = d;
+    }
+}
+
+#ifndef GEOM3D_SIMD_SCALAR
+/* Lane masks are all ones where the triangle is separated */
+static simd4m simd4_outside(simd4f p0, simd4f p1, simd4f p2, simd4f r) {
+    simd4f lo = simd4f_min(simd4f_min(p0, p1), p2);
+    simd4f hi = simd4f_max(simd4f_max(p0, p1), p2);
+    return simd4m_or(simd4f_gt(lo, r), simd4f_lt(hi, simd4f_neg(r)));
+}
+
+/* triangle_box_local on four triangles at once; v[vertex][axis] holds one lane per triangle */
+static int triangle_box_simd4(simd4f v[3][3], vec3 half) {
+    simd4f h[3] = { simd4f_set1(half.x), simd4f_set1(half.y), simd4f_set1(half.z) };
+
+    simd4m sep = simd4m_none();
+    for (int i = 0; i < 3; ++i) {
+        sep = simd4m_or(sep, simd4_outside(v[0][i], v[1][i], v[2][i], h[i]));
+    }
+    if (simd4m_bits(sep) == 0xF) {
+        return 0;
+    }
+
+    simd4f e[3][3];
+    for (int i = 0; i < 3; ++i) {
+        e[0][i] = simd4f_sub(v[1][i], v[0][i]);
+        e[1][i] = simd4f_sub(v[2][i], v[1][i]);
+        e[2][i] = simd4f_sub(v[0][i], v[2][i]);
+    }
+
+    simd4f n[3];
+    for (int i = 0; i < 3; ++i) {
+        int i1 = (i + 1) % 3;
+        int i2 = (i + 2) % 3;
+        n[i] = simd4f_sub(simd4f_mul(e[0][i1], e[1][i2]), simd4f_mul(e[0][i2], e[1][i1]));
+    }
+    simd4f r = simd4f_madd(h[2], simd4f_abs(n[2]),
+               simd4f_madd(h[1], simd4f_abs(n[1]), simd4f_mul(h[0], simd4f_abs(n[0]))));
+    simd4f d = simd4f_madd(n[2], v[0][2], simd4f_madd(n[1], v[0][1], simd4f_mul(n[0], v[0][0])));
+    sep = simd4m_or(sep, simd4f_gt(simd4f_abs(d), r));
+
+    for (int k = 0; k < 3; ++k) {
+        int k1 = (k + 1) % 3;
+        int k2 = (k + 2) % 3;
+        for (int i = 0; i < 3; ++i) {
+            if (simd4m_bits(sep) == 0xF) {
+                return 0;
+            }
+            simd4f a1 = simd4f_neg(e[i][k2]);
+            simd4f a2 = e[i][k1];
+            simd4f p0 = simd4f_madd(a2, v[0][k2], simd4f_mul(a1, v[0][k1]));
+            simd4f p1 = simd4f_madd(a2, v[1][k2], simd4f_mul(a1, v[1][k1]));
+            simd4f p2 = simd4f_madd(a2, v[2][k2], simd4f_mul(a1, v[2][k1]));
+            simd4f rad = simd4f_madd(h[k2], simd4f_abs(a2), simd4f_mul(h[k1], simd4f_abs(a1)));
+            sep = simd4m_or(sep, simd4_outside(p0, p1, p2, rad));
+        }
+    }
+    return ~simd4m_bits(sep) & 0xF;
+}
+#endif
+
+static int triangle_box_batch(const Triangle* triangles, const int* indices, int count,
+                              vec3 center, const mat3* orientation, vec3 half, int* out_indices) {
+    int hits = 0;
+    int i = 0;
+
+#ifndef GEOM3D_SIMD_SCALAR
+    for (; i + 4 <= count; i += 4) {
+        float lanes[3][3][4];
+        for (int l = 0; l < 4; ++l) {
+            vec3 v[3];
+            triangle_box_gather(triangles, indices, i + l, center, orientation, v);
+            for (int k = 0; k < 3; ++k) {
+                lanes[k][0][l] = v[k].x;
+                lanes[k][1][l] = v[k].y;
+                lanes[k][2][l] = v[k].z;
+            }
+        }
+
+        simd4f v[3][3];
+        for (int k = 0; k < 3; ++k) {
+            for (int a = 0; a < 3; ++a) {
+                v[k][a] = simd4f_load(lanes[k][a]);
+            }
+        }
+
+        int mask = triangle_box_simd4(v, half);
+        for (int l = 0; l < 4; ++l) {
+            if (mask & (1 << l)) {
+                if (out_indices != NULL) {
+                    out_indices[hits] = indices != NULL ? indices[i + l] : i + l;
+                }
+                ++hits;
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        vec3 v[3];
+        triangle_box_gather(triangles, indices, i, center, orientation, v);
+        if (triangle_box_local(v[0], v[1], v[2], half)) {
+            if (out_indices != NULL) {
+                out_indices[hits] = indices != NULL ? indices[i] : i;
+            }
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+int triangle_aabb_batch(const Triangle* triangles, const int* indices, int count,
+                        AABB aabb, int* out_indices) {
+    return triangle_box_batch(triangles, indices, count, aabb.position, NULL, aabb.size, out_indices);
+}
+
+int triangle_obb_batch(const Triangle* triangles, const int* indices, int count,
+                       OBB obb, int* out_indices) {
+    return triangle_box_batch(triangles, indices, count, obb.position, &obb.orientation, obb.size, out_indices);
+}
@@ -40,16 +40,16 @@ AABB model_get_bounds(const Model* model) {
 }
 
 mat4 model_get_world_matrix(const Model* model) {
-    mat4 translation = mat4_translation_vec3(model->position);
-    mat4 rotation = Rotation(model->rotation.x, model->rotation.y, model->rotation.z);
-    mat4 local_mat = mat4_mul(rotation, translation);
+    return transform_to_mat4(model_get_world_transform(model));
+}
 
-    mat4 parent_mat = mat4_identity();
+Transform model_get_world_transform(const Model* model) {
+    /* Rotate by the Euler angles, then translate, then apply the parent */
+    Transform local = transform_from_euler(model->position, model->rotation);
     if (model->parent != NULL) {
-        parent_mat = model_get_world_matrix(model->parent);
+        return transform_compose(model_get_world_transform(model->parent), local);
     }
-
-    return mat4_mul(local_mat, parent_mat);
+    return local;
 }
 
 OBB model_get_obb(const Model* model) {
@@ -166,6 +166,80 @@ bool model_triangle(const Model* model, Triangle triangle) {
     return false;
 }
 
+bool model_capsule(const Model* model, Capsule capsule) {
+    mat4 world = model_get_world_matrix(model);
+    mat4 inv = mat4_inverse(world);
+
+    Capsule local;
+    local.start = MultiplyPoint(capsule.start, inv);
+    local.end = MultiplyPoint(capsule.end, inv);
+    local.radius = capsule.radius;
+
+    if (model->content != NULL) {
+        return mesh_capsule(model->content, local);
+    }
+    return false;
+}
+
+/* Brings a local-space cast result back to world space; t is unchanged */
+static void model_sweep_to_world(mat4 world, RaycastResult* result) {
+    result->point = MultiplyPoint(result->point, world);
+    result->normal = vec3_normalized(mat4_multiply_vector(result->normal, world));
+}
+
+bool model_sweep_sphere(const Model* model, Sphere sphere, vec3 motion, RaycastResult* out_result) {
+    mat4 world = model_get_world_matrix(model);
+    mat4 inv = mat4_inverse(world);
+
+    Sphere local;
+    local.position = MultiplyPoint(sphere.position, inv);
+    local.radius = sphere.radius;
+
+    if (model->content != NULL && mesh_sweep_sphere(model->content, local, mat4_multiply_vector(motion, inv), out_result)) {
+        if (out_result) {
+            model_sweep_to_world(world, out_result);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool model_sweep_capsule(const Model* model, Capsule capsule, vec3 motion, RaycastResult* out_result) {
+    mat4 world = model_get_world_matrix(model);
+    mat4 inv = mat4_inverse(world);
+
+    Capsule local;
+    local.start = MultiplyPoint(capsule.start, inv);
+    local.end = MultiplyPoint(capsule.end, inv);
+    local.radius = capsule.radius;
+
+    if (model->content != NULL && mesh_sweep_capsule(model->content, local, mat4_multiply_vector(motion, inv), out_result)) {
+        if (out_result) {
+            model_sweep_to_world(world, out_result);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool model_sweep_obb(const Model* model, OBB obb, vec3 motion, RaycastResult* out_result) {
+    mat4 world = model_get_world_matrix(model);
+    mat4 inv = mat4_inverse(world);
+
+    OBB local;
+    local.size = obb.size;
+    local.position = MultiplyPoint(obb.position, inv);
+    local.orientation = mat3_mul(obb.orientation, mat4_cut(inv, 3, 3));
+
+    if (model->content != NULL && mesh_sweep_obb(model->content, local, mat4_multiply_vector(motion, inv), out_result)) {
+        if (out_result) {
+            model_sweep_to_world(world, out_result);
+        }
+        return true;
+    }
+    return false;
+}
+
 #ifndef NO_EXTRAS
 float raycast_model(const Model* model, Ray3D ray) {
     return model_ray(model, ray);
@@ -1,6 +1,6 @@
 /**
  * @file geom3d_primitives.c
- * @brief Basic primitive operations (Line3D, Ray3D, AABB, Plane)
+ * @brief Basic primitive operations (Line3D, Ray3D, AABB, OBB, Capsule, Plane)
  */
 #include "geom3d_primitives.h"
 
@@ -57,6 +57,51 @@ AABB aabb_from_min_max(vec3 min, vec3 max) {
     );
 }
 
+AABB aabb_swept(AABB aabb, vec3 motion) {
+    vec3 half = vec3_scale(motion, 0.5f);
+    return aabb_create(
+        vec3_add(aabb.position, half),
+        vec3_add(aabb.size, vec3_make(fabsf(half.x), fabsf(half.y), fabsf(half.z)))
+    );
+}
+
+/*******************************************************************************
+ * OBB Operations
+ ******************************************************************************/
+
+AABB obb_get_bounds(OBB obb) {
+    vec3 extent = vec3_make(0, 0, 0);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            extent.v[j] += fabsf(obb.orientation.m[i][j]) * obb.size.v[i];
+        }
+    }
+    return aabb_create(obb.position, extent);
+}
+
+/*******************************************************************************
+ * Capsule Operations
+ ******************************************************************************/
+
+Line3D capsule_get_segment(Capsule capsule) {
+    return line3d_create(capsule.start, capsule.end);
+}
+
+AABB capsule_get_bounds(Capsule capsule) {
+    vec3 r = vec3_make(capsule.radius, capsule.radius, capsule.radius);
+    vec3 min = vec3_make(
+        fminf(capsule.start.x, capsule.end.x),
+        fminf(capsule.start.y, capsule.end.y),
+        fminf(capsule.start.z, capsule.end.z)
+    );
+    vec3 max = vec3_make(
+        fmaxf(capsule.start.x, capsule.end.x),
+        fmaxf(capsule.start.y, capsule.end.y),
+        fmaxf(capsule.start.z, capsule.end.z)
+    );
+    return aabb_from_min_max(vec3_sub(min, r), vec3_add(max, r));
+}
+
 /*******************************************************************************
  * Plane Operations
  ******************************************************************************/
@@ -134,4 +179,10 @@ void obb_print(FILE* stream, OBB shape) {
     fprintf(stream, "z basis: (%.4f, %.4f, %.4f)",
             shape.orientation.m[0][2], shape.orientation.m[1][2], shape.orientation.m[2][2]);
 }
+
+void capsule_print(FILE* stream, Capsule shape) {
+    fprintf(stream, "start: (%.4f, %.4f, %.4f), end: (%.4f, %.4f, %.4f), radius: %.4f",
+            shape.start.x, shape.start.y, shape.start.z,
+            shape.end.x, shape.end.y, shape.end.z, shape.radius);
+}
 #endif
\ No newline at end of file
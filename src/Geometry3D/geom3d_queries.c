@@ -7,6 +7,7 @@
 #include "compare.h"
 
 #include <math.h>
+#include <float.h>
 
 /*******************************************************************************
  * Point Containment Tests
@@ -86,6 +87,12 @@ bool point_in_triangle(Point3D p, Triangle t) {
     return true;
 }
 
+bool point_in_capsule(Point3D point, Capsule capsule) {
+    Point3D closest = closest_point_on_line3d(line3d_create(capsule.start, capsule.end), point);
+    float dist_sq = vec3_magnitude_sq(vec3_sub(point, closest));
+    return dist_sq < capsule.radius * capsule.radius;
+}
+
 #ifndef NO_EXTRAS
 bool point_in_plane(Point3D point, Plane plane) {
     return point_on_plane(point, plane);
@@ -160,7 +167,11 @@ Point3D closest_point_on_plane(Plane plane, Point3D point) {
 
 Point3D closest_point_on_line3d(Line3D line, Point3D point) {
     vec3 line_vec = vec3_sub(line.end, line.start);
-    float t = vec3_dot(vec3_sub(point, line.start), line_vec) / vec3_dot(line_vec, line_vec);
+    float len_sq = vec3_dot(line_vec, line_vec);
+    if (len_sq == 0.0f) {
+        return line.start;
+    }
+    float t = vec3_dot(vec3_sub(point, line.start), line_vec) / len_sq;
     t = fmaxf(t, 0.0f);
     t = fminf(t, 1.0f);
     return vec3_add(line.start, vec3_scale(line_vec, t));
@@ -188,11 +199,131 @@ Point3D closest_point_on_triangle(Triangle t, Point3D p) {
     float mag_sq2 = vec3_magnitude_sq(vec3_sub(closest, c2));
     float mag_sq3 = vec3_magnitude_sq(vec3_sub(closest, c3));
 
-    if (mag_sq1 < mag_sq2 && mag_sq1 < mag_sq3) {
+    /* Ties happen in vertex regions, where two edges share the closest point */
+    if (mag_sq1 <= mag_sq2 && mag_sq1 <= mag_sq3) {
         return c1;
     }
-    else if (mag_sq2 < mag_sq1 && mag_sq2 < mag_sq3) {
+    else if (mag_sq2 <= mag_sq3) {
         return c2;
     }
     return c3;
-}
\ No newline at end of file
+}
+
+float closest_points_line3d_line3d(Line3D l1, Line3D l2, Point3D* out_p1, Point3D* out_p2) {
+    /* Ericson, Real-Time Collision Detection 5.1.9 */
+    vec3 d1 = vec3_sub(l1.end, l1.start);
+    vec3 d2 = vec3_sub(l2.end, l2.start);
+    vec3 r = vec3_sub(l1.start, l2.start);
+    float a = vec3_dot(d1, d1);
+    float e = vec3_dot(d2, d2);
+    float f = vec3_dot(d2, r);
+    float s = 0.0f;
+    float t = 0.0f;
+
+    if (a <= FLT_EPSILON && e <= FLT_EPSILON) {
+        s = t = 0.0f;
+    }
+    else if (a <= FLT_EPSILON) {
+        t = fminf(fmaxf(f / e, 0.0f), 1.0f);
+    }
+    else {
+        float c = vec3_dot(d1, r);
+        if (e <= FLT_EPSILON) {
+            s = fminf(fmaxf(-c / a, 0.0f), 1.0f);
+        }
+        else {
+            float b = vec3_dot(d1, d2);
+            float denom = a * e - b * b;
+
+            if (denom != 0.0f) {
+                s = fminf(fmaxf((b * f - c * e) / denom, 0.0f), 1.0f);
+            }
+            t = (b * s + f) / e;
+
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = fminf(fmaxf(-c / a, 0.0f), 1.0f);
+            }
+            else if (t > 1.0f) {
+                t = 1.0f;
+                s = fminf(fmaxf((b - c) / a, 0.0f), 1.0f);
+            }
+        }
+    }
+
+    Point3D p1 = vec3_add(l1.start, vec3_scale(d1, s));
+    Point3D p2 = vec3_add(l2.start, vec3_scale(d2, t));
+    if (out_p1 != NULL) {
+        *out_p1 = p1;
+    }
+    if (out_p2 != NULL) {
+        *out_p2 = p2;
+    }
+    return vec3_magnitude_sq(vec3_sub(p1, p2));
+}
+
+Point3D closest_point_on_capsule(Capsule capsule, Point3D point) {
+    Point3D axis = closest_point_on_line3d(line3d_create(capsule.start, capsule.end), point);
+    vec3 dir = vec3_sub(point, axis);
+    if (vec3_magnitude_sq(dir) <= 0.0f) {
+        /* On the axis every direction is equally close; take one across it */
+        vec3 d = vec3_sub(capsule.end, capsule.start);
+        dir = vec3_cross(d, fabsf(d.x) <= fabsf(d.y) ? vec3_make(1, 0, 0) : vec3_make(0, 1, 0));
+        if (vec3_magnitude_sq(dir) <= 0.0f) {
+            dir = vec3_make(0, 1, 0);
+        }
+    }
+    dir = vec3_normalized(dir);
+    return vec3_add(axis, vec3_scale(dir, capsule.radius));
+}
+
+float closest_points_line3d_triangle(Line3D line, Triangle triangle, Point3D* out_line, Point3D* out_triangle) {
+    Point3D best_line = line.start;
+    Point3D best_triangle = line.start;
+    float best = FLT_MAX;
+
+    /* A segment piercing the triangle touches it */
+    vec3 n = vec3_cross(vec3_sub(triangle.b, triangle.a), vec3_sub(triangle.c, triangle.a));
+    float d0 = vec3_dot(n, vec3_sub(line.start, triangle.a));
+    float d1 = vec3_dot(n, vec3_sub(line.end, triangle.a));
+    if (d0 != d1 && ((d0 <= 0.0f && d1 >= 0.0f) || (d0 >= 0.0f && d1 <= 0.0f))) {
+        float t = d0 / (d0 - d1);
+        Point3D p = vec3_add(line.start, vec3_scale(vec3_sub(line.end, line.start), t));
+        if (point_in_triangle(p, triangle)) {
+            best = 0.0f;
+            best_line = best_triangle = p;
+        }
+    }
+
+    /* Otherwise the minimum is at an endpoint or against a triangle edge */
+    if (best > 0.0f) {
+        const Point3D ends[2] = { line.start, line.end };
+        for (int i = 0; i < 2; ++i) {
+            Point3D q = closest_point_on_triangle(triangle, ends[i]);
+            float d = vec3_magnitude_sq(vec3_sub(q, ends[i]));
+            if (d < best) {
+                best = d;
+                best_line = ends[i];
+                best_triangle = q;
+            }
+        }
+        for (int i = 0; i < 3; ++i) {
+            Point3D p1, p2;
+            Line3D edge = line3d_create(triangle.points[i], triangle.points[(i + 1) % 3]);
+            float d = closest_points_line3d_line3d(line, edge, &p1, &p2);
+            if (d < best) {
+                best = d;
+                best_line = p1;
+                best_triangle = p2;
+            }
+        }
+    }
+
+    if (out_line != NULL) {
+        *out_line = best_line;
+    }
+    if (out_triangle != NULL) {
+        *out_triangle = best_triangle;
+    }
+    return best;
+}
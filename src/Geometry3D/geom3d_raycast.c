@@ -10,6 +10,7 @@
 #include "compare.h"
 
 #include <math.h>
+#include <float.h>
 
 /*******************************************************************************
  * Raycasting
@@ -187,6 +188,72 @@ bool raycast_triangle(Triangle triangle, Ray3D ray, RaycastResult* out_result) {
     return false;
 }
 
+/* Nearest non-negative root of the cylinder body or either end cap */
+bool raycast_capsule(Capsule capsule, Ray3D ray, RaycastResult* out_result) {
+    raycast_result_reset(out_result);
+
+    vec3 ba = vec3_sub(capsule.end, capsule.start);
+    vec3 oa = vec3_sub(ray.origin, capsule.start);
+    float baba = vec3_dot(ba, ba);
+    float bard = vec3_dot(ba, ray.direction);
+    float baoa = vec3_dot(ba, oa);
+    float rdoa = vec3_dot(ray.direction, oa);
+    float oaoa = vec3_dot(oa, oa);
+    float r_sq = capsule.radius * capsule.radius;
+    float t_best = FLT_MAX;
+
+    /* Body: infinite cylinder restricted to 0 < y < |ba|^2 */
+    float a = baba - bard * bard;
+    if (a > 1.0e-6f * baba) {
+        float b = baba * rdoa - baoa * bard;
+        float c = baba * oaoa - baoa * baoa - r_sq * baba;
+        float h = b * b - a * c;
+        if (h >= 0.0f) {
+            float sq = sqrtf(h);
+            float roots[2] = { (-b - sq) / a, (-b + sq) / a };
+            for (int i = 0; i < 2; ++i) {
+                float y = baoa + roots[i] * bard;
+                if (roots[i] >= 0.0f && y > 0.0f && y < baba && roots[i] < t_best) {
+                    t_best = roots[i];
+                }
+            }
+        }
+    }
+
+    /* Caps: the start sphere covers y <= 0, the end sphere y >= |ba|^2 */
+    for (int cap = 0; cap < 2; ++cap) {
+        vec3 oc = vec3_sub(ray.origin, cap == 0 ? capsule.start : capsule.end);
+        float b = vec3_dot(ray.direction, oc);
+        float h = b * b - (vec3_dot(oc, oc) - r_sq);
+        if (h < 0.0f) {
+            continue;
+        }
+        float sq = sqrtf(h);
+        float roots[2] = { -b - sq, -b + sq };
+        for (int i = 0; i < 2; ++i) {
+            float y = baoa + roots[i] * bard;
+            bool on_cap = cap == 0 ? y <= 0.0f : y >= baba;
+            if (roots[i] >= 0.0f && on_cap && roots[i] < t_best) {
+                t_best = roots[i];
+            }
+        }
+    }
+
+    if (t_best == FLT_MAX) {
+        return false;
+    }
+
+    if (out_result) {
+        Point3D point = vec3_add(ray.origin, vec3_scale(ray.direction, t_best));
+        Point3D axis = closest_point_on_line3d(line3d_create(capsule.start, capsule.end), point);
+        out_result->t = t_best;
+        out_result->hit = true;
+        out_result->point = point;
+        out_result->normal = vec3_normalized(vec3_sub(point, axis));
+    }
+    return true;
+}
+
 /*******************************************************************************
  * Line Tests
  ******************************************************************************/
@@ -241,4 +308,9 @@ bool linetest_triangle(Triangle triangle, Line3D line) {
     }
     float t = raycast.t;
     return t >= 0 && t * t <= line3d_length_sq(line);
-}
\ No newline at end of file
+}
+
+bool linetest_capsule(Capsule capsule, Line3D line) {
+    float dist_sq = closest_points_line3d_line3d(line, line3d_create(capsule.start, capsule.end), NULL, NULL);
+    return dist_sq < capsule.radius * capsule.radius;
+}
@@ -7,6 +7,7 @@
 #include "compare.h"
 
 #include <math.h>
+#include <float.h>
 
 /*******************************************************************************
  * Interval / SAT Functions
@@ -25,57 +26,28 @@ Interval3D interval3d_from_triangle(Triangle triangle, vec3 axis) {
     return result;
 }
 
+/* Centre projection plus the box's projected radius: no vertices needed */
 Interval3D interval3d_from_aabb(AABB aabb, vec3 axis) {
-    vec3 mn = aabb_get_min(aabb);
-    vec3 mx = aabb_get_max(aabb);
-
-    vec3 vertices[8];
-    vertices[0] = vec3_make(mn.x, mx.y, mx.z);
-    vertices[1] = vec3_make(mn.x, mx.y, mn.z);
-    vertices[2] = vec3_make(mn.x, mn.y, mx.z);
-    vertices[3] = vec3_make(mn.x, mn.y, mn.z);
-    vertices[4] = vec3_make(mx.x, mx.y, mx.z);
-    vertices[5] = vec3_make(mx.x, mx.y, mn.z);
-    vertices[6] = vec3_make(mx.x, mn.y, mx.z);
-    vertices[7] = vec3_make(mx.x, mn.y, mn.z);
+    float center = vec3_dot(axis, aabb.position);
+    float radius = aabb.size.x * fabsf(axis.x) + aabb.size.y * fabsf(axis.y) + aabb.size.z * fabsf(axis.z);
 
     Interval3D result;
-    result.min = result.max = vec3_dot(axis, vertices[0]);
-
-    for (int i = 1; i < 8; ++i) {
-        float proj = vec3_dot(axis, vertices[i]);
-        result.min = fminf(result.min, proj);
-        result.max = fmaxf(result.max, proj);
-    }
+    result.min = center - radius;
+    result.max = center + radius;
     return result;
 }
 
 Interval3D interval3d_from_obb(OBB obb, vec3 axis) {
-    vec3 C = obb.position;
-    vec3 E = obb.size;
-    vec3 A[3];
-    A[0] = vec3_make(obb.orientation.m[0][0], obb.orientation.m[0][1], obb.orientation.m[0][2]);
-    A[1] = vec3_make(obb.orientation.m[1][0], obb.orientation.m[1][1], obb.orientation.m[1][2]);
-    A[2] = vec3_make(obb.orientation.m[2][0], obb.orientation.m[2][1], obb.orientation.m[2][2]);
-
-    vec3 vertices[8];
-    vertices[0] = vec3_add(vec3_add(vec3_add(C, vec3_scale(A[0], E.v[0])), vec3_scale(A[1], E.v[1])), vec3_scale(A[2], E.v[2]));
-    vertices[1] = vec3_add(vec3_add(vec3_sub(C, vec3_scale(A[0], E.v[0])), vec3_scale(A[1], E.v[1])), vec3_scale(A[2], E.v[2]));
-    vertices[2] = vec3_add(vec3_sub(vec3_add(C, vec3_scale(A[0], E.v[0])), vec3_scale(A[1], E.v[1])), vec3_scale(A[2], E.v[2]));
-    vertices[3] = vec3_sub(vec3_add(vec3_add(C, vec3_scale(A[0], E.v[0])), vec3_scale(A[1], E.v[1])), vec3_scale(A[2], E.v[2]));
-    vertices[4] = vec3_sub(vec3_sub(vec3_sub(C, vec3_scale(A[0], E.v[0])), vec3_scale(A[1], E.v[1])), vec3_scale(A[2], E.v[2]));
-    vertices[5] = vec3_sub(vec3_sub(vec3_add(C, vec3_scale(A[0], E.v[0])), vec3_scale(A[1], E.v[1])), vec3_scale(A[2], E.v[2]));
-    vertices[6] = vec3_sub(vec3_add(vec3_sub(C, vec3_scale(A[0], E.v[0])), vec3_scale(A[1], E.v[1])), vec3_scale(A[2], E.v[2]));
-    vertices[7] = vec3_add(vec3_sub(vec3_sub(C, vec3_scale(A[0], E.v[0])), vec3_scale(A[1], E.v[1])), vec3_scale(A[2], E.v[2]));
+    float center = vec3_dot(axis, obb.position);
+    float radius = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        float d = obb.orientation.m[i][0] * axis.x + obb.orientation.m[i][1] * axis.y + obb.orientation.m[i][2] * axis.z;
+        radius += obb.size.v[i] * fabsf(d);
+    }
 
     Interval3D result;
-    result.min = result.max = vec3_dot(axis, vertices[0]);
-
-    for (int i = 1; i < 8; ++i) {
-        float proj = vec3_dot(axis, vertices[i]);
-        result.min = fminf(result.min, proj);
-        result.max = fmaxf(result.max, proj);
-    }
+    result.min = center - radius;
+    result.max = center + radius;
     return result;
 }
 
@@ -109,6 +81,104 @@ bool overlap_on_axis_triangle_triangle(Triangle t1, Triangle t2, vec3 axis) {
     return (b.min <= a.max) && (a.min <= b.max);
 }
 
+/*
+ * Gottschalk's test works in A's frame: R[i][j] = a_i . b_j, and each of the
+ * 15 axes gets both projected radii in closed form from |R|. The epsilon on
+ * |R| (OBB_SAT_EPSILON) keeps near-parallel edge pairs (cross product ~ 0)
+ * from separating.
+ */
+bool obb_obb_sat(OBB a, OBB b, vec3* out_normal, float* out_depth) {
+    float R[3][3], AbsR[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            R[i][j] = a.orientation.m[i][0] * b.orientation.m[j][0] +
+                      a.orientation.m[i][1] * b.orientation.m[j][1] +
+                      a.orientation.m[i][2] * b.orientation.m[j][2];
+            AbsR[i][j] = fabsf(R[i][j]) + OBB_SAT_EPSILON;
+        }
+    }
+
+    vec3 d = vec3_sub(b.position, a.position);
+    float t[3];
+    for (int i = 0; i < 3; ++i) {
+        t[i] = a.orientation.m[i][0] * d.x + a.orientation.m[i][1] * d.y + a.orientation.m[i][2] * d.z;
+    }
+
+    const float* ea = a.size.v;
+    const float* eb = b.size.v;
+    bool track = out_normal != NULL || out_depth != NULL;
+    float min_depth = FLT_MAX;
+    vec3 min_axis = vec3_make(0, 0, 0);
+    float min_sign = 1.0f;
+
+    /* A's face axes */
+    for (int i = 0; i < 3; ++i) {
+        float rb = eb[0] * AbsR[i][0] + eb[1] * AbsR[i][1] + eb[2] * AbsR[i][2];
+        float depth = ea[i] + rb - fabsf(t[i]);
+        if (depth < 0.0f) {
+            return false;
+        }
+        if (track && depth < min_depth) {
+            min_depth = depth;
+            min_axis = vec3_make(a.orientation.m[i][0], a.orientation.m[i][1], a.orientation.m[i][2]);
+            min_sign = t[i];
+        }
+    }
+
+    /* B's face axes */
+    for (int j = 0; j < 3; ++j) {
+        float ra = ea[0] * AbsR[0][j] + ea[1] * AbsR[1][j] + ea[2] * AbsR[2][j];
+        float dist = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+        float depth = ra + eb[j] - fabsf(dist);
+        if (depth < 0.0f) {
+            return false;
+        }
+        if (track && depth < min_depth) {
+            min_depth = depth;
+            min_axis = vec3_make(b.orientation.m[j][0], b.orientation.m[j][1], b.orientation.m[j][2]);
+            min_sign = dist;
+        }
+    }
+
+    /* Edge-edge axes a_i x b_j, of length sqrt(1 - R[i][j]^2) */
+    for (int i = 0; i < 3; ++i) {
+        int i1 = (i + 1) % 3;
+        int i2 = (i + 2) % 3;
+        for (int j = 0; j < 3; ++j) {
+            int j1 = (j + 1) % 3;
+            int j2 = (j + 2) % 3;
+            float ra = ea[i1] * AbsR[i2][j] + ea[i2] * AbsR[i1][j];
+            float rb = eb[j1] * AbsR[i][j2] + eb[j2] * AbsR[i][j1];
+            float dist = t[i2] * R[i1][j] - t[i1] * R[i2][j];
+            float overlap = ra + rb - fabsf(dist);
+            if (overlap < 0.0f) {
+                return false;
+            }
+
+            float len_sq = 1.0f - R[i][j] * R[i][j];
+            if (!track || len_sq <= OBB_SAT_EPSILON) {
+                continue;
+            }
+            float len = sqrtf(len_sq);
+            if (overlap < min_depth * len) {
+                vec3 ai = vec3_make(a.orientation.m[i][0], a.orientation.m[i][1], a.orientation.m[i][2]);
+                vec3 bj = vec3_make(b.orientation.m[j][0], b.orientation.m[j][1], b.orientation.m[j][2]);
+                min_depth = overlap / len;
+                min_axis = vec3_scale(vec3_cross(ai, bj), 1.0f / len);
+                min_sign = dist;
+            }
+        }
+    }
+
+    if (out_normal != NULL) {
+        *out_normal = min_sign < 0.0f ? vec3_scale(min_axis, -1.0f) : min_axis;
+    }
+    if (out_depth != NULL) {
+        *out_depth = min_depth;
+    }
+    return true;
+}
+
 /*******************************************************************************
  * Triangle Utilities
  ******************************************************************************/
@@ -0,0 +1,310 @@
+/**
+ * @file geom3d_sweep.c
+ * @brief Swept shape casts and continuous collision (time of impact)
+ */
+#include "geom3d_sweep.h"
+#include "geom3d_queries.h"
+#include "geom3d_raycast.h"
+#include "geom3d_arrays.h"
+
+#include <math.h>
+#include <float.h>
+
+/*******************************************************************************
+ * Plane Culling
+ ******************************************************************************/
+
+/*
+ * True when a shape with extent radius around the points p / q stays on one
+ * side of the triangle's plane (n unit) for the whole motion.
+ */
+static bool sweep_clears_plane(Triangle triangle, vec3 n, Point3D p, Point3D q, float radius, vec3 motion) {
+    float dp = vec3_dot(n, vec3_sub(p, triangle.a));
+    float dq = vec3_dot(n, vec3_sub(q, triangle.a));
+    float dm = vec3_dot(n, motion);
+    float lo = fminf(fminf(dp, dq), fminf(dp, dq) + dm);
+    float hi = fmaxf(fmaxf(dp, dq), fmaxf(dp, dq) + dm);
+    return lo > radius || hi < -radius;
+}
+
+static vec3 triangle_unit_normal(Triangle triangle, bool* out_valid) {
+    vec3 n = vec3_cross(vec3_sub(triangle.b, triangle.a), vec3_sub(triangle.c, triangle.a));
+    float n_len = vec3_magnitude(n);
+    *out_valid = n_len > 0.0f;
+    return *out_valid ? vec3_scale(n, 1.0f / n_len) : n;
+}
+
+/*******************************************************************************
+ * Sphere Casts
+ ******************************************************************************/
+
+bool sweep_sphere_triangle(Sphere sphere, vec3 motion, Triangle triangle, RaycastResult* out_result) {
+    raycast_result_reset(out_result);
+
+    bool valid;
+    vec3 n = triangle_unit_normal(triangle, &valid);
+    if (valid && vec3_dot(n, vec3_sub(sphere.position, triangle.a)) < 0.0f) {
+        n = vec3_scale(n, -1.0f);
+    }
+
+    if (valid && sweep_clears_plane(triangle, n, sphere.position, sphere.position, sphere.radius, motion)) {
+        return false;
+    }
+
+    Point3D closest = closest_point_on_triangle(triangle, sphere.position);
+    vec3 diff = vec3_sub(sphere.position, closest);
+    float dist_sq = vec3_magnitude_sq(diff);
+    if (dist_sq <= sphere.radius * sphere.radius) {
+        if (out_result) {
+            out_result->t = 0.0f;
+            out_result->hit = true;
+            out_result->point = closest;
+            out_result->normal = dist_sq > 1.0e-12f ? vec3_scale(diff, 1.0f / sqrtf(dist_sq))
+                : valid ? n : vec3_normalized(vec3_scale(motion, -1.0f));
+        }
+        return true;
+    }
+
+    float length = vec3_magnitude(motion);
+    if (length == 0.0f) {
+        return false;
+    }
+    Ray3D ray = { sphere.position, vec3_scale(motion, 1.0f / length) };
+
+    float t_best = FLT_MAX;
+    vec3 normal = n;
+
+    /* Face: the plane pushed out by the radius, hit inside the triangle */
+    if (valid) {
+        float dist = vec3_dot(n, vec3_sub(sphere.position, triangle.a));
+        float closing = -vec3_dot(n, ray.direction);
+        if (dist >= sphere.radius && closing > 0.0f) {
+            float t = (dist - sphere.radius) / closing;
+            Point3D p = vec3_sub(vec3_add(ray.origin, vec3_scale(ray.direction, t)), vec3_scale(n, sphere.radius));
+            if (t <= length && point_in_triangle(p, triangle)) {
+                t_best = t;
+            }
+        }
+    }
+
+    /* Edges and vertices: the capsules around the three edges */
+    for (int i = 0; i < 3; ++i) {
+        Capsule edge = capsule_create(triangle.points[i], triangle.points[(i + 1) % 3], sphere.radius);
+        RaycastResult raycast;
+        if (raycast_capsule(edge, ray, &raycast) && raycast.t <= length && raycast.t < t_best) {
+            t_best = raycast.t;
+            normal = raycast.normal;
+        }
+    }
+
+    if (t_best == FLT_MAX) {
+        return false;
+    }
+
+    if (out_result) {
+        Point3D center = vec3_add(ray.origin, vec3_scale(ray.direction, t_best));
+        out_result->t = t_best / length;
+        out_result->hit = true;
+        out_result->point = vec3_sub(center, vec3_scale(normal, sphere.radius));
+        out_result->normal = normal;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Convex Casts
+ ******************************************************************************/
+
+/* Wraps a shape so GJK sees it at its current position along the cast */
+typedef struct TranslatedShape {
+    ConvexShape shape;
+    vec3        offset;
+} TranslatedShape;
+
+static vec3 support_translated(const void* shape, vec3 direction) {
+    const TranslatedShape* moved = (const TranslatedShape*)shape;
+    return vec3_add(moved->shape.support(moved->shape.data, direction), moved->offset);
+}
+
+/*
+ * Under pure translation the separation d(t) is convex, so stepping by
+ * d / (closing speed along the GJK normal) never passes the first contact.
+ */
+bool shape_cast(ConvexShape shape, vec3 motion, ConvexShape target, RaycastResult* out_result) {
+    raycast_result_reset(out_result);
+
+    TranslatedShape moved = { shape, vec3_make(0, 0, 0) };
+    ConvexShape a = convex_shape_create(support_translated, &moved, shape.margin);
+
+    GJKCache cache;
+    gjk_cache_init(&cache);
+
+    GJKResult result;
+    float t = 0.0f;
+
+    /*
+     * Out of iterations, t is still a lower bound on the impact, so it is
+     * reported as the hit rather than letting the shape pass through.
+     */
+    for (int i = 0; ; ++i) {
+        moved.offset = vec3_scale(motion, t);
+        if (gjk_query(a, target, &cache, &result) || result.distance <= SWEEP_TOLERANCE ||
+            i == SWEEP_MAX_ITERATIONS) {
+            break;
+        }
+
+        float closing = vec3_dot(motion, result.normal);
+        if (closing <= 0.0f) {
+            return false;
+        }
+
+        t += result.distance / closing;
+        if (t > 1.0f) {
+            return false;
+        }
+    }
+
+    if (out_result) {
+        out_result->t = t;
+        out_result->hit = true;
+        out_result->point = result.point_b;
+        out_result->normal = vec3_scale(result.normal, -1.0f);
+    }
+    return true;
+}
+
+bool sweep_capsule_triangle(Capsule capsule, vec3 motion, Triangle triangle, RaycastResult* out_result) {
+    bool valid;
+    vec3 n = triangle_unit_normal(triangle, &valid);
+    if (valid && sweep_clears_plane(triangle, n, capsule.start, capsule.end, capsule.radius, motion)) {
+        raycast_result_reset(out_result);
+        return false;
+    }
+    return shape_cast(convex_shape_capsule(&capsule), motion, convex_shape_triangle(&triangle), out_result);
+}
+
+bool sweep_obb_triangle(OBB obb, vec3 motion, Triangle triangle, RaycastResult* out_result) {
+    bool valid;
+    vec3 n = triangle_unit_normal(triangle, &valid);
+    if (valid) {
+        float radius = 0.0f;
+        for (int i = 0; i < 3; ++i) {
+            vec3 axis = vec3_make(obb.orientation.m[i][0], obb.orientation.m[i][1], obb.orientation.m[i][2]);
+            radius += fabsf(vec3_dot(n, axis)) * obb.size.v[i];
+        }
+        if (sweep_clears_plane(triangle, n, obb.position, obb.position, radius, motion)) {
+            raycast_result_reset(out_result);
+            return false;
+        }
+    }
+    return shape_cast(convex_shape_obb(&obb), motion, convex_shape_triangle(&triangle), out_result);
+}
+
+/*******************************************************************************
+ * Continuous Collision
+ ******************************************************************************/
+
+/* Body-space shape placed at a pose; rows of orientation are the body axes */
+typedef struct PosedShape {
+    ConvexShape shape;
+    Point3D     position;
+    mat3        orientation;
+} PosedShape;
+
+static vec3 support_posed(const void* shape, vec3 direction) {
+    const PosedShape* posed = (const PosedShape*)shape;
+    vec3 local = mat3_multiply_vector(direction, mat3_transpose(posed->orientation));
+    vec3 p = posed->shape.support(posed->shape.data, local);
+    return vec3_add(posed->position, mat3_multiply_vector(p, posed->orientation));
+}
+
+/* Bounds the distance of any shape point from the body origin (corner of the support box) */
+static float body_radius(ConvexShape shape) {
+    float r_sq = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        vec3 axis = vec3_make(0, 0, 0);
+        axis.v[i] = 1.0f;
+        float hi = shape.support(shape.data, axis).v[i];
+        float lo = shape.support(shape.data, vec3_scale(axis, -1.0f)).v[i];
+        float extent = fmaxf(fabsf(hi), fabsf(lo));
+        r_sq += extent * extent;
+    }
+    return sqrtf(r_sq) + shape.margin;
+}
+
+void rigid_motion_pose(const RigidMotion* motion, float t, Point3D* out_position, mat3* out_orientation) {
+    *out_position = vec3_add(motion->position, vec3_scale(motion->linear_velocity, t));
+
+    float speed = vec3_magnitude(motion->angular_velocity);
+    if (speed * t == 0.0f) {
+        *out_orientation = motion->orientation;
+    }
+    else {
+        mat3 rotation = AxisAngle3x3(motion->angular_velocity, RAD2DEG(speed * t));
+        *out_orientation = mat3_mul(motion->orientation, rotation);
+    }
+}
+
+/*
+ * The separation can shrink no faster than the relative linear velocity
+ * along the current normal plus |w| * radius for each body, so advancing
+ * by distance / that bound never steps past the first contact.
+ */
+bool time_of_impact(ConvexShape a, const RigidMotion* motion_a,
+                    ConvexShape b, const RigidMotion* motion_b,
+                    float dt, RaycastResult* out_result) {
+    raycast_result_reset(out_result);
+
+    PosedShape posed_a = { a, motion_a->position, motion_a->orientation };
+    PosedShape posed_b = { b, motion_b->position, motion_b->orientation };
+    ConvexShape shape_a = convex_shape_create(support_posed, &posed_a, a.margin);
+    ConvexShape shape_b = convex_shape_create(support_posed, &posed_b, b.margin);
+
+    float angular_bound = vec3_magnitude(motion_a->angular_velocity) * body_radius(a) +
+                          vec3_magnitude(motion_b->angular_velocity) * body_radius(b);
+    vec3 relative_velocity = vec3_sub(motion_a->linear_velocity, motion_b->linear_velocity);
+
+    GJKCache cache;
+    gjk_cache_init(&cache);
+
+    GJKResult result;
+    float t = 0.0f;
+
+    /* As in shape_cast, running out of iterations reports the lower bound t */
+    for (int i = 0; ; ++i) {
+        rigid_motion_pose(motion_a, t, &posed_a.position, &posed_a.orientation);
+        rigid_motion_pose(motion_b, t, &posed_b.position, &posed_b.orientation);
+        if (gjk_query(shape_a, shape_b, &cache, &result) || result.distance <= SWEEP_TOLERANCE ||
+            i == CCD_MAX_ITERATIONS) {
+            break;
+        }
+
+        float closing = vec3_dot(relative_velocity, result.normal) + angular_bound;
+        if (closing <= 0.0f) {
+            return false;
+        }
+
+        t += result.distance / closing;
+        if (t > dt) {
+            return false;
+        }
+    }
+
+    if (out_result) {
+        out_result->t = t;
+        out_result->hit = true;
+        out_result->point = result.point_b;
+        out_result->normal = vec3_scale(result.normal, -1.0f);
+    }
+    return true;
+}
+
+bool time_of_impact_obb_obb(OBB a, vec3 linear_a, vec3 angular_a,
+                            OBB b, vec3 linear_b, vec3 angular_b,
+                            float dt, RaycastResult* out_result) {
+    AABB box_a = aabb_create(vec3_make(0, 0, 0), a.size);
+    AABB box_b = aabb_create(vec3_make(0, 0, 0), b.size);
+    RigidMotion motion_a = rigid_motion_create(a.position, a.orientation, linear_a, angular_a);
+    RigidMotion motion_b = rigid_motion_create(b.position, b.orientation, linear_b, angular_b);
+    return time_of_impact(convex_shape_aabb(&box_a), &motion_a, convex_shape_aabb(&box_b), &motion_b, dt, out_result);
+}
@@ -0,0 +1,678 @@
+#include "body.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * Storage
+ * ============================================================
+ */
+
+/*
+ * position 3, orientation 4, velocity 3, rotation 3, acceleration 3,
+ * inverse_mass 1, inverse_inertia_tensor 9, damping 2, accumulators 6,
+ * transform 12, inverse_inertia_tensor_world 9, last_frame_acceleration 3,
+ * motion 1, damping factors 2
+ */
+#define BODY_REAL_ARRAY_COUNT 61
+
+/* Every real array in a fixed order, so growth and free stay in sync */
+static void body_real_arrays(cyclone_BodyWorld *world, real ***out)
+{
+    size_t n = 0;
+    for (int k = 0; k < 3; ++k)  out[n++] = &world->position[k];
+    for (int k = 0; k < 4; ++k)  out[n++] = &world->orientation[k];
+    for (int k = 0; k < 3; ++k)  out[n++] = &world->velocity[k];
+    for (int k = 0; k < 3; ++k)  out[n++] = &world->rotation[k];
+    for (int k = 0; k < 3; ++k)  out[n++] = &world->acceleration[k];
+    out[n++] = &world->inverse_mass;
+    for (int k = 0; k < 9; ++k)  out[n++] = &world->inverse_inertia_tensor[k];
+    out[n++] = &world->linear_damping;
+    out[n++] = &world->angular_damping;
+    for (int k = 0; k < 3; ++k)  out[n++] = &world->force_accum[k];
+    for (int k = 0; k < 3; ++k)  out[n++] = &world->torque_accum[k];
+    for (int k = 0; k < 12; ++k) out[n++] = &world->transform[k];
+    for (int k = 0; k < 9; ++k)  out[n++] = &world->inverse_inertia_tensor_world[k];
+    for (int k = 0; k < 3; ++k)  out[n++] = &world->last_frame_acceleration[k];
+    out[n++] = &world->motion;
+    out[n++] = &world->linear_damping_factor;
+    out[n++] = &world->angular_damping_factor;
+}
+
+void cyclone_body_world_init(cyclone_BodyWorld *world)
+{
+    real **arrays[BODY_REAL_ARRAY_COUNT];
+    body_real_arrays(world, arrays);
+    for (int i = 0; i < BODY_REAL_ARRAY_COUNT; ++i)
+        *arrays[i] = NULL;
+
+    world->is_awake = NULL;
+    world->can_sleep = NULL;
+    world->count = 0;
+    world->capacity = 0;
+    world->sleep_bias = (real)0;
+    world->damping_step = (real)0;
+    world->island_sleep = false;
+}
+
+void cyclone_body_world_free(cyclone_BodyWorld *world)
+{
+    real **arrays[BODY_REAL_ARRAY_COUNT];
+    body_real_arrays(world, arrays);
+    for (int i = 0; i < BODY_REAL_ARRAY_COUNT; ++i)
+        free(*arrays[i]);
+
+    free(world->is_awake);
+    free(world->can_sleep);
+    cyclone_body_world_init(world);
+}
+
+bool cyclone_body_world_reserve(cyclone_BodyWorld *world, size_t capacity)
+{
+    if (capacity <= world->capacity)
+        return true;
+
+    /*
+     * Allocate everything before touching the old arrays so a failure
+     * part way through leaves the world untouched.
+     */
+    real *fresh[BODY_REAL_ARRAY_COUNT];
+    bool *awake = (bool *)malloc(capacity * sizeof(bool));
+    bool *can_sleep = (bool *)malloc(capacity * sizeof(bool));
+    bool ok = awake && can_sleep;
+
+    int allocated = 0;
+    while (ok && allocated < BODY_REAL_ARRAY_COUNT)
+    {
+        fresh[allocated] = (real *)malloc(capacity * sizeof(real));
+        ok = fresh[allocated] != NULL;
+        allocated += ok;
+    }
+
+    if (!ok)
+    {
+        while (allocated-- > 0)
+            free(fresh[allocated]);
+        free(awake);
+        free(can_sleep);
+        return false;
+    }
+
+    real **arrays[BODY_REAL_ARRAY_COUNT];
+    body_real_arrays(world, arrays);
+    for (int i = 0; i < BODY_REAL_ARRAY_COUNT; ++i)
+    {
+        if (world->count > 0)
+            memcpy(fresh[i], *arrays[i], world->count * sizeof(real));
+        free(*arrays[i]);
+        *arrays[i] = fresh[i];
+    }
+
+    if (world->count > 0)
+    {
+        memcpy(awake, world->is_awake, world->count * sizeof(bool));
+        memcpy(can_sleep, world->can_sleep, world->count * sizeof(bool));
+    }
+    free(world->is_awake);
+    free(world->can_sleep);
+    world->is_awake = awake;
+    world->can_sleep = can_sleep;
+
+    world->capacity = capacity;
+    return true;
+}
+
+/* Damping factors for body i at the cached step, if there is one yet */
+static void body_update_damping_factors(cyclone_BodyWorld *world, size_t i)
+{
+    if (world->damping_step > (real)0)
+    {
+        world->linear_damping_factor[i] = real_pow(world->linear_damping[i], world->damping_step);
+        world->angular_damping_factor[i] = real_pow(world->angular_damping[i], world->damping_step);
+    }
+}
+
+static void body_derive_range(cyclone_BodyWorld *world, size_t start, size_t count);
+
+bool cyclone_body_world_add(cyclone_BodyWorld *world,
+                            cyclone_Vector3 position,
+                            cyclone_Quaternion orientation,
+                            real mass,
+                            const cyclone_Matrix3 *inertia_tensor,
+                            size_t *out_index)
+{
+    if (world->count == world->capacity)
+    {
+        size_t capacity = world->capacity ? world->capacity * 2 : 64;
+        if (!cyclone_body_world_reserve(world, capacity))
+            return false;
+    }
+
+    size_t i = world->count++;
+    cyclone_Vector3 zero = cyclone_vector3_zero();
+
+    cyclone_body_world_set_position(world, i, position);
+    cyclone_body_world_set_orientation(world, i, orientation);
+    cyclone_body_world_set_velocity(world, i, zero);
+    cyclone_body_world_set_rotation(world, i, zero);
+    cyclone_body_world_set_acceleration(world, i, zero);
+    cyclone_body_world_set_mass(world, i, mass);
+    cyclone_body_world_set_inertia_tensor(world, i, inertia_tensor);
+
+    for (int k = 0; k < 3; ++k)
+    {
+        world->force_accum[k][i] = (real)0;
+        world->torque_accum[k][i] = (real)0;
+        world->last_frame_acceleration[k][i] = (real)0;
+    }
+
+    world->linear_damping[i] = CYCLONE_BODY_DEFAULT_LINEAR_DAMPING;
+    world->angular_damping[i] = CYCLONE_BODY_DEFAULT_ANGULAR_DAMPING;
+    world->linear_damping_factor[i] = world->linear_damping[i];
+    world->angular_damping_factor[i] = world->angular_damping[i];
+    body_update_damping_factors(world, i);
+
+    world->can_sleep[i] = true;
+    cyclone_body_world_set_awake(world, i, true);
+
+    body_derive_range(world, i, 1);
+
+    if (out_index)
+        *out_index = i;
+    return true;
+}
+
+/* ============================================================
+ * Accessors
+ * ============================================================
+ */
+
+static cyclone_Vector3 body_get(real *const array[3], size_t i)
+{
+    return cyclone_vector3_make(array[0][i], array[1][i], array[2][i]);
+}
+
+static void body_set(real *array[3], size_t i, cyclone_Vector3 v)
+{
+    array[0][i] = v.x;
+    array[1][i] = v.y;
+    array[2][i] = v.z;
+}
+
+cyclone_Vector3 cyclone_body_world_get_position(const cyclone_BodyWorld *world, size_t i)
+{
+    return body_get(world->position, i);
+}
+
+cyclone_Quaternion cyclone_body_world_get_orientation(const cyclone_BodyWorld *world, size_t i)
+{
+    return cyclone_quaternion_make(world->orientation[0][i], world->orientation[1][i],
+                                   world->orientation[2][i], world->orientation[3][i]);
+}
+
+cyclone_Vector3 cyclone_body_world_get_velocity(const cyclone_BodyWorld *world, size_t i)
+{
+    return body_get(world->velocity, i);
+}
+
+cyclone_Vector3 cyclone_body_world_get_rotation(const cyclone_BodyWorld *world, size_t i)
+{
+    return body_get(world->rotation, i);
+}
+
+cyclone_Vector3 cyclone_body_world_get_last_frame_acceleration(const cyclone_BodyWorld *world, size_t i)
+{
+    return body_get(world->last_frame_acceleration, i);
+}
+
+cyclone_Matrix4 cyclone_body_world_get_transform(const cyclone_BodyWorld *world, size_t i)
+{
+    cyclone_Matrix4 m;
+    for (int k = 0; k < 12; ++k)
+        m.data[k] = world->transform[k][i];
+    return m;
+}
+
+cyclone_Matrix3 cyclone_body_world_get_inverse_inertia_tensor_world(const cyclone_BodyWorld *world, size_t i)
+{
+    cyclone_Matrix3 m;
+    for (int k = 0; k < 9; ++k)
+        m.data[k] = world->inverse_inertia_tensor_world[k][i];
+    return m;
+}
+
+void cyclone_body_world_set_position(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 position)
+{
+    body_set(world->position, i, position);
+}
+
+void cyclone_body_world_set_orientation(cyclone_BodyWorld *world, size_t i, cyclone_Quaternion orientation)
+{
+    cyclone_quaternion_normalise(&orientation);
+    world->orientation[0][i] = orientation.r;
+    world->orientation[1][i] = orientation.i;
+    world->orientation[2][i] = orientation.j;
+    world->orientation[3][i] = orientation.k;
+}
+
+void cyclone_body_world_set_velocity(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 velocity)
+{
+    body_set(world->velocity, i, velocity);
+}
+
+void cyclone_body_world_set_rotation(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 rotation)
+{
+    body_set(world->rotation, i, rotation);
+}
+
+void cyclone_body_world_set_acceleration(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 acceleration)
+{
+    body_set(world->acceleration, i, acceleration);
+}
+
+void cyclone_body_world_set_mass(cyclone_BodyWorld *world, size_t i, real mass)
+{
+    world->inverse_mass[i] = mass > (real)0 ? ((real)1) / mass : (real)0;
+}
+
+void cyclone_body_world_set_inertia_tensor(cyclone_BodyWorld *world, size_t i, const cyclone_Matrix3 *inertia_tensor)
+{
+    /* Immovable bodies get a zero inverse tensor so torques do nothing */
+    cyclone_Matrix3 inverse = cyclone_matrix3_zero();
+    if (world->inverse_mass[i] > (real)0)
+        cyclone_matrix3_set_inverse(&inverse, inertia_tensor);
+
+    for (int k = 0; k < 9; ++k)
+        world->inverse_inertia_tensor[k][i] = inverse.data[k];
+}
+
+void cyclone_body_world_set_damping(cyclone_BodyWorld *world, size_t i, real linear, real angular)
+{
+    world->linear_damping[i] = linear;
+    world->angular_damping[i] = angular;
+    body_update_damping_factors(world, i);
+}
+
+bool cyclone_body_world_is_awake(const cyclone_BodyWorld *world, size_t i)
+{
+    return world->is_awake[i];
+}
+
+void cyclone_body_world_set_awake(cyclone_BodyWorld *world, size_t i, bool awake)
+{
+    world->is_awake[i] = awake;
+    if (awake)
+    {
+        /* Enough motion to stop the body falling asleep immediately */
+        world->motion[i] = cyclone_sleep_epsilon * (real)2;
+    }
+    else
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            world->velocity[k][i] = (real)0;
+            world->rotation[k][i] = (real)0;
+            world->force_accum[k][i] = (real)0;
+            world->torque_accum[k][i] = (real)0;
+        }
+    }
+}
+
+void cyclone_body_world_set_can_sleep(cyclone_BodyWorld *world, size_t i, bool can_sleep)
+{
+    world->can_sleep[i] = can_sleep;
+    if (!can_sleep && !world->is_awake[i])
+        cyclone_body_world_set_awake(world, i, true);
+}
+
+/* ============================================================
+ * Forces
+ * ============================================================
+ */
+
+void cyclone_body_world_add_force(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 force)
+{
+    world->force_accum[0][i] += force.x;
+    world->force_accum[1][i] += force.y;
+    world->force_accum[2][i] += force.z;
+    if (!world->is_awake[i])
+        cyclone_body_world_set_awake(world, i, true);
+}
+
+void cyclone_body_world_add_torque(cyclone_BodyWorld *world, size_t i, cyclone_Vector3 torque)
+{
+    world->torque_accum[0][i] += torque.x;
+    world->torque_accum[1][i] += torque.y;
+    world->torque_accum[2][i] += torque.z;
+    if (!world->is_awake[i])
+        cyclone_body_world_set_awake(world, i, true);
+}
+
+void cyclone_body_world_add_force_at_point(cyclone_BodyWorld *world, size_t i,
+                                           cyclone_Vector3 force, cyclone_Vector3 point)
+{
+    cyclone_Vector3 arm = cyclone_vector3_sub(point, cyclone_body_world_get_position(world, i));
+    cyclone_body_world_add_force(world, i, force);
+    cyclone_body_world_add_torque(world, i, cyclone_vector3_cross(arm, force));
+}
+
+void cyclone_body_world_add_force_at_body_point(cyclone_BodyWorld *world, size_t i,
+                                                cyclone_Vector3 force, cyclone_Vector3 point)
+{
+    cyclone_Matrix4 transform = cyclone_body_world_get_transform(world, i);
+    cyclone_Vector3 world_point = cyclone_matrix4_transform(&transform, &point);
+    cyclone_body_world_add_force_at_point(world, i, force, world_point);
+}
+
+/* ============================================================
+ * Derived data
+ * ============================================================
+ */
+
+/*
+ * Bodies are processed in blocks copied to the stack: the compiler knows
+ * local arrays cannot alias, so the loops below vectorise without relying
+ * on restrict through the world's pointer arrays.
+ */
+#define BODY_BLOCK 64
+
+static void body_derive_block(real q[4][BODY_BLOCK],
+                              real p[3][BODY_BLOCK],
+                              real iit[9][BODY_BLOCK],
+                              real t[12][BODY_BLOCK],
+                              real iw[9][BODY_BLOCK],
+                              size_t n)
+{
+    /* Entries of t holding the rotation, in Matrix3 order */
+    static const int rot[9] = { 0, 1, 2, 4, 5, 6, 8, 9, 10 };
+
+    /* cyclone_matrix4_set_orientation_and_pos after normalising */
+    real *orientation[4] = { q[0], q[1], q[2], q[3] };
+    real *rotation[9];
+    for (int k = 0; k < 9; ++k)
+        rotation[k] = t[rot[k]];
+
+    cyclone_quaternion_normalise_batch(orientation, n);
+    cyclone_matrix3_set_orientation_batch(rotation, (const real *const *)orientation, n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        t[3][i]  = p[0][i];
+        t[7][i]  = p[1][i];
+        t[11][i] = p[2][i];
+    }
+
+    /* World inverse inertia: R * I^-1 * R^T, R the rotation part of t */
+    for (size_t i = 0; i < n; ++i)
+    {
+        real a[9];
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int col = 0; col < 3; ++col)
+            {
+                a[row * 3 + col] = t[rot[row * 3 + 0]][i] * iit[0 * 3 + col][i] +
+                                   t[rot[row * 3 + 1]][i] * iit[1 * 3 + col][i] +
+                                   t[rot[row * 3 + 2]][i] * iit[2 * 3 + col][i];
+            }
+        }
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int col = 0; col < 3; ++col)
+            {
+                iw[row * 3 + col][i] = a[row * 3 + 0] * t[rot[col * 3 + 0]][i] +
+                                       a[row * 3 + 1] * t[rot[col * 3 + 1]][i] +
+                                       a[row * 3 + 2] * t[rot[col * 3 + 2]][i];
+            }
+        }
+    }
+}
+
+static void body_gather(real dst[][BODY_BLOCK], real *const *src, int arrays, size_t start, size_t n)
+{
+    for (int k = 0; k < arrays; ++k)
+        memcpy(dst[k], src[k] + start, n * sizeof(real));
+}
+
+static void body_scatter(real *const *dst, real src[][BODY_BLOCK], int arrays, size_t start, size_t n)
+{
+    for (int k = 0; k < arrays; ++k)
+        memcpy(dst[k] + start, src[k], n * sizeof(real));
+}
+
+static void body_derive_range(cyclone_BodyWorld *world, size_t start, size_t count)
+{
+    real q[4][BODY_BLOCK];
+    real p[3][BODY_BLOCK];
+    real iit[9][BODY_BLOCK];
+    real t[12][BODY_BLOCK];
+    real iw[9][BODY_BLOCK];
+
+    for (size_t base = start; base < start + count; base += BODY_BLOCK)
+    {
+        size_t n = start + count - base;
+        n = n < BODY_BLOCK ? n : BODY_BLOCK;
+
+        body_gather(q, world->orientation, 4, base, n);
+        body_gather(p, world->position, 3, base, n);
+        body_gather(iit, world->inverse_inertia_tensor, 9, base, n);
+
+        body_derive_block(q, p, iit, t, iw, n);
+
+        body_scatter(world->orientation, q, 4, base, n);
+        body_scatter(world->transform, t, 12, base, n);
+        body_scatter(world->inverse_inertia_tensor_world, iw, 9, base, n);
+    }
+}
+
+void cyclone_body_world_calculate_derived_data(cyclone_BodyWorld *world)
+{
+    body_derive_range(world, 0, world->count);
+}
+
+void cyclone_body_world_update_derived_data(cyclone_BodyWorld *world, size_t i)
+{
+    body_derive_range(world, i, 1);
+}
+
+/* ============================================================
+ * Integration
+ * ============================================================
+ */
+
+static void body_refresh_step(cyclone_BodyWorld *world, real duration)
+{
+    if (world->damping_step == duration)
+        return;
+
+    world->damping_step = duration;
+    world->sleep_bias = real_pow((real)0.5, duration);
+    for (size_t i = 0; i < world->count; ++i)
+    {
+        world->linear_damping_factor[i] = real_pow(world->linear_damping[i], duration);
+        world->angular_damping_factor[i] = real_pow(world->angular_damping[i], duration);
+    }
+}
+
+static void body_integrate_one(cyclone_BodyWorld *world, size_t i, real duration)
+{
+    real im = world->inverse_mass[i];
+
+    cyclone_Vector3 accel = body_get(world->acceleration, i);
+    cyclone_Vector3 force = body_get(world->force_accum, i);
+    cyclone_vector3_add_scaled(&accel, &force, im);
+    body_set(world->last_frame_acceleration, i, accel);
+
+    cyclone_Vector3 torque = body_get(world->torque_accum, i);
+    cyclone_Matrix3 iw = cyclone_body_world_get_inverse_inertia_tensor_world(world, i);
+    cyclone_Vector3 angular_accel = cyclone_matrix3_transform(&iw, &torque);
+
+    cyclone_Vector3 velocity = body_get(world->velocity, i);
+    cyclone_Vector3 rotation = body_get(world->rotation, i);
+    cyclone_vector3_add_scaled(&velocity, &accel, duration);
+    cyclone_vector3_add_scaled(&rotation, &angular_accel, duration);
+    cyclone_vector3_scale_inplace(&velocity, world->linear_damping_factor[i]);
+    cyclone_vector3_scale_inplace(&rotation, world->angular_damping_factor[i]);
+    body_set(world->velocity, i, velocity);
+    body_set(world->rotation, i, rotation);
+
+    cyclone_Vector3 position = body_get(world->position, i);
+    cyclone_vector3_add_scaled(&position, &velocity, duration);
+    body_set(world->position, i, position);
+}
+
+/*
+ * Orientations of each run of awake bodies in one batch; the derived-data
+ * pass that follows renormalises them.
+ */
+static void body_integrate_orientations(cyclone_BodyWorld *world, real duration)
+{
+    size_t i = 0;
+    while (i < world->count)
+    {
+        if (!world->is_awake[i])
+        {
+            ++i;
+            continue;
+        }
+
+        size_t end = i + 1;
+        while (end < world->count && world->is_awake[end])
+            ++end;
+
+        real *q[4] = { world->orientation[0] + i, world->orientation[1] + i,
+                       world->orientation[2] + i, world->orientation[3] + i };
+        const real *w[3] = { world->rotation[0] + i, world->rotation[1] + i, world->rotation[2] + i };
+        cyclone_quaternion_add_scaled_vector_batch(q, w, duration, end - i);
+        i = end;
+    }
+}
+
+/*
+ * Recency-weighted average of v.v + w.w: below the sleep epsilon the body
+ * sleeps; the average is capped so a body that stops after a burst of
+ * speed does not take long to settle.
+ */
+static void body_update_sleep(cyclone_BodyWorld *world, size_t i)
+{
+    if (!world->can_sleep[i])
+        return;
+
+    cyclone_Vector3 velocity = body_get(world->velocity, i);
+    cyclone_Vector3 rotation = body_get(world->rotation, i);
+    real current = cyclone_vector3_dot(velocity, velocity) + cyclone_vector3_dot(rotation, rotation);
+
+    real bias = world->sleep_bias;
+    real motion = bias * world->motion[i] + ((real)1 - bias) * current;
+
+    if (motion > (real)10 * cyclone_sleep_epsilon)
+        motion = (real)10 * cyclone_sleep_epsilon;
+    world->motion[i] = motion;
+
+    if (!world->island_sleep && motion < cyclone_sleep_epsilon)
+        cyclone_body_world_set_awake(world, i, false);
+}
+
+void cyclone_body_world_integrate(cyclone_BodyWorld *world, real duration)
+{
+    if (duration <= (real)0)
+        return;
+
+    body_refresh_step(world, duration);
+
+    for (size_t i = 0; i < world->count; ++i)
+    {
+        if (world->is_awake[i])
+            body_integrate_one(world, i, duration);
+    }
+    body_integrate_orientations(world, duration);
+
+    /*
+     * Derived data for every block holding an awake body; runs of
+     * sleeping bodies keep the matrices from when they fell asleep.
+     */
+    for (size_t base = 0; base < world->count; base += BODY_BLOCK)
+    {
+        size_t n = world->count - base;
+        n = n < BODY_BLOCK ? n : BODY_BLOCK;
+
+        bool any_awake = false;
+        for (size_t i = base; i < base + n; ++i)
+            any_awake |= world->is_awake[i];
+
+        if (any_awake)
+            body_derive_range(world, base, n);
+    }
+
+    /* Sleeping bodies never hold forces: adding one wakes the body */
+    for (size_t i = 0; i < world->count; ++i)
+    {
+        if (!world->is_awake[i])
+            continue;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            world->force_accum[k][i] = (real)0;
+            world->torque_accum[k][i] = (real)0;
+        }
+        body_update_sleep(world, i);
+    }
+}
+
+/* ============================================================
+ * Snapshots
+ * ============================================================
+ */
+
+typedef struct body_snapshot_header {
+    size_t count;
+    real sleep_bias;
+    real damping_step;
+} body_snapshot_header;
+
+bool cyclone_body_world_save(const cyclone_BodyWorld *world, cyclone_Snapshot *snapshot)
+{
+    body_snapshot_header header = { world->count, world->sleep_bias, world->damping_step };
+    size_t start = snapshot->size;
+    bool ok = cyclone_snapshot_write(snapshot, &header, sizeof(header));
+
+    real **arrays[BODY_REAL_ARRAY_COUNT];
+    body_real_arrays((cyclone_BodyWorld *)world, arrays);
+    for (int i = 0; ok && i < BODY_REAL_ARRAY_COUNT; ++i)
+        ok = cyclone_snapshot_write(snapshot, *arrays[i], world->count * sizeof(real));
+
+    ok = ok && cyclone_snapshot_write(snapshot, world->is_awake, world->count * sizeof(bool));
+    ok = ok && cyclone_snapshot_write(snapshot, world->can_sleep, world->count * sizeof(bool));
+
+    /* Never leave half a world behind */
+    if (!ok)
+        snapshot->size = start;
+    return ok;
+}
+
+bool cyclone_body_world_load(cyclone_BodyWorld *world, const cyclone_Snapshot *snapshot, size_t *cursor)
+{
+    size_t at = *cursor;
+    body_snapshot_header header;
+    if (!cyclone_snapshot_read(snapshot, &at, &header, sizeof(header)))
+        return false;
+
+    size_t reals = header.count * sizeof(real);
+    size_t bools = header.count * sizeof(bool);
+    if (snapshot->size - at < BODY_REAL_ARRAY_COUNT * reals + 2 * bools)
+        return false;
+    if (!cyclone_body_world_reserve(world, header.count))
+        return false;
+
+    real **arrays[BODY_REAL_ARRAY_COUNT];
+    body_real_arrays(world, arrays);
+    for (int i = 0; i < BODY_REAL_ARRAY_COUNT; ++i)
+        cyclone_snapshot_read(snapshot, &at, *arrays[i], reals);
+    cyclone_snapshot_read(snapshot, &at, world->is_awake, bools);
+    cyclone_snapshot_read(snapshot, &at, world->can_sleep, bools);
+
+    world->count = header.count;
+    world->sleep_bias = header.sleep_bias;
+    world->damping_step = header.damping_step;
+    *cursor = at;
+    return true;
+}
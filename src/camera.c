@@ -230,7 +230,8 @@ Frustum camera_get_frustum(Camera* self) {
 
     /* Compute view-projection matrix */
     mat4 view = camera_get_view_matrix(self);
-    mat4 vp = mat4_mul(view, self->proj_matrix);
+    mat4 vp;
+    mat4_mul_into(&vp, &view, &self->proj_matrix);
 
     /* Extract frustum planes from view-projection matrix */
     /* Left plane: row 4 + row 1 */
@@ -450,10 +451,14 @@ void orbit_camera_update(OrbitCamera* self, float delta_time) {
     /* x = r * cos(pitch) * sin(yaw) */
     /* y = r * sin(pitch) */
     /* z = r * cos(pitch) * cos(yaw) */
+    float sin_yaw, cos_yaw, sin_pitch, cos_pitch;
+    math_sincos(yaw_rad, &sin_yaw, &cos_yaw);
+    math_sincos(pitch_rad, &sin_pitch, &cos_pitch);
+
     vec3 offset;
-    offset.x = self->zoom_distance * cosf(pitch_rad) * sinf(yaw_rad);
-    offset.y = self->zoom_distance * sinf(pitch_rad);
-    offset.z = self->zoom_distance * cosf(pitch_rad) * cosf(yaw_rad);
+    offset.x = self->zoom_distance * cos_pitch * sin_yaw;
+    offset.y = self->zoom_distance * sin_pitch;
+    offset.z = self->zoom_distance * cos_pitch * cos_yaw;
 
     /* Set camera position */
     vec3 position = vec3_add(self->target, offset);
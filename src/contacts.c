@@ -0,0 +1,797 @@
+#include "contacts.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * Setup
+ * ============================================================
+ */
+
+void cyclone_contact_solver_init(cyclone_ContactSolver *solver)
+{
+    memset(solver, 0, sizeof(*solver));
+
+    solver->velocity_iterations = 10;
+    solver->position_iterations = 4;
+    solver->tolerance = (real)1e-4;
+    solver->baumgarte = (real)0.2;
+    solver->slop = (real)0.005;
+    solver->restitution_threshold = (real)0.5;
+    solver->position_correction = CYCLONE_POSITION_BAUMGARTE;
+    solver->warm_starting = true;
+    solver->threads = 1;
+}
+
+void cyclone_contact_solver_free(cyclone_ContactSolver *solver)
+{
+    free(solver->constraints);
+    free(solver->cache);
+    free(solver->bodies);
+    free(solver->body_slot);
+    free(solver->color_mask);
+    cyclone_job_pool_destroy(solver->pool);
+    cyclone_contact_solver_init(solver);
+}
+
+/* Grow *array (element size bytes) to hold at least needed elements */
+static bool contact_reserve(void **array, size_t *capacity, size_t needed, size_t size)
+{
+    if (needed <= *capacity)
+        return true;
+
+    size_t grown = *capacity ? *capacity * 2 : 64;
+    while (grown < needed)
+        grown *= 2;
+
+    void *data = realloc(*array, grown * size);
+    if (!data)
+        return false;
+    *array = data;
+    *capacity = grown;
+    return true;
+}
+
+/* ============================================================
+ * Adding contacts
+ * ============================================================
+ */
+
+static cyclone_Vector3 contact_vector(vec3 v)
+{
+    return cyclone_vector3_make((real)v.x, (real)v.y, (real)v.z);
+}
+
+/*
+ * Two unit tangents completing a right-handed basis with the normal,
+ * built from whichever world axis is furthest from it.
+ */
+static void contact_basis(cyclone_Vector3 direction[3])
+{
+    cyclone_Vector3 n = direction[0];
+    cyclone_Vector3 t;
+
+    if (real_abs(n.x) > real_abs(n.y))
+    {
+        real s = ((real)1) / real_sqrt(n.z * n.z + n.x * n.x);
+        t = cyclone_vector3_make(n.z * s, (real)0, -n.x * s);
+    }
+    else
+    {
+        real s = ((real)1) / real_sqrt(n.z * n.z + n.y * n.y);
+        t = cyclone_vector3_make((real)0, -n.z * s, n.y * s);
+    }
+
+    direction[1] = t;
+    direction[2] = cyclone_vector3_cross(n, t);
+}
+
+static bool contact_add_points(cyclone_ContactSolver *solver,
+                               const cyclone_BodyWorld *world,
+                               size_t a, size_t b,
+                               vec3 normal, float depth,
+                               const vec3 *points, int count,
+                               real friction, real restitution)
+{
+    if (count <= 0)
+        return true;
+
+    if (!contact_reserve((void **)&solver->constraints, &solver->capacity,
+                         solver->count + (size_t)count, sizeof(cyclone_ContactConstraint)))
+        return false;
+
+    cyclone_Vector3 n = contact_vector(normal);
+    cyclone_vector3_normalise(&n);
+
+    cyclone_Matrix4 transform_a = cyclone_matrix4_identity();
+    if (a != CYCLONE_CONTACT_STATIC)
+        transform_a = cyclone_body_world_get_transform(world, a);
+
+    for (int i = 0; i < count; ++i)
+    {
+        cyclone_ContactConstraint *c = &solver->constraints[solver->count++];
+        memset(c, 0, sizeof(*c));
+
+        c->body[0] = a;
+        c->body[1] = b;
+        c->point = contact_vector(points[i]);
+        c->anchor = cyclone_matrix4_transform_inverse(&transform_a, &c->point);
+        c->direction[0] = n;
+        contact_basis(c->direction);
+        c->depth = (real)depth;
+        c->friction = friction;
+        c->restitution = restitution;
+    }
+    return true;
+}
+
+bool cyclone_contact_solver_add_manifold(cyclone_ContactSolver *solver,
+                                         const cyclone_BodyWorld *world,
+                                         size_t a, size_t b,
+                                         const CollisionManifold *manifold,
+                                         real friction, real restitution)
+{
+    if (!manifold->colliding)
+        return true;
+    return contact_add_points(solver, world, a, b, manifold->normal, manifold->depth,
+                              manifold->contacts.data, manifold->contacts.count,
+                              friction, restitution);
+}
+
+bool cyclone_contact_solver_add_fixed_manifold(cyclone_ContactSolver *solver,
+                                               const cyclone_BodyWorld *world,
+                                               size_t a, size_t b,
+                                               const FixedManifold *manifold,
+                                               real friction, real restitution)
+{
+    if (!manifold->colliding)
+        return true;
+    return contact_add_points(solver, world, a, b, manifold->normal, manifold->depth,
+                              manifold->contacts.data, manifold->contacts.count,
+                              friction, restitution);
+}
+
+/* ============================================================
+ * Warm-start cache
+ * ============================================================
+ */
+
+static int contact_pair_compare(const cyclone_ContactConstraint *x,
+                                const cyclone_ContactConstraint *y)
+{
+    if (x->body[0] != y->body[0])
+        return x->body[0] < y->body[0] ? -1 : 1;
+    if (x->body[1] != y->body[1])
+        return x->body[1] < y->body[1] ? -1 : 1;
+    return 0;
+}
+
+static int contact_sort_compare(const void *x, const void *y)
+{
+    return contact_pair_compare((const cyclone_ContactConstraint *)x,
+                                (const cyclone_ContactConstraint *)y);
+}
+
+/* First cached row for c's body pair, or cache_count */
+static size_t contact_cache_find(const cyclone_ContactSolver *solver,
+                                 const cyclone_ContactConstraint *c)
+{
+    size_t lo = 0;
+    size_t hi = solver->cache_count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (contact_pair_compare(&solver->cache[mid], c) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/*
+ * Copy the impulses of the nearest cached row of the same pair whose anchor
+ * is within CYCLONE_CONTACT_MATCH_DISTANCE and whose normal still agrees.
+ */
+static bool contact_warm_start_lookup(const cyclone_ContactSolver *solver,
+                                      cyclone_ContactConstraint *c)
+{
+    real best = CYCLONE_CONTACT_MATCH_DISTANCE * CYCLONE_CONTACT_MATCH_DISTANCE;
+    const cyclone_ContactConstraint *match = NULL;
+
+    for (size_t i = contact_cache_find(solver, c);
+         i < solver->cache_count && contact_pair_compare(&solver->cache[i], c) == 0;
+         ++i)
+    {
+        const cyclone_ContactConstraint *old = &solver->cache[i];
+        cyclone_Vector3 d = cyclone_vector3_sub(old->anchor, c->anchor);
+        real dist = cyclone_vector3_square_magnitude(&d);
+        if (dist < best && cyclone_vector3_dot(old->direction[0], c->direction[0]) > (real)0.95)
+        {
+            best = dist;
+            match = old;
+        }
+    }
+
+    if (!match)
+        return false;
+
+    /* Friction impulses re-expressed in the new tangent basis */
+    cyclone_Vector3 tangent = cyclone_vector3_scaled(match->direction[1], match->impulse[1]);
+    cyclone_vector3_add_scaled(&tangent, &match->direction[2], match->impulse[2]);
+
+    c->impulse[0] = match->impulse[0];
+    c->impulse[1] = cyclone_vector3_dot(tangent, c->direction[1]);
+    c->impulse[2] = cyclone_vector3_dot(tangent, c->direction[2]);
+    return true;
+}
+
+/* ============================================================
+ * Solver bodies
+ * ============================================================
+ */
+
+/*
+ * Slot 0 is the static world: zero inverse mass and inertia, so impulses
+ * applied to it change nothing that is written back.
+ */
+static bool contact_build_bodies(cyclone_ContactSolver *solver, cyclone_BodyWorld *world)
+{
+    if (!contact_reserve((void **)&solver->body_slot, &solver->body_slot_capacity,
+                         world->count, sizeof(size_t)))
+        return false;
+    if (world->count > 0)
+        memset(solver->body_slot, 0, world->count * sizeof(size_t));
+
+    /* Worst case every row brings two new bodies, plus the static slot */
+    if (!contact_reserve((void **)&solver->bodies, &solver->body_capacity,
+                         solver->count * 2 + 1, sizeof(cyclone_SolverBody)))
+        return false;
+
+    memset(&solver->bodies[0], 0, sizeof(cyclone_SolverBody));
+    solver->bodies[0].index = CYCLONE_CONTACT_STATIC;
+    solver->body_count = 1;
+
+    for (size_t i = 0; i < solver->count; ++i)
+    {
+        cyclone_ContactConstraint *c = &solver->constraints[i];
+        for (int k = 0; k < 2; ++k)
+        {
+            size_t body = c->body[k];
+            if (body == CYCLONE_CONTACT_STATIC)
+            {
+                c->slot[k] = 0;
+                continue;
+            }
+
+            if (solver->body_slot[body] == 0)
+            {
+                cyclone_SolverBody *s = &solver->bodies[solver->body_count];
+                s->velocity = cyclone_body_world_get_velocity(world, body);
+                s->rotation = cyclone_body_world_get_rotation(world, body);
+                s->pseudo_velocity = cyclone_vector3_zero();
+                s->pseudo_rotation = cyclone_vector3_zero();
+                s->inverse_mass = world->inverse_mass[body];
+                s->index = body;
+                solver->body_slot[body] = solver->body_count++;
+            }
+            c->slot[k] = solver->body_slot[body];
+        }
+    }
+    return true;
+}
+
+/*
+ * A contact between an awake and a sleeping body wakes the sleeper, and
+ * one between two sleeping bodies (or a sleeping body and the static
+ * world) is left out of this step.
+ */
+static bool contact_match_awake_state(cyclone_BodyWorld *world, const cyclone_ContactConstraint *c)
+{
+    bool awake[2];
+    for (int k = 0; k < 2; ++k)
+        awake[k] = c->body[k] != CYCLONE_CONTACT_STATIC && world->is_awake[c->body[k]];
+
+    if (!awake[0] && !awake[1])
+        return false;
+
+    for (int k = 0; k < 2; ++k)
+    {
+        if (!awake[k] && c->body[k] != CYCLONE_CONTACT_STATIC)
+            cyclone_body_world_set_awake(world, c->body[k], true);
+    }
+    return true;
+}
+
+/* ============================================================
+ * Solving
+ * ============================================================
+ */
+
+/* Speed of b relative to a along direction d of row c */
+static real contact_relative_speed(const cyclone_ContactConstraint *c, int d,
+                                   const cyclone_SolverBody *a, const cyclone_SolverBody *b,
+                                   bool pseudo)
+{
+    cyclone_Vector3 va = pseudo ? a->pseudo_velocity : a->velocity;
+    cyclone_Vector3 wa = pseudo ? a->pseudo_rotation : a->rotation;
+    cyclone_Vector3 vb = pseudo ? b->pseudo_velocity : b->velocity;
+    cyclone_Vector3 wb = pseudo ? b->pseudo_rotation : b->rotation;
+
+    return cyclone_vector3_dot(vb, c->direction[d]) + cyclone_vector3_dot(wb, c->arm[d][1])
+         - cyclone_vector3_dot(va, c->direction[d]) - cyclone_vector3_dot(wa, c->arm[d][0]);
+}
+
+/*
+ * Immovable bodies (the static slot included) are never written, so rows
+ * of one colour can share them across threads.
+ */
+static void contact_apply(const cyclone_ContactConstraint *c, int d, real impulse,
+                          cyclone_SolverBody *a, cyclone_SolverBody *b, bool pseudo)
+{
+    if (a->inverse_mass > (real)0)
+    {
+        cyclone_Vector3 *va = pseudo ? &a->pseudo_velocity : &a->velocity;
+        cyclone_Vector3 *wa = pseudo ? &a->pseudo_rotation : &a->rotation;
+        cyclone_vector3_add_scaled(va, &c->direction[d], -impulse * a->inverse_mass);
+        cyclone_vector3_add_scaled(wa, &c->spin[d][0], -impulse);
+    }
+    if (b->inverse_mass > (real)0)
+    {
+        cyclone_Vector3 *vb = pseudo ? &b->pseudo_velocity : &b->velocity;
+        cyclone_Vector3 *wb = pseudo ? &b->pseudo_rotation : &b->rotation;
+        cyclone_vector3_add_scaled(vb, &c->direction[d], impulse * b->inverse_mass);
+        cyclone_vector3_add_scaled(wb, &c->spin[d][1], impulse);
+    }
+}
+
+static void contact_prepare(cyclone_ContactSolver *solver, cyclone_BodyWorld *world,
+                            cyclone_ContactConstraint *c, real duration)
+{
+    cyclone_SolverBody *bodies[2] = { &solver->bodies[c->slot[0]], &solver->bodies[c->slot[1]] };
+
+    cyclone_Vector3 r[2];
+    cyclone_Matrix3 inverse_inertia[2];
+    for (int k = 0; k < 2; ++k)
+    {
+        size_t body = c->body[k];
+        if (body == CYCLONE_CONTACT_STATIC)
+        {
+            r[k] = cyclone_vector3_zero();
+            inverse_inertia[k] = cyclone_matrix3_zero();
+        }
+        else
+        {
+            r[k] = cyclone_vector3_sub(c->point, cyclone_body_world_get_position(world, body));
+            inverse_inertia[k] = cyclone_body_world_get_inverse_inertia_tensor_world(world, body);
+        }
+    }
+
+    /* k = 1/ma + 1/mb + (r x d) . I^-1 (r x d) for each body */
+    for (int d = 0; d < 3; ++d)
+    {
+        real k = bodies[0]->inverse_mass + bodies[1]->inverse_mass;
+        for (int b = 0; b < 2; ++b)
+        {
+            c->arm[d][b] = cyclone_vector3_cross(r[b], c->direction[d]);
+            c->spin[d][b] = cyclone_matrix3_transform(&inverse_inertia[b], &c->arm[d][b]);
+            k += cyclone_vector3_dot(c->arm[d][b], c->spin[d][b]);
+        }
+        c->mass[d] = k > (real)0 ? ((real)1) / k : (real)0;
+    }
+
+    real penetration = c->depth - solver->slop;
+    penetration = penetration > (real)0 ? penetration : (real)0;
+    real correction = solver->baumgarte / duration * penetration;
+
+    real closing = contact_relative_speed(c, 0, bodies[0], bodies[1], false);
+    real bounce = closing < -solver->restitution_threshold ? -c->restitution * closing : (real)0;
+
+    if (solver->position_correction == CYCLONE_POSITION_BAUMGARTE)
+    {
+        c->velocity_bias = bounce > correction ? bounce : correction;
+        c->position_bias = (real)0;
+    }
+    else
+    {
+        c->velocity_bias = bounce;
+        c->position_bias = correction;
+    }
+    c->pseudo_impulse = (real)0;
+}
+
+/* Velocity update of one row; returns the largest impulse change */
+static real contact_solve_row(cyclone_ContactSolver *solver, cyclone_ContactConstraint *c)
+{
+    cyclone_SolverBody *a = &solver->bodies[c->slot[0]];
+    cyclone_SolverBody *b = &solver->bodies[c->slot[1]];
+    real residual = (real)0;
+
+    /* Friction first, bounded by the current normal impulse */
+    real limit = c->friction * c->impulse[0];
+    for (int d = 1; d < 3; ++d)
+    {
+        real speed = contact_relative_speed(c, d, a, b, false);
+        real old = c->impulse[d];
+        real total = old - speed * c->mass[d];
+        total = total > limit ? limit : total;
+        total = total < -limit ? -limit : total;
+        c->impulse[d] = total;
+
+        real delta = total - old;
+        contact_apply(c, d, delta, a, b, false);
+        residual = real_abs(delta) > residual ? real_abs(delta) : residual;
+    }
+
+    real speed = contact_relative_speed(c, 0, a, b, false);
+    real old = c->impulse[0];
+    real total = old + (c->velocity_bias - speed) * c->mass[0];
+    total = total > (real)0 ? total : (real)0;
+    c->impulse[0] = total;
+
+    real delta = total - old;
+    contact_apply(c, 0, delta, a, b, false);
+    return real_abs(delta) > residual ? real_abs(delta) : residual;
+}
+
+/* Split-impulse update of one row; returns the pseudo impulse change */
+static real contact_solve_row_position(cyclone_ContactSolver *solver, cyclone_ContactConstraint *c)
+{
+    if (c->position_bias <= (real)0)
+        return (real)0;
+
+    cyclone_SolverBody *a = &solver->bodies[c->slot[0]];
+    cyclone_SolverBody *b = &solver->bodies[c->slot[1]];
+
+    real speed = contact_relative_speed(c, 0, a, b, true);
+    real old = c->pseudo_impulse;
+    real total = old + (c->position_bias - speed) * c->mass[0];
+    total = total > (real)0 ? total : (real)0;
+    c->pseudo_impulse = total;
+
+    real delta = total - old;
+    contact_apply(c, 0, delta, a, b, true);
+    return real_abs(delta);
+}
+
+/* ============================================================
+ * Colouring and sweeps
+ * ============================================================
+ */
+
+/* Rows per worker below which a colour is not worth splitting */
+#define CONTACT_JOB_GRAIN 32
+
+static bool contact_slot_movable(const cyclone_ContactSolver *solver, size_t slot)
+{
+    return slot != 0 && solver->bodies[slot].inverse_mass > (real)0;
+}
+
+/*
+ * Group the active rows into colours: greedy first-fit in row order, then
+ * a stable counting sort that moves the rows themselves, so each colour is
+ * a contiguous run of constraints and the sweeps stream through memory.
+ * Rows that fit no colour form the sequential group after the colours, and
+ * inactive rows go last. The warm-start cache has been consumed by now, so
+ * its buffer takes the sorted rows. Uncoloured, all rows are one
+ * sequential group in their own order.
+ */
+static bool contact_color_rows(cyclone_ContactSolver *solver, bool colored)
+{
+    memset(solver->color_start, 0, sizeof(solver->color_start));
+    solver->color_count = 0;
+
+    if (!colored)
+    {
+        solver->color_start[1] = solver->count;
+        solver->stats.uncolored = solver->stats.constraints;
+        return true;
+    }
+
+    if (!contact_reserve((void **)&solver->color_mask, &solver->color_mask_capacity,
+                         solver->body_count, sizeof(uint64_t)) ||
+        !contact_reserve((void **)&solver->cache, &solver->cache_capacity,
+                         solver->count, sizeof(cyclone_ContactConstraint)))
+        return false;
+    memset(solver->color_mask, 0, solver->body_count * sizeof(uint64_t));
+
+    /* Group sizes go to color_start[group + 1]; inactive rows count as the last group */
+    size_t *counts = solver->color_start + 1;
+    size_t inactive = 0;
+    int used = 0;
+    for (size_t i = 0; i < solver->count; ++i)
+    {
+        cyclone_ContactConstraint *c = &solver->constraints[i];
+        if (!c->active)
+        {
+            inactive++;
+            continue;
+        }
+
+        bool movable[2];
+        uint64_t taken = 0;
+        for (int k = 0; k < 2; ++k)
+        {
+            movable[k] = contact_slot_movable(solver, c->slot[k]);
+            if (movable[k])
+                taken |= solver->color_mask[c->slot[k]];
+        }
+
+        int color = 0;
+        while (color < CYCLONE_CONTACT_MAX_COLORS && (taken >> color) & 1u)
+            ++color;
+
+        c->color = color;
+        if (color < CYCLONE_CONTACT_MAX_COLORS)
+        {
+            for (int k = 0; k < 2; ++k)
+            {
+                if (movable[k])
+                    solver->color_mask[c->slot[k]] |= (uint64_t)1 << color;
+            }
+            used = color + 1 > used ? color + 1 : used;
+            counts[color]++;
+        }
+        else
+        {
+            solver->stats.uncolored++;
+        }
+    }
+
+    /* Sequential group straight after the last used colour, then inactive rows */
+    size_t groups = (size_t)used + 2;
+    counts[used] = solver->stats.uncolored;
+    counts[used + 1] = inactive;
+    solver->color_count = (size_t)used;
+
+    size_t cursor[CYCLONE_CONTACT_MAX_COLORS + 2];
+    cursor[0] = 0;
+    for (size_t g = 1; g < groups; ++g)
+        cursor[g] = cursor[g - 1] + counts[g - 1];
+    memcpy(solver->color_start, cursor, groups * sizeof(size_t));
+    solver->color_start[groups] = solver->count;
+
+    for (size_t i = 0; i < solver->count; ++i)
+    {
+        const cyclone_ContactConstraint *c = &solver->constraints[i];
+        size_t group = !c->active ? (size_t)used + 1
+                     : c->color < CYCLONE_CONTACT_MAX_COLORS ? (size_t)c->color
+                     : (size_t)used;
+        solver->cache[cursor[group]++] = *c;
+    }
+
+    cyclone_ContactConstraint *sorted = solver->cache;
+    size_t sorted_capacity = solver->cache_capacity;
+    solver->cache = solver->constraints;
+    solver->cache_capacity = solver->capacity;
+    solver->cache_count = 0;
+    solver->constraints = sorted;
+    solver->capacity = sorted_capacity;
+
+    solver->stats.colors = solver->color_count;
+    return true;
+}
+
+typedef struct contact_sweep_job {
+    cyclone_ContactSolver *solver;
+    size_t first;                   /* row of the range's index 0 */
+    bool pseudo;
+    real residual[CYCLONE_JOB_MAX_THREADS];
+} contact_sweep_job;
+
+static void contact_sweep_range(void *context, size_t begin, size_t end, int worker)
+{
+    contact_sweep_job *job = context;
+    real residual = (real)0;
+
+    for (size_t k = begin; k < end; ++k)
+    {
+        cyclone_ContactConstraint *c = &job->solver->constraints[job->first + k];
+        if (!c->active)
+            continue;
+
+        real change = job->pseudo ? contact_solve_row_position(job->solver, c)
+                                  : contact_solve_row(job->solver, c);
+        residual = change > residual ? change : residual;
+    }
+    job->residual[worker] = residual;
+}
+
+/*
+ * One Gauss-Seidel pass over the rows; returns the largest impulse
+ * change. Colours run in parallel one after another, then the sequential
+ * group on this thread. The maximum does not depend on how rows were split.
+ */
+static real contact_sweep(cyclone_ContactSolver *solver, bool pseudo)
+{
+    contact_sweep_job job;
+    job.solver = solver;
+    job.pseudo = pseudo;
+
+    real residual = (real)0;
+    for (size_t color = 0; color <= solver->color_count; ++color)
+    {
+        size_t begin = solver->color_start[color];
+        size_t count = solver->color_start[color + 1] - begin;
+        if (count == 0)
+            continue;
+
+        job.first = begin;
+        int workers = 1;
+        if (color < solver->color_count)
+            workers = cyclone_job_pool_run(solver->pool, count, CONTACT_JOB_GRAIN, contact_sweep_range, &job);
+        else
+            contact_sweep_range(&job, 0, count, 0);
+
+        for (int w = 0; w < workers; ++w)
+            residual = job.residual[w] > residual ? job.residual[w] : residual;
+    }
+    return residual;
+}
+
+/* Start, resize or stop the worker pool to match solver->threads */
+static void contact_update_pool(cyclone_ContactSolver *solver)
+{
+    int wanted = solver->threads > 1 ? solver->threads : 1;
+    if (wanted == solver->pool_threads && (solver->pool || wanted == 1))
+        return;
+
+    cyclone_job_pool_destroy(solver->pool);
+    solver->pool = wanted > 1 ? cyclone_job_pool_create(wanted) : NULL;
+    solver->pool_threads = wanted;
+}
+
+/* Move a body by its pseudo velocities over the step, then drop them */
+static void contact_apply_pseudo_motion(cyclone_BodyWorld *world, const cyclone_SolverBody *s,
+                                        real duration)
+{
+    if (cyclone_vector3_square_magnitude(&s->pseudo_velocity) == (real)0 &&
+        cyclone_vector3_square_magnitude(&s->pseudo_rotation) == (real)0)
+        return;
+
+    cyclone_Vector3 position = cyclone_body_world_get_position(world, s->index);
+    cyclone_vector3_add_scaled(&position, &s->pseudo_velocity, duration);
+    cyclone_body_world_set_position(world, s->index, position);
+
+    cyclone_Quaternion q = cyclone_body_world_get_orientation(world, s->index);
+    cyclone_quaternion_add_scaled_vector(&q, &s->pseudo_rotation, duration);
+    cyclone_body_world_set_orientation(world, s->index, q);
+
+    cyclone_body_world_update_derived_data(world, s->index);
+}
+
+/* Keep this step's rows, sorted by pair, as next step's warm-start cache */
+static void contact_store_cache(cyclone_ContactSolver *solver)
+{
+    cyclone_ContactConstraint *old = solver->cache;
+    size_t old_capacity = solver->cache_capacity;
+
+    solver->cache = solver->constraints;
+    solver->cache_count = solver->count;
+    solver->cache_capacity = solver->capacity;
+
+    solver->constraints = old;
+    solver->capacity = old_capacity;
+    solver->count = 0;
+
+    if (solver->cache_count > 1)
+        qsort(solver->cache, solver->cache_count, sizeof(cyclone_ContactConstraint), contact_sort_compare);
+}
+
+bool cyclone_contact_solver_solve(cyclone_ContactSolver *solver,
+                                  cyclone_BodyWorld *world,
+                                  real duration)
+{
+    memset(&solver->stats, 0, sizeof(solver->stats));
+
+    if (duration <= (real)0)
+    {
+        solver->count = 0;
+        return true;
+    }
+
+    for (size_t i = 0; i < solver->count; ++i)
+        solver->constraints[i].active = contact_match_awake_state(world, &solver->constraints[i]);
+
+    if (!contact_build_bodies(solver, world))
+        return false;
+
+    /* All rows see the velocities from before any impulse, for restitution */
+    for (size_t i = 0; i < solver->count; ++i)
+    {
+        cyclone_ContactConstraint *c = &solver->constraints[i];
+        if (!c->active)
+            continue;
+
+        contact_prepare(solver, world, c, duration);
+        solver->stats.constraints++;
+    }
+
+    for (size_t i = 0; i < solver->count; ++i)
+    {
+        cyclone_ContactConstraint *c = &solver->constraints[i];
+        if (!c->active || !solver->warm_starting || !contact_warm_start_lookup(solver, c))
+            continue;
+
+        cyclone_SolverBody *a = &solver->bodies[c->slot[0]];
+        cyclone_SolverBody *b = &solver->bodies[c->slot[1]];
+        for (int d = 0; d < 3; ++d)
+            contact_apply(c, d, c->impulse[d], a, b, false);
+        solver->stats.warm_started++;
+    }
+
+    contact_update_pool(solver);
+    if (!contact_color_rows(solver, solver->threads > 1 || solver->deterministic))
+        return false;
+
+    for (int it = 0; it < solver->velocity_iterations; ++it)
+    {
+        solver->stats.residual = contact_sweep(solver, false);
+        solver->stats.iterations = it + 1;
+        if (solver->stats.residual < solver->tolerance)
+            break;
+    }
+
+    if (solver->position_correction == CYCLONE_POSITION_SPLIT_IMPULSE)
+    {
+        for (int it = 0; it < solver->position_iterations; ++it)
+        {
+            solver->stats.position_residual = contact_sweep(solver, true);
+            solver->stats.position_iterations = it + 1;
+            if (solver->stats.position_residual < solver->tolerance)
+                break;
+        }
+    }
+
+    /* Slot 0 is the static world */
+    for (size_t s = 1; s < solver->body_count; ++s)
+    {
+        const cyclone_SolverBody *body = &solver->bodies[s];
+        if (body->inverse_mass <= (real)0)
+            continue;
+
+        cyclone_body_world_set_velocity(world, body->index, body->velocity);
+        cyclone_body_world_set_rotation(world, body->index, body->rotation);
+        if (solver->position_correction == CYCLONE_POSITION_SPLIT_IMPULSE)
+            contact_apply_pseudo_motion(world, body, duration);
+    }
+
+    contact_store_cache(solver);
+    return true;
+}
+
+/* ============================================================
+ * Snapshots
+ * ============================================================
+ */
+
+bool cyclone_contact_solver_save(const cyclone_ContactSolver *solver, cyclone_Snapshot *snapshot)
+{
+    size_t start = snapshot->size;
+    bool ok = cyclone_snapshot_write(snapshot, &solver->cache_count, sizeof(size_t)) &&
+              cyclone_snapshot_write(snapshot, solver->cache,
+                                     solver->cache_count * sizeof(cyclone_ContactConstraint));
+    if (!ok)
+        snapshot->size = start;
+    return ok;
+}
+
+bool cyclone_contact_solver_load(cyclone_ContactSolver *solver, const cyclone_Snapshot *snapshot, size_t *cursor)
+{
+    size_t at = *cursor;
+    size_t count;
+    if (!cyclone_snapshot_read(snapshot, &at, &count, sizeof(size_t)))
+        return false;
+
+    const void *rows = cyclone_snapshot_view(snapshot, &at, count * sizeof(cyclone_ContactConstraint));
+    if (!rows || !contact_reserve((void **)&solver->cache, &solver->cache_capacity,
+                                  count, sizeof(cyclone_ContactConstraint)))
+        return false;
+
+    if (count > 0)
+        memcpy(solver->cache, rows, count * sizeof(cyclone_ContactConstraint));
+    solver->cache_count = count;
+    solver->count = 0;
+    *cursor = at;
+    return true;
+}
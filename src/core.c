@@ -119,3 +119,207 @@ void cyclone_matrix4_set_inverse(cyclone_Matrix4 *out, const cyclone_Matrix4 *m)
     out->data[7]  = -(out->data[4]*tx + out->data[5]*ty + out->data[6]*tz);
     out->data[11] = -(out->data[8]*tx + out->data[9]*ty + out->data[10]*tz);
 }
+
+/* ============================================================
+ * Batched orientation kernels
+ * ============================================================
+ *
+ * The scalar loops repeat the single-body arithmetic in the same order,
+ * so without SIMD the results match the single-body helpers.
+ * The SIMD loops handle four bodies at a time and leave the remainder to
+ * the scalar loop.
+ */
+
+void cyclone_quaternion_add_scaled_vector_batch(real *const q[4],
+                                                const real *const v[3],
+                                                real scale,
+                                                size_t count)
+{
+    real *restrict qr = q[0];
+    real *restrict qi = q[1];
+    real *restrict qj = q[2];
+    real *restrict qk = q[3];
+    const real *restrict vx = v[0];
+    const real *restrict vy = v[1];
+    const real *restrict vz = v[2];
+    size_t n = 0;
+
+#if CYCLONE_SIMD
+    cyclone_simd4 s = cyclone_simd4_splat(scale);
+    cyclone_simd4 half = cyclone_simd4_splat(0.5f);
+    for (; n + 4 <= count; n += 4)
+    {
+        cyclone_simd4 r = cyclone_simd4_load(qr + n);
+        cyclone_simd4 i = cyclone_simd4_load(qi + n);
+        cyclone_simd4 j = cyclone_simd4_load(qj + n);
+        cyclone_simd4 k = cyclone_simd4_load(qk + n);
+        cyclone_simd4 px = cyclone_simd4_mul(cyclone_simd4_load(vx + n), s);
+        cyclone_simd4 py = cyclone_simd4_mul(cyclone_simd4_load(vy + n), s);
+        cyclone_simd4 pz = cyclone_simd4_mul(cyclone_simd4_load(vz + n), s);
+
+        /* (0, p) * q */
+        cyclone_simd4 dr = cyclone_simd4_sub(cyclone_simd4_sub(cyclone_simd4_sub(cyclone_simd4_splat(0.0f),
+                                             cyclone_simd4_mul(px, i)), cyclone_simd4_mul(py, j)), cyclone_simd4_mul(pz, k));
+        cyclone_simd4 di = cyclone_simd4_sub(cyclone_simd4_madd(py, k, cyclone_simd4_mul(px, r)), cyclone_simd4_mul(pz, j));
+        cyclone_simd4 dj = cyclone_simd4_sub(cyclone_simd4_madd(pz, i, cyclone_simd4_mul(py, r)), cyclone_simd4_mul(px, k));
+        cyclone_simd4 dk = cyclone_simd4_sub(cyclone_simd4_madd(px, j, cyclone_simd4_mul(pz, r)), cyclone_simd4_mul(py, i));
+
+        cyclone_simd4_store(qr + n, cyclone_simd4_madd(dr, half, r));
+        cyclone_simd4_store(qi + n, cyclone_simd4_madd(di, half, i));
+        cyclone_simd4_store(qj + n, cyclone_simd4_madd(dj, half, j));
+        cyclone_simd4_store(qk + n, cyclone_simd4_madd(dk, half, k));
+    }
+#endif
+
+    for (; n < count; ++n)
+    {
+        real px = vx[n] * scale;
+        real py = vy[n] * scale;
+        real pz = vz[n] * scale;
+        real r = qr[n], i = qi[n], j = qj[n], k = qk[n];
+
+        real dr = -px * i - py * j - pz * k;
+        real di = px * r + py * k - pz * j;
+        real dj = py * r + pz * i - px * k;
+        real dk = pz * r + px * j - py * i;
+
+        qr[n] = r + dr * ((real)0.5);
+        qi[n] = i + di * ((real)0.5);
+        qj[n] = j + dj * ((real)0.5);
+        qk[n] = k + dk * ((real)0.5);
+    }
+}
+
+void cyclone_quaternion_normalise_batch(real *const q[4], size_t count)
+{
+    real *restrict qr = q[0];
+    real *restrict qi = q[1];
+    real *restrict qj = q[2];
+    real *restrict qk = q[3];
+    size_t n = 0;
+
+#if CYCLONE_SIMD
+    cyclone_simd4 one = cyclone_simd4_splat(1.0f);
+    cyclone_simd4 epsilon = cyclone_simd4_splat(real_epsilon);
+    for (; n + 4 <= count; n += 4)
+    {
+        cyclone_simd4 r = cyclone_simd4_load(qr + n);
+        cyclone_simd4 i = cyclone_simd4_load(qi + n);
+        cyclone_simd4 j = cyclone_simd4_load(qj + n);
+        cyclone_simd4 k = cyclone_simd4_load(qk + n);
+
+        cyclone_simd4 d = cyclone_simd4_mul(r, r);
+        d = cyclone_simd4_madd(i, i, d);
+        d = cyclone_simd4_madd(j, j, d);
+        d = cyclone_simd4_madd(k, k, d);
+
+        /* Same 0/1 mask trick as the scalar loop */
+        cyclone_simd4 keep = cyclone_simd4_step(epsilon, d);
+        cyclone_simd4 reset = cyclone_simd4_sub(one, keep);
+        cyclone_simd4 inv = cyclone_simd4_mul(keep, cyclone_simd4_rsqrt(cyclone_simd4_add(d, reset)));
+
+        cyclone_simd4_store(qr + n, cyclone_simd4_madd(r, inv, reset));
+        cyclone_simd4_store(qi + n, cyclone_simd4_mul(i, inv));
+        cyclone_simd4_store(qj + n, cyclone_simd4_mul(j, inv));
+        cyclone_simd4_store(qk + n, cyclone_simd4_mul(k, inv));
+    }
+#endif
+
+    for (; n < count; ++n)
+    {
+        /*
+         * Branch free so the loop vectorises: degenerate quaternions get
+         * inv = 0 and r = 1.
+         */
+        real d = qr[n] * qr[n] + qi[n] * qi[n] + qj[n] * qj[n] + qk[n] * qk[n];
+        real keep = d < real_epsilon ? (real)0 : (real)1;
+        real inv = keep / real_sqrt(d + ((real)1 - keep));
+        qr[n] = qr[n] * inv + ((real)1 - keep);
+        qi[n] = qi[n] * inv;
+        qj[n] = qj[n] * inv;
+        qk[n] = qk[n] * inv;
+    }
+}
+
+void cyclone_quaternion_integrate_batch(real *const q[4],
+                                        const real *const w[3],
+                                        real duration,
+                                        size_t count)
+{
+    /* In blocks so the normalise pass finds the orientations in cache */
+    const size_t block = 256;
+
+    for (size_t base = 0; base < count; base += block)
+    {
+        size_t n = count - base < block ? count - base : block;
+        real *qb[4] = { q[0] + base, q[1] + base, q[2] + base, q[3] + base };
+        const real *wb[3] = { w[0] + base, w[1] + base, w[2] + base };
+
+        cyclone_quaternion_add_scaled_vector_batch(qb, wb, duration, n);
+        cyclone_quaternion_normalise_batch(qb, n);
+    }
+}
+
+void cyclone_matrix3_set_orientation_batch(real *const m[9],
+                                           const real *const q[4],
+                                           size_t count)
+{
+    const real *restrict qr = q[0];
+    const real *restrict qi = q[1];
+    const real *restrict qj = q[2];
+    const real *restrict qk = q[3];
+    real *restrict m0 = m[0];
+    real *restrict m1 = m[1];
+    real *restrict m2 = m[2];
+    real *restrict m3 = m[3];
+    real *restrict m4 = m[4];
+    real *restrict m5 = m[5];
+    real *restrict m6 = m[6];
+    real *restrict m7 = m[7];
+    real *restrict m8 = m[8];
+    size_t n = 0;
+
+#if CYCLONE_SIMD
+    cyclone_simd4 one = cyclone_simd4_splat(1.0f);
+    cyclone_simd4 two = cyclone_simd4_splat(2.0f);
+    for (; n + 4 <= count; n += 4)
+    {
+        cyclone_simd4 r = cyclone_simd4_load(qr + n);
+        cyclone_simd4 i = cyclone_simd4_load(qi + n);
+        cyclone_simd4 j = cyclone_simd4_load(qj + n);
+        cyclone_simd4 k = cyclone_simd4_load(qk + n);
+
+        /* Doubled products 2ab, shared between entries */
+        cyclone_simd4 i2 = cyclone_simd4_mul(two, i);
+        cyclone_simd4 j2 = cyclone_simd4_mul(two, j);
+        cyclone_simd4 k2 = cyclone_simd4_mul(two, k);
+        cyclone_simd4 ii = cyclone_simd4_mul(i2, i), jj = cyclone_simd4_mul(j2, j), kk = cyclone_simd4_mul(k2, k);
+        cyclone_simd4 ij = cyclone_simd4_mul(i2, j), ik = cyclone_simd4_mul(i2, k), jk = cyclone_simd4_mul(j2, k);
+        cyclone_simd4 kr = cyclone_simd4_mul(k2, r), jr = cyclone_simd4_mul(j2, r), ir = cyclone_simd4_mul(i2, r);
+
+        cyclone_simd4_store(m0 + n, cyclone_simd4_sub(one, cyclone_simd4_add(jj, kk)));
+        cyclone_simd4_store(m1 + n, cyclone_simd4_add(ij, kr));
+        cyclone_simd4_store(m2 + n, cyclone_simd4_sub(ik, jr));
+        cyclone_simd4_store(m3 + n, cyclone_simd4_sub(ij, kr));
+        cyclone_simd4_store(m4 + n, cyclone_simd4_sub(one, cyclone_simd4_add(ii, kk)));
+        cyclone_simd4_store(m5 + n, cyclone_simd4_add(jk, ir));
+        cyclone_simd4_store(m6 + n, cyclone_simd4_add(ik, jr));
+        cyclone_simd4_store(m7 + n, cyclone_simd4_sub(jk, ir));
+        cyclone_simd4_store(m8 + n, cyclone_simd4_sub(one, cyclone_simd4_add(ii, jj)));
+    }
+#endif
+
+    for (; n < count; ++n)
+    {
+        real r = qr[n], i = qi[n], j = qj[n], k = qk[n];
+        m0[n] = 1 - (2*j*j + 2*k*k);
+        m1[n] = 2*i*j + 2*k*r;
+        m2[n] = 2*i*k - 2*j*r;
+        m3[n] = 2*i*j - 2*k*r;
+        m4[n] = 1 - (2*i*i + 2*k*k);
+        m5[n] = 2*j*k + 2*i*r;
+        m6[n] = 2*i*k + 2*j*r;
+        m7[n] = 2*j*k - 2*i*r;
+        m8[n] = 1 - (2*i*i + 2*j*j);
+    }
+}
@@ -0,0 +1,51 @@
+#include "fastmath.h"
+#include "matrices_simd.h"
+
+void math_fast_sincos_array(const float *angles, float *sines, float *cosines, size_t n) {
+    size_t i = 0;
+
+#if MATH_SIMD
+    /* math_fast_sincos, four lanes at a time */
+    const math_simd4 inv_two_pi = math_simd4_splat(MATH_FAST_INV_TWO_PI);
+    const math_simd4 magic      = math_simd4_splat(MATH_FAST_ROUND_MAGIC);
+    const math_simd4 two_pi_hi  = math_simd4_splat(MATH_FAST_TWO_PI_HI);
+    const math_simd4 two_pi_mid = math_simd4_splat(MATH_FAST_TWO_PI_MID);
+    const math_simd4 two_pi_lo  = math_simd4_splat(MATH_FAST_TWO_PI_LO);
+    const math_simd4 pi         = math_simd4_splat(MATH_FAST_PI);
+    const math_simd4 neg_pi     = math_simd4_splat(-MATH_FAST_PI);
+    const math_simd4 half_pi    = math_simd4_splat(MATH_FAST_HALF_PI);
+    const math_simd4 zero       = math_simd4_splat(0.0f);
+    const math_simd4 c4 = math_simd4_splat(2.60190307e-6f);
+    const math_simd4 c3 = math_simd4_splat(-1.98074187e-4f);
+    const math_simd4 c2 = math_simd4_splat(8.33302514e-3f);
+    const math_simd4 c1 = math_simd4_splat(-1.66666567e-1f);
+
+    for (; i + 4 <= n; i += 4) {
+        math_simd4 x = math_simd4_load(angles + i);
+        math_simd4 k = math_simd4_sub(math_simd4_add(math_simd4_mul(x, inv_two_pi), magic), magic);
+        math_simd4 r = math_simd4_sub(x, math_simd4_mul(k, two_pi_hi));
+        r = math_simd4_sub(r, math_simd4_mul(k, two_pi_mid));
+        r = math_simd4_sub(r, math_simd4_mul(k, two_pi_lo));
+
+        math_simd4 f = math_simd4_min(r, math_simd4_sub(pi, r));
+        f = math_simd4_max(f, math_simd4_sub(neg_pi, r));
+        math_simd4 g = math_simd4_sub(half_pi, math_simd4_max(r, math_simd4_sub(zero, r)));
+
+        /* Both polynomials interleaved */
+        math_simd4 fs = math_simd4_mul(f, f);
+        math_simd4 gs = math_simd4_mul(g, g);
+        math_simd4 fp = math_simd4_add(math_simd4_mul(c4, fs), c3);
+        math_simd4 gp = math_simd4_add(math_simd4_mul(c4, gs), c3);
+        fp = math_simd4_add(math_simd4_mul(fp, fs), c2);
+        gp = math_simd4_add(math_simd4_mul(gp, gs), c2);
+        fp = math_simd4_add(math_simd4_mul(fp, fs), c1);
+        gp = math_simd4_add(math_simd4_mul(gp, gs), c1);
+        math_simd4_store(sines + i, math_simd4_add(f, math_simd4_mul(math_simd4_mul(f, fs), fp)));
+        math_simd4_store(cosines + i, math_simd4_add(g, math_simd4_mul(math_simd4_mul(g, gs), gp)));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        math_fast_sincos(angles[i], &sines[i], &cosines[i]);
+    }
+}
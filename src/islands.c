@@ -0,0 +1,279 @@
+#include "islands.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * Setup
+ * ============================================================
+ */
+
+void cyclone_islands_init(cyclone_Islands *islands)
+{
+    memset(islands, 0, sizeof(*islands));
+}
+
+void cyclone_islands_free(cyclone_Islands *islands)
+{
+    free(islands->parent);
+    free(islands->size);
+    free(islands->island_of);
+    free(islands->body_start);
+    free(islands->bodies);
+    free(islands->row_start);
+    free(islands->rows);
+    free(islands->awake);
+    cyclone_islands_init(islands);
+}
+
+/*
+ * Grow the per-body arrays to hold count bodies. Every per-island array is
+ * sized per body too, since there are never more islands than bodies.
+ */
+static bool islands_reserve_bodies(cyclone_Islands *islands, size_t count)
+{
+    if (count <= islands->body_capacity)
+        return true;
+
+    size_t grown = islands->body_capacity ? islands->body_capacity * 2 : 64;
+    while (grown < count)
+        grown *= 2;
+
+    size_t *parent = malloc(grown * sizeof(size_t));
+    size_t *size = malloc(grown * sizeof(size_t));
+    size_t *island_of = malloc(grown * sizeof(size_t));
+    size_t *body_start = malloc((grown + 1) * sizeof(size_t));
+    size_t *bodies = malloc(grown * sizeof(size_t));
+    size_t *row_start = malloc((grown + 1) * sizeof(size_t));
+    bool *awake = malloc(grown * sizeof(bool));
+
+    if (!parent || !size || !island_of || !body_start || !bodies || !row_start || !awake)
+    {
+        free(parent);
+        free(size);
+        free(island_of);
+        free(body_start);
+        free(bodies);
+        free(row_start);
+        free(awake);
+        return false;
+    }
+
+    /* Everything is rebuilt each step, so nothing needs copying */
+    free(islands->parent);
+    free(islands->size);
+    free(islands->island_of);
+    free(islands->body_start);
+    free(islands->bodies);
+    free(islands->row_start);
+    free(islands->awake);
+
+    islands->parent = parent;
+    islands->size = size;
+    islands->island_of = island_of;
+    islands->body_start = body_start;
+    islands->bodies = bodies;
+    islands->row_start = row_start;
+    islands->awake = awake;
+    islands->body_capacity = grown;
+    return true;
+}
+
+static bool islands_reserve_rows(cyclone_Islands *islands, size_t count)
+{
+    if (count <= islands->row_capacity)
+        return true;
+
+    size_t grown = islands->row_capacity ? islands->row_capacity * 2 : 64;
+    while (grown < count)
+        grown *= 2;
+
+    size_t *rows = realloc(islands->rows, grown * sizeof(size_t));
+    if (!rows)
+        return false;
+    islands->rows = rows;
+    islands->row_capacity = grown;
+    return true;
+}
+
+/* ============================================================
+ * Union-find
+ * ============================================================
+ */
+
+/* Root of body i, halving the path on the way up */
+static size_t islands_find(size_t *parent, size_t i)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/* Join the sets of bodies a and b, hanging the smaller under the larger */
+static void islands_union(size_t *parent, size_t *size, size_t a, size_t b)
+{
+    a = islands_find(parent, a);
+    b = islands_find(parent, b);
+    if (a == b)
+        return;
+
+    if (size[a] < size[b])
+    {
+        size_t t = a;
+        a = b;
+        b = t;
+    }
+    parent[b] = a;
+    size[a] += size[b];
+}
+
+/*
+ * Bodies that take part in joining islands. The static world and
+ * immovable bodies do not: a floor would otherwise merge everything
+ * resting on it into one island.
+ */
+static bool islands_links(const cyclone_BodyWorld *world, size_t i)
+{
+    return i != CYCLONE_CONTACT_STATIC && world->inverse_mass[i] > (real)0;
+}
+
+/* ============================================================
+ * Building
+ * ============================================================
+ */
+
+bool cyclone_islands_build(cyclone_Islands *islands,
+                           cyclone_BodyWorld *world,
+                           const cyclone_ContactSolver *solver)
+{
+    islands->island_count = 0;
+
+    if (!islands_reserve_bodies(islands, world->count) ||
+        !islands_reserve_rows(islands, solver->count))
+        return false;
+
+    size_t *parent = islands->parent;
+    size_t *size = islands->size;
+
+    for (size_t i = 0; i < world->count; ++i)
+    {
+        parent[i] = i;
+        size[i] = 1;
+    }
+
+    for (size_t r = 0; r < solver->count; ++r)
+    {
+        const cyclone_ContactConstraint *c = &solver->constraints[r];
+        if (islands_links(world, c->body[0]) && islands_links(world, c->body[1]))
+            islands_union(parent, size, c->body[0], c->body[1]);
+    }
+
+    /*
+     * Number the roots in body order, so islands come out the same way
+     * every run, then count bodies per island into body_start[i + 1].
+     * island_of temporarily holds the root's island number. Path halving
+     * leaves parent[i] short of the root, so look the root up again.
+     */
+    size_t count = 0;
+    for (size_t i = 0; i < world->count; ++i)
+    {
+        if (islands_find(parent, i) == i)
+        {
+            islands->island_of[i] = count;
+            islands->body_start[count + 1] = 0;
+            islands->row_start[count + 1] = 0;
+            islands->awake[count] = false;
+            count++;
+        }
+    }
+    islands->body_start[0] = 0;
+    islands->row_start[0] = 0;
+    islands->island_count = count;
+
+    for (size_t i = 0; i < world->count; ++i)
+    {
+        size_t island = islands->island_of[islands_find(parent, i)];
+        islands->island_of[i] = island;
+        islands->body_start[island + 1]++;
+        if (world->is_awake[i])
+            islands->awake[island] = true;
+    }
+
+    /* A row belongs to the island of whichever body can move */
+    for (size_t r = 0; r < solver->count; ++r)
+    {
+        const cyclone_ContactConstraint *c = &solver->constraints[r];
+        size_t body = islands_links(world, c->body[0]) ? c->body[0] : c->body[1];
+        if (body != CYCLONE_CONTACT_STATIC)
+            islands->row_start[islands->island_of[body] + 1]++;
+    }
+
+    /* Counting sort: prefix sums, then scatter */
+    for (size_t s = 0; s < count; ++s)
+    {
+        islands->body_start[s + 1] += islands->body_start[s];
+        islands->row_start[s + 1] += islands->row_start[s];
+    }
+
+    /* parent and size are no longer needed; reuse them as write cursors */
+    size_t *body_cursor = parent;
+    size_t *row_cursor = size;
+    memcpy(body_cursor, islands->body_start, count * sizeof(size_t));
+    memcpy(row_cursor, islands->row_start, count * sizeof(size_t));
+
+    for (size_t i = 0; i < world->count; ++i)
+        islands->bodies[body_cursor[islands->island_of[i]]++] = i;
+
+    for (size_t r = 0; r < solver->count; ++r)
+    {
+        const cyclone_ContactConstraint *c = &solver->constraints[r];
+        size_t body = islands_links(world, c->body[0]) ? c->body[0] : c->body[1];
+        if (body != CYCLONE_CONTACT_STATIC)
+            islands->rows[row_cursor[islands->island_of[body]]++] = r;
+    }
+
+    /* Wake whole islands */
+    for (size_t s = 0; s < count; ++s)
+    {
+        if (!islands->awake[s])
+            continue;
+
+        for (size_t k = islands->body_start[s]; k < islands->body_start[s + 1]; ++k)
+        {
+            size_t i = islands->bodies[k];
+            if (!world->is_awake[i])
+                cyclone_body_world_set_awake(world, i, true);
+        }
+    }
+    return true;
+}
+
+/* ============================================================
+ * Sleeping
+ * ============================================================
+ */
+
+void cyclone_islands_update_sleep(cyclone_Islands *islands, cyclone_BodyWorld *world)
+{
+    for (size_t s = 0; s < islands->island_count; ++s)
+    {
+        if (!islands->awake[s])
+            continue;
+
+        bool still = true;
+        for (size_t k = islands->body_start[s]; k < islands->body_start[s + 1] && still; ++k)
+        {
+            size_t i = islands->bodies[k];
+            still = world->can_sleep[i] && world->motion[i] < cyclone_sleep_epsilon;
+        }
+        if (!still)
+            continue;
+
+        for (size_t k = islands->body_start[s]; k < islands->body_start[s + 1]; ++k)
+            cyclone_body_world_set_awake(world, islands->bodies[k], false);
+        islands->awake[s] = false;
+    }
+}
@@ -0,0 +1,263 @@
+#if defined(CYCLONE_USE_THREADS) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "jobs.h"
+
+#include <stdlib.h>
+
+#ifdef CYCLONE_USE_THREADS
+#include <pthread.h>
+#ifdef __EMSCRIPTEN__
+#include <emscripten/threading.h>
+#else
+#include <unistd.h>
+#endif
+#endif
+
+#ifdef CYCLONE_USE_THREADS
+
+struct cyclone_JobPool {
+    int threads;
+    pthread_t workers[CYCLONE_JOB_MAX_THREADS];
+
+    pthread_mutex_t mutex;
+    pthread_cond_t start;           /* signalled when a job is posted */
+    pthread_cond_t done;            /* signalled when the last worker finishes */
+
+    /* Current job, guarded by mutex */
+    unsigned generation;
+    int pending;                    /* helper threads still to finish */
+    int active;                     /* workers with a range this job */
+    bool quit;
+    size_t count;
+    cyclone_JobFunction function;
+    void *context;
+};
+
+typedef struct job_worker_start {
+    cyclone_JobPool *pool;
+    int index;
+} job_worker_start;
+
+#else
+
+struct cyclone_JobPool {
+    int threads;
+};
+
+#endif
+
+#ifdef CYCLONE_USE_THREADS
+
+/* ============================================================
+ * Ranges
+ * ============================================================
+ */
+
+static size_t job_range_begin(size_t count, int workers, int worker)
+{
+    return count * (size_t)worker / (size_t)workers;
+}
+
+static int job_workers_for(const cyclone_JobPool *pool, size_t count, size_t grain)
+{
+    int threads = pool ? pool->threads : 1;
+    if (grain == 0)
+        grain = 1;
+
+    size_t fit = count / grain;
+    if (fit < 1)
+        fit = 1;
+    return fit < (size_t)threads ? (int)fit : threads;
+}
+
+/* ============================================================
+ * Threads
+ * ============================================================
+ */
+
+static void *job_worker_main(void *argument)
+{
+    job_worker_start *start = argument;
+    cyclone_JobPool *pool = start->pool;
+    int index = start->index;
+    free(start);
+
+    unsigned seen = 0;
+    for (;;)
+    {
+        pthread_mutex_lock(&pool->mutex);
+        while (!pool->quit && pool->generation == seen)
+            pthread_cond_wait(&pool->start, &pool->mutex);
+        if (pool->quit)
+        {
+            pthread_mutex_unlock(&pool->mutex);
+            break;
+        }
+        seen = pool->generation;
+        int active = pool->active;
+        size_t count = pool->count;
+        cyclone_JobFunction function = pool->function;
+        void *context = pool->context;
+        pthread_mutex_unlock(&pool->mutex);
+
+        if (index < active)
+        {
+            size_t begin = job_range_begin(count, active, index);
+            size_t end = job_range_begin(count, active, index + 1);
+            if (begin < end)
+                function(context, begin, end, index);
+        }
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->done);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    return NULL;
+}
+
+int cyclone_job_hardware_threads(void)
+{
+#ifdef __EMSCRIPTEN__
+    int cores = emscripten_num_logical_cores();
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (cores < 1)
+        return 1;
+    return cores > CYCLONE_JOB_MAX_THREADS ? CYCLONE_JOB_MAX_THREADS : (int)cores;
+}
+
+/* Stop the first started helpers and release the pool */
+static void job_pool_shutdown(cyclone_JobPool *pool, int started)
+{
+    pthread_mutex_lock(&pool->mutex);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int t = 1; t <= started; ++t)
+        pthread_join(pool->workers[t], NULL);
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool);
+}
+
+cyclone_JobPool *cyclone_job_pool_create(int threads)
+{
+    cyclone_JobPool *pool = calloc(1, sizeof(*pool));
+    if (!pool)
+        return NULL;
+
+    threads = threads < 1 ? 1 : threads;
+    threads = threads > CYCLONE_JOB_MAX_THREADS ? CYCLONE_JOB_MAX_THREADS : threads;
+    pool->threads = threads;
+
+    if (pthread_mutex_init(&pool->mutex, NULL) != 0)
+    {
+        free(pool);
+        return NULL;
+    }
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    /* Worker 0 is the calling thread */
+    for (int t = 1; t < threads; ++t)
+    {
+        job_worker_start *start = malloc(sizeof(*start));
+        if (start)
+        {
+            start->pool = pool;
+            start->index = t;
+        }
+        if (!start || pthread_create(&pool->workers[t], NULL, job_worker_main, start) != 0)
+        {
+            free(start);
+            job_pool_shutdown(pool, t - 1);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void cyclone_job_pool_destroy(cyclone_JobPool *pool)
+{
+    if (pool)
+        job_pool_shutdown(pool, pool->threads - 1);
+}
+
+int cyclone_job_pool_run(cyclone_JobPool *pool, size_t count, size_t grain,
+                         cyclone_JobFunction function, void *context)
+{
+    if (count == 0)
+        return 1;
+
+    int workers = job_workers_for(pool, count, grain);
+    if (workers == 1)
+    {
+        function(context, 0, count, 0);
+        return 1;
+    }
+
+    /* Every helper wakes for each job, even those without a range */
+    pthread_mutex_lock(&pool->mutex);
+    pool->count = count;
+    pool->function = function;
+    pool->context = context;
+    pool->active = workers;
+    pool->pending = pool->threads - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+
+    size_t end = job_range_begin(count, workers, 1);
+    function(context, 0, end, 0);
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->pending > 0)
+        pthread_cond_wait(&pool->done, &pool->mutex);
+    pthread_mutex_unlock(&pool->mutex);
+    return workers;
+}
+
+#else /* !CYCLONE_USE_THREADS */
+
+int cyclone_job_hardware_threads(void)
+{
+    return 1;
+}
+
+cyclone_JobPool *cyclone_job_pool_create(int threads)
+{
+    (void)threads;
+    cyclone_JobPool *pool = malloc(sizeof(*pool));
+    if (pool)
+        pool->threads = 1;
+    return pool;
+}
+
+void cyclone_job_pool_destroy(cyclone_JobPool *pool)
+{
+    free(pool);
+}
+
+int cyclone_job_pool_run(cyclone_JobPool *pool, size_t count, size_t grain,
+                         cyclone_JobFunction function, void *context)
+{
+    (void)pool;
+    (void)grain;
+    if (count > 0)
+        function(context, 0, count, 0);
+    return 1;
+}
+
+#endif /* CYCLONE_USE_THREADS */
+
+int cyclone_job_pool_threads(const cyclone_JobPool *pool)
+{
+    return pool ? pool->threads : 1;
+}
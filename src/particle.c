@@ -0,0 +1,637 @@
+#include "particle.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The whole-world passes are plain loops over restrict-qualified SoA
+ * arrays so the compiler vectorises them (SSE/NEON natively, SIMD128 under
+ * emscripten -msimd128). The drag pass needs sqrt without errno, which is
+ * clang's default and set for gcc in CMakeLists.txt.
+ */
+
+/* ============================================================
+ * Storage
+ * ============================================================
+ */
+
+#define PARTICLE_ARRAY_COUNT 15
+
+/* All per-particle arrays, in one list so growth and free stay in sync */
+static real **particle_arrays(cyclone_ParticleWorld *world, real **arrays)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        arrays[i]      = world->position[i];
+        arrays[i + 3]  = world->velocity[i];
+        arrays[i + 6]  = world->acceleration[i];
+        arrays[i + 9]  = world->force_accum[i];
+    }
+    arrays[12] = world->inverse_mass;
+    arrays[13] = world->damping;
+    arrays[14] = world->damping_factor;
+    return arrays;
+}
+
+static void particle_arrays_assign(cyclone_ParticleWorld *world, real **arrays)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        world->position[i]     = arrays[i];
+        world->velocity[i]     = arrays[i + 3];
+        world->acceleration[i] = arrays[i + 6];
+        world->force_accum[i]  = arrays[i + 9];
+    }
+    world->inverse_mass   = arrays[12];
+    world->damping        = arrays[13];
+    world->damping_factor = arrays[14];
+}
+
+void cyclone_particle_world_init(cyclone_ParticleWorld *world)
+{
+    real *arrays[PARTICLE_ARRAY_COUNT] = { 0 };
+    particle_arrays_assign(world, arrays);
+    world->count = 0;
+    world->capacity = 0;
+    world->damping_step = (real)0;
+    world->uniform_acceleration = cyclone_vector3_zero();
+
+    world->generators = NULL;
+    world->generator_count = 0;
+    world->generator_capacity = 0;
+}
+
+void cyclone_particle_world_free(cyclone_ParticleWorld *world)
+{
+    real *arrays[PARTICLE_ARRAY_COUNT];
+    particle_arrays(world, arrays);
+    for (int i = 0; i < PARTICLE_ARRAY_COUNT; ++i)
+        free(arrays[i]);
+
+    for (size_t g = 0; g < world->generator_count; ++g)
+        free(world->generators[g].particles);
+    free(world->generators);
+
+    cyclone_particle_world_init(world);
+}
+
+bool cyclone_particle_world_reserve(cyclone_ParticleWorld *world, size_t capacity)
+{
+    if (capacity <= world->capacity)
+        return true;
+
+    /*
+     * Allocate every array before touching the old ones so a failure
+     * part way through leaves the world untouched.
+     */
+    real *old_arrays[PARTICLE_ARRAY_COUNT];
+    real *new_arrays[PARTICLE_ARRAY_COUNT];
+    particle_arrays(world, old_arrays);
+
+    for (int i = 0; i < PARTICLE_ARRAY_COUNT; ++i)
+    {
+        new_arrays[i] = (real *)malloc(capacity * sizeof(real));
+        if (!new_arrays[i])
+        {
+            while (i-- > 0)
+                free(new_arrays[i]);
+            return false;
+        }
+    }
+
+    for (int i = 0; i < PARTICLE_ARRAY_COUNT; ++i)
+    {
+        if (world->count > 0)
+            memcpy(new_arrays[i], old_arrays[i], world->count * sizeof(real));
+        free(old_arrays[i]);
+    }
+
+    particle_arrays_assign(world, new_arrays);
+    world->capacity = capacity;
+    return true;
+}
+
+static real particle_inverse_mass(real mass)
+{
+    return mass > (real)0 ? ((real)1) / mass : (real)0;
+}
+
+static void particle_update_damping_factor(cyclone_ParticleWorld *world, size_t i)
+{
+    if (world->damping_step > (real)0)
+        world->damping_factor[i] = real_pow(world->damping[i], world->damping_step);
+}
+
+bool cyclone_particle_world_add(cyclone_ParticleWorld *world,
+                                cyclone_Vector3 position,
+                                cyclone_Vector3 velocity,
+                                real mass,
+                                real damping,
+                                size_t *out_index)
+{
+    if (world->count == world->capacity)
+    {
+        size_t capacity = world->capacity ? world->capacity * 2 : 64;
+        if (!cyclone_particle_world_reserve(world, capacity))
+            return false;
+    }
+
+    size_t i = world->count++;
+    cyclone_particle_world_set_position(world, i, position);
+    cyclone_particle_world_set_velocity(world, i, velocity);
+    cyclone_particle_world_set_acceleration(world, i, cyclone_vector3_zero());
+    for (int k = 0; k < 3; ++k)
+        world->force_accum[k][i] = (real)0;
+    world->inverse_mass[i] = particle_inverse_mass(mass);
+    world->damping[i] = damping;
+    world->damping_factor[i] = damping;
+    particle_update_damping_factor(world, i);
+
+    if (out_index)
+        *out_index = i;
+    return true;
+}
+
+/* ============================================================
+ * Accessors
+ * ============================================================
+ */
+
+static cyclone_Vector3 particle_get(real *const array[3], size_t i)
+{
+    return cyclone_vector3_make(array[0][i], array[1][i], array[2][i]);
+}
+
+static void particle_set(real *array[3], size_t i, cyclone_Vector3 v)
+{
+    array[0][i] = v.x;
+    array[1][i] = v.y;
+    array[2][i] = v.z;
+}
+
+cyclone_Vector3 cyclone_particle_world_get_position(const cyclone_ParticleWorld *world, size_t i)
+{
+    return particle_get(world->position, i);
+}
+
+cyclone_Vector3 cyclone_particle_world_get_velocity(const cyclone_ParticleWorld *world, size_t i)
+{
+    return particle_get(world->velocity, i);
+}
+
+void cyclone_particle_world_set_position(cyclone_ParticleWorld *world, size_t i, cyclone_Vector3 position)
+{
+    particle_set(world->position, i, position);
+}
+
+void cyclone_particle_world_set_velocity(cyclone_ParticleWorld *world, size_t i, cyclone_Vector3 velocity)
+{
+    particle_set(world->velocity, i, velocity);
+}
+
+void cyclone_particle_world_set_acceleration(cyclone_ParticleWorld *world, size_t i, cyclone_Vector3 acceleration)
+{
+    particle_set(world->acceleration, i, acceleration);
+}
+
+void cyclone_particle_world_set_mass(cyclone_ParticleWorld *world, size_t i, real mass)
+{
+    world->inverse_mass[i] = particle_inverse_mass(mass);
+}
+
+void cyclone_particle_world_set_damping(cyclone_ParticleWorld *world, size_t i, real damping)
+{
+    world->damping[i] = damping;
+    particle_update_damping_factor(world, i);
+}
+
+void cyclone_particle_world_add_force(cyclone_ParticleWorld *world, size_t i, cyclone_Vector3 force)
+{
+    world->force_accum[0][i] += force.x;
+    world->force_accum[1][i] += force.y;
+    world->force_accum[2][i] += force.z;
+}
+
+/* ============================================================
+ * Generator registration
+ * ============================================================
+ */
+
+static cyclone_ParticleForceGenerator *
+particle_generator_new(cyclone_ParticleWorld *world,
+                       cyclone_ParticleForceType type,
+                       size_t *out_generator)
+{
+    if (world->generator_count == world->generator_capacity)
+    {
+        size_t capacity = world->generator_capacity ? world->generator_capacity * 2 : 8;
+        cyclone_ParticleForceGenerator *generators = (cyclone_ParticleForceGenerator *)
+            realloc(world->generators, capacity * sizeof(*generators));
+        if (!generators)
+            return NULL;
+        world->generators = generators;
+        world->generator_capacity = capacity;
+    }
+
+    size_t g = world->generator_count++;
+    cyclone_ParticleForceGenerator *generator = &world->generators[g];
+    *generator = (cyclone_ParticleForceGenerator){ .type = type };
+
+    if (out_generator)
+        *out_generator = g;
+    return generator;
+}
+
+bool cyclone_particle_world_add_gravity(cyclone_ParticleWorld *world,
+                                        cyclone_Vector3 gravity,
+                                        size_t *out_generator)
+{
+    cyclone_ParticleForceGenerator *generator =
+        particle_generator_new(world, CYCLONE_PARTICLE_GRAVITY, out_generator);
+    if (!generator)
+        return false;
+    generator->gravity.gravity = gravity;
+    return true;
+}
+
+bool cyclone_particle_world_add_drag(cyclone_ParticleWorld *world,
+                                     real k1, real k2,
+                                     size_t *out_generator)
+{
+    cyclone_ParticleForceGenerator *generator =
+        particle_generator_new(world, CYCLONE_PARTICLE_DRAG, out_generator);
+    if (!generator)
+        return false;
+    generator->drag.k1 = k1;
+    generator->drag.k2 = k2;
+    return true;
+}
+
+bool cyclone_particle_world_add_spring(cyclone_ParticleWorld *world,
+                                       real spring_constant, real rest_length,
+                                       size_t *out_generator)
+{
+    cyclone_ParticleForceGenerator *generator =
+        particle_generator_new(world, CYCLONE_PARTICLE_SPRING, out_generator);
+    if (!generator)
+        return false;
+    generator->spring.spring_constant = spring_constant;
+    generator->spring.rest_length = rest_length;
+    return true;
+}
+
+bool cyclone_particle_world_add_buoyancy(cyclone_ParticleWorld *world,
+                                         real max_depth, real volume,
+                                         real water_height, real liquid_density,
+                                         size_t *out_generator)
+{
+    cyclone_ParticleForceGenerator *generator =
+        particle_generator_new(world, CYCLONE_PARTICLE_BUOYANCY, out_generator);
+    if (!generator)
+        return false;
+    generator->buoyancy.max_depth = max_depth;
+    generator->buoyancy.volume = volume;
+    generator->buoyancy.water_height = water_height;
+    generator->buoyancy.liquid_density = liquid_density;
+    return true;
+}
+
+static bool particle_generator_reserve(cyclone_ParticleForceGenerator *generator, size_t needed)
+{
+    if (needed <= generator->capacity)
+        return true;
+
+    size_t capacity = generator->capacity ? generator->capacity * 2 : 16;
+    while (capacity < needed)
+        capacity *= 2;
+
+    size_t *particles = (size_t *)realloc(generator->particles, capacity * sizeof(size_t));
+    if (!particles)
+        return false;
+    generator->particles = particles;
+    generator->capacity = capacity;
+    return true;
+}
+
+bool cyclone_particle_generator_attach(cyclone_ParticleWorld *world,
+                                       size_t generator, size_t i)
+{
+    cyclone_ParticleForceGenerator *g = &world->generators[generator];
+    if (!particle_generator_reserve(g, g->count + 1))
+        return false;
+    g->particles[g->count++] = i;
+    return true;
+}
+
+bool cyclone_particle_generator_connect(cyclone_ParticleWorld *world,
+                                        size_t generator, size_t a, size_t b)
+{
+    cyclone_ParticleForceGenerator *spring = &world->generators[generator];
+    if (!particle_generator_reserve(spring, spring->count + 2))
+        return false;
+    spring->particles[spring->count++] = a;
+    spring->particles[spring->count++] = b;
+    return true;
+}
+
+void cyclone_particle_generator_apply_to_all(cyclone_ParticleWorld *world,
+                                             size_t generator)
+{
+    world->generators[generator].all = true;
+}
+
+/* ============================================================
+ * Force passes
+ * ============================================================
+ */
+
+static void particle_gravity_list(cyclone_ParticleWorld *world, cyclone_Vector3 g,
+                                  const size_t *particles, size_t count)
+{
+    for (size_t n = 0; n < count; ++n)
+    {
+        size_t i = particles[n];
+        real im = world->inverse_mass[i];
+        if (im <= (real)0)
+            continue;
+        real mass = ((real)1) / im;
+        world->force_accum[0][i] += g.x * mass;
+        world->force_accum[1][i] += g.y * mass;
+        world->force_accum[2][i] += g.z * mass;
+    }
+}
+
+/* Drag coefficient to scale the velocity by, from its magnitude */
+static inline real particle_drag_scale(real vx, real vy, real vz, real k1, real k2)
+{
+    real speed = real_sqrt(vx * vx + vy * vy + vz * vz);
+    return -(k1 + k2 * speed);
+}
+
+static void particle_drag_all(const real *restrict vx,
+                              const real *restrict vy,
+                              const real *restrict vz,
+                              real *restrict fx,
+                              real *restrict fy,
+                              real *restrict fz,
+                              size_t count,
+                              real k1, real k2)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        real s = particle_drag_scale(vx[i], vy[i], vz[i], k1, k2);
+        fx[i] += vx[i] * s;
+        fy[i] += vy[i] * s;
+        fz[i] += vz[i] * s;
+    }
+}
+
+static void particle_drag_list(cyclone_ParticleWorld *world, real k1, real k2,
+                               const size_t *particles, size_t count)
+{
+    for (size_t n = 0; n < count; ++n)
+    {
+        size_t i = particles[n];
+        real vx = world->velocity[0][i];
+        real vy = world->velocity[1][i];
+        real vz = world->velocity[2][i];
+        real s = particle_drag_scale(vx, vy, vz, k1, k2);
+        world->force_accum[0][i] += vx * s;
+        world->force_accum[1][i] += vy * s;
+        world->force_accum[2][i] += vz * s;
+    }
+}
+
+/*
+ * Upward force for a particle at height y: zero above the surface band,
+ * full density * volume once submerged by max_depth, linear in between.
+ */
+static inline real particle_buoyancy_force(real y, real max_depth, real volume,
+                                           real water_height, real liquid_density)
+{
+    real full = liquid_density * volume;
+    real submerged = (water_height + max_depth - y) / (2 * max_depth);
+    submerged = submerged < (real)0 ? (real)0 : submerged;
+    submerged = submerged > (real)1 ? (real)1 : submerged;
+    return full * submerged;
+}
+
+static void particle_buoyancy_all(const real *restrict y,
+                                  real *restrict fy,
+                                  size_t count,
+                                  real max_depth, real volume,
+                                  real water_height, real liquid_density)
+{
+    for (size_t i = 0; i < count; ++i)
+        fy[i] += particle_buoyancy_force(y[i], max_depth, volume, water_height, liquid_density);
+}
+
+static void particle_buoyancy_list(cyclone_ParticleWorld *world,
+                                   const cyclone_ParticleForceGenerator *b)
+{
+    for (size_t n = 0; n < b->count; ++n)
+    {
+        size_t i = b->particles[n];
+        world->force_accum[1][i] +=
+            particle_buoyancy_force(world->position[1][i], b->buoyancy.max_depth, b->buoyancy.volume,
+                                    b->buoyancy.water_height, b->buoyancy.liquid_density);
+    }
+}
+
+/*
+ * Hooke's law on each connected pair: both ends are pulled together when
+ * stretched past rest_length and pushed apart when compressed.
+ */
+static void particle_springs(cyclone_ParticleWorld *world,
+                             const cyclone_ParticleForceGenerator *s)
+{
+    real k = s->spring.spring_constant;
+    real rest = s->spring.rest_length;
+
+    for (size_t n = 0; n + 1 < s->count; n += 2)
+    {
+        size_t a = s->particles[n];
+        size_t b = s->particles[n + 1];
+
+        real dx = world->position[0][a] - world->position[0][b];
+        real dy = world->position[1][a] - world->position[1][b];
+        real dz = world->position[2][a] - world->position[2][b];
+        real length = real_sqrt(dx * dx + dy * dy + dz * dz);
+        if (length <= (real)0)
+            continue;
+
+        real scale = -k * (length - rest) / length;
+        dx *= scale;
+        dy *= scale;
+        dz *= scale;
+
+        world->force_accum[0][a] += dx;
+        world->force_accum[1][a] += dy;
+        world->force_accum[2][a] += dz;
+        world->force_accum[0][b] -= dx;
+        world->force_accum[1][b] -= dy;
+        world->force_accum[2][b] -= dz;
+    }
+}
+
+void cyclone_particle_world_apply_forces(cyclone_ParticleWorld *world)
+{
+    for (size_t g = 0; g < world->generator_count; ++g)
+    {
+        const cyclone_ParticleForceGenerator *generator = &world->generators[g];
+
+        switch (generator->type)
+        {
+        case CYCLONE_PARTICLE_GRAVITY:
+            /* Same acceleration for every particle: folded into integrate */
+            if (generator->all)
+                cyclone_vector3_add_inplace(&world->uniform_acceleration,
+                                            &generator->gravity.gravity);
+            else
+                particle_gravity_list(world, generator->gravity.gravity,
+                                      generator->particles, generator->count);
+            break;
+
+        case CYCLONE_PARTICLE_DRAG:
+            if (generator->all)
+                particle_drag_all(world->velocity[0], world->velocity[1], world->velocity[2],
+                                  world->force_accum[0], world->force_accum[1], world->force_accum[2],
+                                  world->count, generator->drag.k1, generator->drag.k2);
+            else
+                particle_drag_list(world, generator->drag.k1, generator->drag.k2,
+                                   generator->particles, generator->count);
+            break;
+
+        case CYCLONE_PARTICLE_SPRING:
+            particle_springs(world, generator);
+            break;
+
+        case CYCLONE_PARTICLE_BUOYANCY:
+            if (generator->all)
+                particle_buoyancy_all(world->position[1], world->force_accum[1], world->count,
+                                      generator->buoyancy.max_depth, generator->buoyancy.volume,
+                                      generator->buoyancy.water_height,
+                                      generator->buoyancy.liquid_density);
+            else
+                particle_buoyancy_list(world, generator);
+            break;
+        }
+    }
+}
+
+/* ============================================================
+ * Integration
+ * ============================================================
+ */
+
+static void particle_refresh_damping(cyclone_ParticleWorld *world, real duration)
+{
+    if (world->damping_step == duration)
+        return;
+
+    world->damping_step = duration;
+    size_t count = world->count;
+    for (size_t i = 0; i < count; ++i)
+        world->damping_factor[i] = real_pow(world->damping[i], duration);
+}
+
+/* One component: v' = (v + a dt) * damping^dt, p' = p + v' dt */
+static void particle_integrate_axis(real *restrict p,
+                                    real *restrict v,
+                                    const real *restrict a,
+                                    real *restrict f,
+                                    const real *restrict inverse_mass,
+                                    const real *restrict damping_factor,
+                                    size_t count,
+                                    real uniform,
+                                    real duration)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        real im = inverse_mass[i];
+        real active = im > (real)0 ? (real)1 : (real)0;
+        real accel = a[i] + uniform + f[i] * im;
+        real vel = (v[i] + accel * duration) * damping_factor[i];
+
+        v[i] = active > (real)0 ? vel : v[i];
+        p[i] += vel * duration * active;
+        f[i] = (real)0;
+    }
+}
+
+void cyclone_particle_world_integrate(cyclone_ParticleWorld *world, real duration)
+{
+    if (duration <= (real)0)
+        return;
+
+    particle_refresh_damping(world, duration);
+
+    for (int k = 0; k < 3; ++k)
+    {
+        particle_integrate_axis(world->position[k], world->velocity[k],
+                                world->acceleration[k], world->force_accum[k],
+                                world->inverse_mass, world->damping_factor,
+                                world->count,
+                                cyclone_vector3_get(&world->uniform_acceleration, (unsigned)k),
+                                duration);
+    }
+    cyclone_vector3_clear(&world->uniform_acceleration);
+}
+
+void cyclone_particle_world_run_physics(cyclone_ParticleWorld *world, real duration)
+{
+    cyclone_particle_world_apply_forces(world);
+    cyclone_particle_world_integrate(world, duration);
+}
+
+/* ============================================================
+ * Snapshots
+ * ============================================================
+ */
+
+typedef struct particle_snapshot_header {
+    size_t count;
+    real damping_step;
+    cyclone_Vector3 uniform_acceleration;
+} particle_snapshot_header;
+
+bool cyclone_particle_world_save(const cyclone_ParticleWorld *world, cyclone_Snapshot *snapshot)
+{
+    particle_snapshot_header header = { world->count, world->damping_step, world->uniform_acceleration };
+    size_t start = snapshot->size;
+    bool ok = cyclone_snapshot_write(snapshot, &header, sizeof(header));
+
+    real *arrays[PARTICLE_ARRAY_COUNT];
+    particle_arrays((cyclone_ParticleWorld *)world, arrays);
+    for (int i = 0; ok && i < PARTICLE_ARRAY_COUNT; ++i)
+        ok = cyclone_snapshot_write(snapshot, arrays[i], world->count * sizeof(real));
+
+    if (!ok)
+        snapshot->size = start;
+    return ok;
+}
+
+bool cyclone_particle_world_load(cyclone_ParticleWorld *world, const cyclone_Snapshot *snapshot, size_t *cursor)
+{
+    size_t at = *cursor;
+    particle_snapshot_header header;
+    if (!cyclone_snapshot_read(snapshot, &at, &header, sizeof(header)))
+        return false;
+
+    size_t reals = header.count * sizeof(real);
+    if (snapshot->size - at < PARTICLE_ARRAY_COUNT * reals)
+        return false;
+    if (!cyclone_particle_world_reserve(world, header.count))
+        return false;
+
+    real *arrays[PARTICLE_ARRAY_COUNT];
+    particle_arrays(world, arrays);
+    for (int i = 0; i < PARTICLE_ARRAY_COUNT; ++i)
+        cyclone_snapshot_read(snapshot, &at, arrays[i], reals);
+
+    world->count = header.count;
+    world->damping_step = header.damping_step;
+    world->uniform_acceleration = header.uniform_acceleration;
+    *cursor = at;
+    return true;
+}
@@ -2,6 +2,7 @@
 
 #include "render.h"
 #include "polygon.h"
+#include "timestep.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -57,6 +58,14 @@ static Polygon  g_polygon;             /* animated polygon */
 static Point2D *g_baseVerts = NULL;    /* original (untransformed) vertices */
 static bool     g_main_loop_started = false;
 
+/* Simulation clock: the animation advances one unit per fixed 60 Hz step */
+#define SIM_STEP_SECONDS (1.0 / 60.0)
+
+static cyclone_FixedStep g_clock;
+static double g_simTime     = 0.0;     /* animation time after the latest step */
+static double g_prevSimTime = 0.0;     /* and before it, for interpolation */
+static double g_lastFrameMs = -1.0;
+
 /* ------------------------------------------------------------------------- */
 /* Shaders                                                                   */
 /* ------------------------------------------------------------------------- */
@@ -293,13 +302,26 @@ static void tick(void)
 
     frameCount++;
 
+    /* Advance the simulation in fixed steps, whatever the refresh rate */
+    double nowMs = emscripten_get_now();
+    double elapsed = g_lastFrameMs < 0.0 ? 0.0 : (nowMs - g_lastFrameMs) * 0.001;
+    g_lastFrameMs = nowMs;
+
+    int steps = cyclone_fixed_step_advance(&g_clock, (real)elapsed);
+    for (int i = 0; i < steps; ++i) {
+        g_prevSimTime = g_simTime;
+        g_simTime += 1.0;
+    }
+    double alpha = (double)cyclone_fixed_step_alpha(&g_clock);
+
     if (polygon_is_valid(&g_polygon) &&
         g_baseVerts != NULL &&
         g_vertexData != NULL &&
         g_vertexFloatCount == (size_t)vertexCount * 2U)
     {
-        /* Time-based angle and translation for very obvious motion */
-        double t      = (double)frameCount;
+        /* Time-based angle and translation for very obvious motion,
+           drawn between the last two simulated states */
+        double t      = g_prevSimTime + (g_simTime - g_prevSimTime) * alpha;
         double angle  = 0.05 * t;                 /* fast rotation */
         double orbitR = 0.6;                      /* orbit radius in NDC */
         double tx     = orbitR * cos(0.01 * t);   /* x offset */
@@ -375,6 +397,7 @@ void startMainLoop(void)
     }
 
     g_main_loop_started = true;
+    cyclone_fixed_step_init(&g_clock, (real)SIM_STEP_SECONDS);
     printf("[startMainLoop] entering main loop\n");
 
     /* 0 = browser-driven fps, 1 = simulate infinite loop */
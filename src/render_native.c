@@ -3,6 +3,7 @@
 #ifdef USE_SDL3
 
 #include "polygon.h"
+#include "timestep.h"
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_opengl.h>
 #include <stdio.h>
@@ -28,6 +29,14 @@ static Point2D *g_baseVerts        = NULL;
 static float   *g_vertexData       = NULL;
 static size_t   g_vertexFloatCount = 0;
 
+/* Simulation clock: the animation advances one unit per fixed 60 Hz step */
+#define SIM_STEP_SECONDS (1.0 / 60.0)
+
+static cyclone_FixedStep g_clock;
+static double g_simTime     = 0.0;   /* animation time after the latest step */
+static double g_prevSimTime = 0.0;   /* and before it, for interpolation */
+static Uint64 g_lastFrameNs = 0;
+
 /* ========================================================================= */
 /* Shader Sources (OpenGL 3.3 Core)                                         */
 /* ========================================================================= */
@@ -236,9 +245,21 @@ static void renderFrame(void) {
     static Uint64 frameCount = 0;
     frameCount++;
     
-    /* Animate polygon */
+    /* Advance the simulation in fixed steps, whatever the refresh rate */
+    Uint64 nowNs = SDL_GetTicksNS();
+    double elapsed = g_lastFrameNs == 0 ? 0.0 : (double)(nowNs - g_lastFrameNs) * 1e-9;
+    g_lastFrameNs = nowNs;
+    
+    int steps = cyclone_fixed_step_advance(&g_clock, (real)elapsed);
+    for (int i = 0; i < steps; ++i) {
+        g_prevSimTime = g_simTime;
+        g_simTime += 1.0;
+    }
+    double alpha = (double)cyclone_fixed_step_alpha(&g_clock);
+    
+    /* Animate polygon, drawn between the last two simulated states */
     if (polygon_is_valid(&g_polygon) && g_baseVerts && g_vertexData) {
-        double t = (double)frameCount;
+        double t = g_prevSimTime + (g_simTime - g_prevSimTime) * alpha;
         double angle = 0.05 * t;
         double orbitR = 0.6;
         double tx = orbitR * cos(0.01 * t);
@@ -297,6 +318,7 @@ static void renderFrame(void) {
 
 void startMainLoop(void) {
     printf("[startMainLoop] Entering main loop\n");
+    cyclone_fixed_step_init(&g_clock, (real)SIM_STEP_SECONDS);
     
     while (g_running) {
         handleEvents();
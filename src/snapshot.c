@@ -0,0 +1,147 @@
+#include "snapshot.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * Snapshot
+ * ============================================================
+ */
+
+void cyclone_snapshot_init(cyclone_Snapshot *snapshot)
+{
+    snapshot->data = NULL;
+    snapshot->size = 0;
+    snapshot->capacity = 0;
+    snapshot->tick = 0;
+}
+
+void cyclone_snapshot_free(cyclone_Snapshot *snapshot)
+{
+    free(snapshot->data);
+    cyclone_snapshot_init(snapshot);
+}
+
+void cyclone_snapshot_clear(cyclone_Snapshot *snapshot)
+{
+    snapshot->size = 0;
+    snapshot->tick = 0;
+}
+
+bool cyclone_snapshot_write(cyclone_Snapshot *snapshot, const void *data, size_t size)
+{
+    if (size == 0)
+        return true;
+
+    size_t needed = snapshot->size + size;
+    if (needed > snapshot->capacity)
+    {
+        size_t grown = snapshot->capacity ? snapshot->capacity * 2 : 4096;
+        while (grown < needed)
+            grown *= 2;
+
+        unsigned char *fresh = realloc(snapshot->data, grown);
+        if (!fresh)
+            return false;
+        snapshot->data = fresh;
+        snapshot->capacity = grown;
+    }
+
+    memcpy(snapshot->data + snapshot->size, data, size);
+    snapshot->size = needed;
+    return true;
+}
+
+const void *cyclone_snapshot_view(const cyclone_Snapshot *snapshot, size_t *cursor, size_t size)
+{
+    if (*cursor > snapshot->size || snapshot->size - *cursor < size)
+        return NULL;
+
+    const void *at = snapshot->data + *cursor;
+    *cursor += size;
+    return at;
+}
+
+bool cyclone_snapshot_read(const cyclone_Snapshot *snapshot, size_t *cursor, void *data, size_t size)
+{
+    const void *at = cyclone_snapshot_view(snapshot, cursor, size);
+    if (!at)
+        return false;
+    if (size > 0)
+        memcpy(data, at, size);
+    return true;
+}
+
+/* ============================================================
+ * Rollback ring
+ * ============================================================
+ */
+
+bool cyclone_snapshot_ring_init(cyclone_SnapshotRing *ring, size_t length)
+{
+    ring->count = 0;
+    ring->head = 0;
+    ring->length = 0;
+    ring->slots = NULL;
+
+    if (length == 0)
+        return true;
+
+    ring->slots = malloc(length * sizeof(cyclone_Snapshot));
+    if (!ring->slots)
+        return false;
+
+    for (size_t i = 0; i < length; ++i)
+        cyclone_snapshot_init(&ring->slots[i]);
+    ring->length = length;
+    return true;
+}
+
+void cyclone_snapshot_ring_free(cyclone_SnapshotRing *ring)
+{
+    for (size_t i = 0; i < ring->length; ++i)
+        cyclone_snapshot_free(&ring->slots[i]);
+    free(ring->slots);
+    cyclone_snapshot_ring_init(ring, 0);
+}
+
+cyclone_Snapshot *cyclone_snapshot_ring_push(cyclone_SnapshotRing *ring, uint64_t tick)
+{
+    if (ring->length == 0)
+        return NULL;
+
+    ring->head = ring->count == 0 ? 0 : (ring->head + 1) % ring->length;
+    if (ring->count < ring->length)
+        ring->count++;
+
+    cyclone_Snapshot *slot = &ring->slots[ring->head];
+    cyclone_snapshot_clear(slot);
+    slot->tick = tick;
+    return slot;
+}
+
+/* k-th newest snapshot, k = 0 for the newest */
+static cyclone_Snapshot *snapshot_ring_at(cyclone_SnapshotRing *ring, size_t k)
+{
+    return &ring->slots[(ring->head + ring->length - k) % ring->length];
+}
+
+cyclone_Snapshot *cyclone_snapshot_ring_find(cyclone_SnapshotRing *ring, uint64_t tick)
+{
+    for (size_t k = 0; k < ring->count; ++k)
+    {
+        cyclone_Snapshot *slot = snapshot_ring_at(ring, k);
+        if (slot->tick <= tick)
+            return slot;
+    }
+    return NULL;
+}
+
+void cyclone_snapshot_ring_discard_after(cyclone_SnapshotRing *ring, uint64_t tick)
+{
+    while (ring->count > 0 && snapshot_ring_at(ring, 0)->tick > tick)
+    {
+        ring->count--;
+        ring->head = (ring->head + ring->length - 1) % ring->length;
+    }
+}
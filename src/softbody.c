@@ -0,0 +1,961 @@
+#include "softbody.h"
+#include "Geometry3D/geom3d_bvh.h"
+#include "Geometry3D/geom3d_queries.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * Setup
+ * ============================================================
+ */
+
+void cyclone_soft_body_init(cyclone_SoftBody *body)
+{
+    memset(body, 0, sizeof(*body));
+
+    body->substeps = 8;
+    body->iterations = 1;
+    body->stretch_compliance = (real)0;
+    body->bend_compliance = (real)0.01;
+    body->volume_compliance = (real)0;
+    body->thickness = (real)0.01;
+    body->friction = (real)0.3;
+    body->threads = 1;
+}
+
+static void soft_distance_free(cyclone_SoftDistanceSet *set)
+{
+    free(set->a);
+    free(set->b);
+    free(set->rest);
+    free(set->lambda);
+}
+
+void cyclone_soft_body_free(cyclone_SoftBody *body)
+{
+    soft_distance_free(&body->stretch);
+    soft_distance_free(&body->bend);
+    for (int k = 0; k < 4; ++k)
+        free(body->volume.index[k]);
+    free(body->volume.rest);
+    free(body->volume.lambda);
+
+    free(body->spheres);
+    free(body->boxes);
+    free(body->meshes);
+
+    for (int k = 0; k < 3; ++k)
+        free(body->previous[k]);
+    free(body->color_mask);
+    cyclone_job_pool_destroy(body->pool);
+
+    cyclone_soft_body_init(body);
+}
+
+/* Grow *array (element size bytes) to hold at least needed elements */
+static bool soft_reserve(void **array, size_t *capacity, size_t needed, size_t size)
+{
+    if (needed <= *capacity)
+        return true;
+
+    size_t grown = *capacity ? *capacity * 2 : 64;
+    while (grown < needed)
+        grown *= 2;
+
+    void *data = realloc(*array, grown * size);
+    if (!data)
+        return false;
+    *array = data;
+    *capacity = grown;
+    return true;
+}
+
+/*
+ * Grow several arrays sharing one capacity. Arrays already grown when a
+ * later one fails are simply larger than needed; capacity only moves once
+ * all have succeeded.
+ */
+static bool soft_reserve_arrays(void **arrays[], const size_t sizes[], int array_count,
+                                size_t *capacity, size_t needed)
+{
+    if (needed <= *capacity)
+        return true;
+
+    size_t grown = *capacity ? *capacity * 2 : 64;
+    while (grown < needed)
+        grown *= 2;
+
+    for (int k = 0; k < array_count; ++k)
+    {
+        void *data = realloc(*arrays[k], grown * sizes[k]);
+        if (!data)
+            return false;
+        *arrays[k] = data;
+    }
+    *capacity = grown;
+    return true;
+}
+
+static bool soft_distance_reserve(cyclone_SoftDistanceSet *set, size_t needed)
+{
+    void **arrays[4] = { (void **)&set->a, (void **)&set->b, (void **)&set->rest, (void **)&set->lambda };
+    const size_t sizes[4] = { sizeof(size_t), sizeof(size_t), sizeof(real), sizeof(real) };
+    return soft_reserve_arrays(arrays, sizes, 4, &set->capacity, needed);
+}
+
+static bool soft_volume_reserve(cyclone_SoftVolumeSet *set, size_t needed)
+{
+    void **arrays[6] = {
+        (void **)&set->index[0], (void **)&set->index[1], (void **)&set->index[2],
+        (void **)&set->index[3], (void **)&set->rest, (void **)&set->lambda
+    };
+    const size_t sizes[6] = {
+        sizeof(size_t), sizeof(size_t), sizeof(size_t), sizeof(size_t), sizeof(real), sizeof(real)
+    };
+    return soft_reserve_arrays(arrays, sizes, 6, &set->capacity, needed);
+}
+
+/* ============================================================
+ * Adding constraints
+ * ============================================================
+ */
+
+static cyclone_Vector3 soft_position(const cyclone_ParticleWorld *world, size_t i)
+{
+    return cyclone_vector3_make(world->position[0][i], world->position[1][i], world->position[2][i]);
+}
+
+static bool soft_distance_add(cyclone_SoftDistanceSet *set, const cyclone_ParticleWorld *world,
+                              size_t a, size_t b)
+{
+    if (!soft_distance_reserve(set, set->count + 1))
+        return false;
+
+    cyclone_Vector3 d = cyclone_vector3_sub(soft_position(world, b), soft_position(world, a));
+    set->a[set->count] = a;
+    set->b[set->count] = b;
+    set->rest[set->count] = cyclone_vector3_magnitude(&d);
+    set->lambda[set->count] = (real)0;
+    set->count++;
+    return true;
+}
+
+bool cyclone_soft_body_add_stretch(cyclone_SoftBody *body, const cyclone_ParticleWorld *world,
+                                   size_t a, size_t b)
+{
+    body->prepared = false;
+    return soft_distance_add(&body->stretch, world, a, b);
+}
+
+bool cyclone_soft_body_add_bend(cyclone_SoftBody *body, const cyclone_ParticleWorld *world,
+                                size_t a, size_t b)
+{
+    body->prepared = false;
+    return soft_distance_add(&body->bend, world, a, b);
+}
+
+/* Six times the signed volume of tetrahedron p0 p1 p2 p3 */
+static real soft_volume6(cyclone_Vector3 p0, cyclone_Vector3 p1, cyclone_Vector3 p2, cyclone_Vector3 p3)
+{
+    cyclone_Vector3 e1 = cyclone_vector3_sub(p1, p0);
+    cyclone_Vector3 e2 = cyclone_vector3_sub(p2, p0);
+    cyclone_Vector3 e3 = cyclone_vector3_sub(p3, p0);
+    return cyclone_vector3_dot(cyclone_vector3_cross(e1, e2), e3);
+}
+
+bool cyclone_soft_body_add_tetrahedron(cyclone_SoftBody *body, const cyclone_ParticleWorld *world,
+                                       size_t i0, size_t i1, size_t i2, size_t i3)
+{
+    cyclone_SoftVolumeSet *set = &body->volume;
+    if (!soft_volume_reserve(set, set->count + 1))
+        return false;
+
+    size_t n = set->count;
+    set->index[0][n] = i0;
+    set->index[1][n] = i1;
+    set->index[2][n] = i2;
+    set->index[3][n] = i3;
+    set->rest[n] = soft_volume6(soft_position(world, i0), soft_position(world, i1),
+                                soft_position(world, i2), soft_position(world, i3)) / (real)6;
+    set->lambda[n] = (real)0;
+    set->count++;
+    body->prepared = false;
+    return true;
+}
+
+typedef struct soft_edge {
+    size_t low;
+    size_t high;
+    size_t opposite;                /* third vertex of the triangle */
+} soft_edge;
+
+/* Same edge: 0 when a and b join the same two vertices */
+static int soft_edge_compare(const void *x, const void *y)
+{
+    const soft_edge *a = x;
+    const soft_edge *b = y;
+    if (a->low != b->low)
+        return a->low < b->low ? -1 : 1;
+    if (a->high != b->high)
+        return a->high < b->high ? -1 : 1;
+    return 0;
+}
+
+/* Sort order: by edge, then by opposite vertex, so no two distinct entries tie */
+static int soft_edge_order(const void *x, const void *y)
+{
+    int edge = soft_edge_compare(x, y);
+    if (edge != 0)
+        return edge;
+    const soft_edge *a = x;
+    const soft_edge *b = y;
+    if (a->opposite != b->opposite)
+        return a->opposite < b->opposite ? -1 : 1;
+    return 0;
+}
+
+bool cyclone_soft_body_add_triangles(cyclone_SoftBody *body, const cyclone_ParticleWorld *world,
+                                     const size_t *indices, size_t triangle_count)
+{
+    if (triangle_count == 0)
+        return true;
+
+    soft_edge *edges = malloc(triangle_count * 3 * sizeof(soft_edge));
+    if (!edges)
+        return false;
+
+    for (size_t t = 0; t < triangle_count; ++t)
+    {
+        for (int e = 0; e < 3; ++e)
+        {
+            size_t p = indices[3 * t + e];
+            size_t q = indices[3 * t + (e + 1) % 3];
+            soft_edge *edge = &edges[3 * t + e];
+            edge->low = p < q ? p : q;
+            edge->high = p < q ? q : p;
+            edge->opposite = indices[3 * t + (e + 2) % 3];
+        }
+    }
+
+    /*
+     * Sorting groups each edge with its copies from neighbouring
+     * triangles. qsort is not stable, so the opposite vertex breaks ties:
+     * the order, and with it the constraints and the results, depends
+     * only on the input.
+     */
+    size_t edge_count = triangle_count * 3;
+    qsort(edges, edge_count, sizeof(soft_edge), soft_edge_order);
+
+    bool ok = soft_distance_reserve(&body->stretch, body->stretch.count + edge_count) &&
+              soft_distance_reserve(&body->bend, body->bend.count + edge_count / 2);
+
+    size_t run = 0;
+    while (ok && run < edge_count)
+    {
+        size_t end = run + 1;
+        while (end < edge_count && soft_edge_compare(&edges[run], &edges[end]) == 0)
+            ++end;
+
+        ok = soft_distance_add(&body->stretch, world, edges[run].low, edges[run].high);
+        if (ok && end - run == 2)
+            ok = soft_distance_add(&body->bend, world, edges[run].opposite, edges[run + 1].opposite);
+        run = end;
+    }
+
+    free(edges);
+    body->prepared = false;
+    return ok;
+}
+
+bool cyclone_soft_body_add_cloth(cyclone_SoftBody *body, cyclone_ParticleWorld *world,
+                                 cyclone_Vector3 origin, cyclone_Vector3 u, cyclone_Vector3 v,
+                                 size_t columns, size_t rows, real mass, real damping,
+                                 size_t *out_first)
+{
+    if (columns == 0 || rows == 0)
+        return false;
+    if (!cyclone_particle_world_reserve(world, world->count + columns * rows))
+        return false;
+
+    size_t first = world->count;
+    for (size_t r = 0; r < rows; ++r)
+    {
+        for (size_t c = 0; c < columns; ++c)
+        {
+            cyclone_Vector3 p = origin;
+            cyclone_vector3_add_scaled(&p, &u, (real)c);
+            cyclone_vector3_add_scaled(&p, &v, (real)r);
+            cyclone_particle_world_add(world, p, cyclone_vector3_zero(), mass, damping, NULL);
+        }
+    }
+
+    size_t triangle_count = (columns - 1) * (rows - 1) * 2;
+    size_t *indices = triangle_count ? malloc(triangle_count * 3 * sizeof(size_t)) : NULL;
+    if (triangle_count && !indices)
+        return false;
+
+    size_t n = 0;
+    for (size_t r = 0; r + 1 < rows; ++r)
+    {
+        for (size_t c = 0; c + 1 < columns; ++c)
+        {
+            size_t i00 = first + r * columns + c;
+            size_t i10 = i00 + 1;
+            size_t i01 = i00 + columns;
+            size_t i11 = i01 + 1;
+
+            indices[n++] = i00; indices[n++] = i10; indices[n++] = i11;
+            indices[n++] = i00; indices[n++] = i11; indices[n++] = i01;
+        }
+    }
+
+    bool ok = cyclone_soft_body_add_triangles(body, world, indices, triangle_count);
+    free(indices);
+
+    if (ok && out_first)
+        *out_first = first;
+    return ok;
+}
+
+/* ============================================================
+ * Colliders
+ * ============================================================
+ */
+
+static cyclone_Vector3 soft_vector(vec3 v)
+{
+    return cyclone_vector3_make((real)v.x, (real)v.y, (real)v.z);
+}
+
+bool cyclone_soft_body_add_sphere(cyclone_SoftBody *body, const Sphere *sphere)
+{
+    if (!soft_reserve((void **)&body->spheres, &body->sphere_capacity,
+                      body->sphere_count + 1, sizeof(Sphere)))
+        return false;
+
+    body->spheres[body->sphere_count++] = *sphere;
+    return true;
+}
+
+bool cyclone_soft_body_add_obb(cyclone_SoftBody *body, const OBB *obb)
+{
+    if (!soft_reserve((void **)&body->boxes, &body->box_capacity,
+                      body->box_count + 1, sizeof(OBB)))
+        return false;
+
+    body->boxes[body->box_count++] = *obb;
+    return true;
+}
+
+bool cyclone_soft_body_add_mesh(cyclone_SoftBody *body, const Mesh *mesh)
+{
+    if (!soft_reserve((void **)&body->meshes, &body->mesh_capacity,
+                      body->mesh_count + 1, sizeof(const Mesh *)))
+        return false;
+
+    body->meshes[body->mesh_count++] = mesh;
+    return true;
+}
+
+void cyclone_soft_body_clear_colliders(cyclone_SoftBody *body)
+{
+    body->sphere_count = 0;
+    body->box_count = 0;
+    body->mesh_count = 0;
+}
+
+/* ============================================================
+ * Colouring
+ * ============================================================
+ */
+
+/*
+ * Greedy first-fit colouring of constraints over arity particle indices,
+ * then a stable counting sort: writes each constraint's new position to
+ * order and fills color_start. Constraints that fit none of the colours
+ * form the sequential group after the last used colour.
+ */
+static bool soft_color(cyclone_SoftBody *body, size_t particle_count,
+                       size_t *const *index, int arity, size_t count,
+                       size_t *order, size_t *color_start, size_t *color_count)
+{
+    if (!soft_reserve((void **)&body->color_mask, &body->color_mask_capacity,
+                      particle_count, sizeof(uint64_t)))
+        return false;
+    if (particle_count > 0)
+        memset(body->color_mask, 0, particle_count * sizeof(uint64_t));
+
+    memset(color_start, 0, (CYCLONE_SOFT_MAX_COLORS + 2) * sizeof(size_t));
+    size_t *counts = color_start + 1;
+    size_t uncolored = 0;
+    int used = 0;
+
+    /* order temporarily holds each constraint's colour */
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint64_t taken = 0;
+        for (int k = 0; k < arity; ++k)
+            taken |= body->color_mask[index[k][i]];
+
+        int color = 0;
+        while (color < CYCLONE_SOFT_MAX_COLORS && (taken >> color) & 1u)
+            ++color;
+
+        order[i] = (size_t)color;
+        if (color < CYCLONE_SOFT_MAX_COLORS)
+        {
+            for (int k = 0; k < arity; ++k)
+                body->color_mask[index[k][i]] |= (uint64_t)1 << color;
+            used = color + 1 > used ? color + 1 : used;
+            counts[color]++;
+        }
+        else
+        {
+            uncolored++;
+        }
+    }
+
+    counts[used] = uncolored;
+    for (int c = 0; c <= used; ++c)
+        color_start[c + 1] += color_start[c];
+
+    size_t cursor[CYCLONE_SOFT_MAX_COLORS + 1];
+    memcpy(cursor, color_start, sizeof(cursor));
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t group = order[i] < CYCLONE_SOFT_MAX_COLORS ? order[i] : (size_t)used;
+        order[i] = cursor[group]++;
+    }
+
+    *color_count = (size_t)used;
+    return true;
+}
+
+/* Move array[i] to array[order[i]], using scratch */
+static void soft_permute(void *array, size_t element, const size_t *order, size_t count, void *scratch)
+{
+    unsigned char *from = array;
+    unsigned char *to = scratch;
+    for (size_t i = 0; i < count; ++i)
+        memcpy(to + order[i] * element, from + i * element, element);
+    if (count > 0)
+        memcpy(array, scratch, count * element);
+}
+
+static bool soft_prepare_distance(cyclone_SoftBody *body, cyclone_SoftDistanceSet *set,
+                                  size_t particle_count)
+{
+    size_t element = sizeof(size_t) > sizeof(real) ? sizeof(size_t) : sizeof(real);
+    size_t *order = malloc((set->count ? set->count : 1) * sizeof(size_t));
+    void *scratch = malloc((set->count ? set->count : 1) * element);
+    size_t *index[2] = { set->a, set->b };
+
+    bool ok = order && scratch &&
+              soft_color(body, particle_count, index, 2, set->count,
+                         order, set->color_start, &set->color_count);
+    if (ok)
+    {
+        soft_permute(set->a, sizeof(size_t), order, set->count, scratch);
+        soft_permute(set->b, sizeof(size_t), order, set->count, scratch);
+        soft_permute(set->rest, sizeof(real), order, set->count, scratch);
+    }
+
+    free(order);
+    free(scratch);
+    return ok;
+}
+
+static bool soft_prepare_volume(cyclone_SoftBody *body, cyclone_SoftVolumeSet *set,
+                                size_t particle_count)
+{
+    size_t element = sizeof(size_t) > sizeof(real) ? sizeof(size_t) : sizeof(real);
+    size_t *order = malloc((set->count ? set->count : 1) * sizeof(size_t));
+    void *scratch = malloc((set->count ? set->count : 1) * element);
+
+    bool ok = order && scratch &&
+              soft_color(body, particle_count, set->index, 4, set->count,
+                         order, set->color_start, &set->color_count);
+    if (ok)
+    {
+        for (int k = 0; k < 4; ++k)
+            soft_permute(set->index[k], sizeof(size_t), order, set->count, scratch);
+        soft_permute(set->rest, sizeof(real), order, set->count, scratch);
+    }
+
+    free(order);
+    free(scratch);
+    return ok;
+}
+
+bool cyclone_soft_body_prepare(cyclone_SoftBody *body, const cyclone_ParticleWorld *world)
+{
+    if (body->prepared)
+        return true;
+
+    body->prepared = soft_prepare_distance(body, &body->stretch, world->count) &&
+                     soft_prepare_distance(body, &body->bend, world->count) &&
+                     soft_prepare_volume(body, &body->volume, world->count);
+    return body->prepared;
+}
+
+/* ============================================================
+ * Projection
+ * ============================================================
+ */
+
+/* Constraints per worker below which a colour is not worth splitting */
+#define SOFT_JOB_GRAIN 256
+
+typedef struct soft_job {
+    cyclone_SoftBody *body;
+    cyclone_ParticleWorld *world;
+    cyclone_SoftDistanceSet *distance;
+    cyclone_SoftVolumeSet *volume;
+    size_t first;                   /* constraint of the range's index 0 */
+    real alpha;                     /* compliance / substep^2 */
+} soft_job;
+
+static void soft_project_distance(void *context, size_t begin, size_t end, int worker)
+{
+    (void)worker;
+    soft_job *job = context;
+    cyclone_SoftDistanceSet *set = job->distance;
+    real *x = job->world->position[0];
+    real *y = job->world->position[1];
+    real *z = job->world->position[2];
+    const real *inverse_mass = job->world->inverse_mass;
+    real alpha = job->alpha;
+
+    for (size_t k = begin; k < end; ++k)
+    {
+        size_t c = job->first + k;
+        size_t a = set->a[c];
+        size_t b = set->b[c];
+
+        real wa = inverse_mass[a];
+        real wb = inverse_mass[b];
+        real w = wa + wb;
+        if (w <= (real)0)
+            continue;
+
+        real dx = x[b] - x[a];
+        real dy = y[b] - y[a];
+        real dz = z[b] - z[a];
+        real length = real_sqrt(dx * dx + dy * dy + dz * dz);
+        if (length <= (real)0)
+            continue;
+
+        real error = length - set->rest[c];
+        real delta = (-error - alpha * set->lambda[c]) / (w + alpha);
+        set->lambda[c] += delta;
+
+        real s = delta / length;
+        x[a] -= wa * s * dx;  y[a] -= wa * s * dy;  z[a] -= wa * s * dz;
+        x[b] += wb * s * dx;  y[b] += wb * s * dy;  z[b] += wb * s * dz;
+    }
+}
+
+/*
+ * C = V - V0 with gradient (1/6) of the cross product of the opposite
+ * face's edges for each corner, ordered to point outwards.
+ */
+static void soft_project_volume(void *context, size_t begin, size_t end, int worker)
+{
+    (void)worker;
+    static const int face[4][3] = { { 1, 3, 2 }, { 0, 2, 3 }, { 0, 3, 1 }, { 0, 1, 2 } };
+
+    soft_job *job = context;
+    cyclone_SoftVolumeSet *set = job->volume;
+    real *const *position = job->world->position;
+    const real *inverse_mass = job->world->inverse_mass;
+    real alpha = job->alpha;
+
+    for (size_t k = begin; k < end; ++k)
+    {
+        size_t c = job->first + k;
+        size_t id[4];
+        cyclone_Vector3 p[4];
+        for (int j = 0; j < 4; ++j)
+        {
+            id[j] = set->index[j][c];
+            p[j] = cyclone_vector3_make(position[0][id[j]], position[1][id[j]], position[2][id[j]]);
+        }
+
+        cyclone_Vector3 grad[4];
+        real w = (real)0;
+        for (int j = 0; j < 4; ++j)
+        {
+            cyclone_Vector3 e1 = cyclone_vector3_sub(p[face[j][1]], p[face[j][0]]);
+            cyclone_Vector3 e2 = cyclone_vector3_sub(p[face[j][2]], p[face[j][0]]);
+            grad[j] = cyclone_vector3_cross(e1, e2);
+            cyclone_vector3_scale_inplace(&grad[j], (real)1 / (real)6);
+            w += inverse_mass[id[j]] * cyclone_vector3_square_magnitude(&grad[j]);
+        }
+        if (w <= (real)0)
+            continue;
+
+        real error = soft_volume6(p[0], p[1], p[2], p[3]) / (real)6 - set->rest[c];
+        real delta = (-error - alpha * set->lambda[c]) / (w + alpha);
+        set->lambda[c] += delta;
+
+        for (int j = 0; j < 4; ++j)
+        {
+            real s = delta * inverse_mass[id[j]];
+            position[0][id[j]] += s * grad[j].x;
+            position[1][id[j]] += s * grad[j].y;
+            position[2][id[j]] += s * grad[j].z;
+        }
+    }
+}
+
+/* Run function over every colour of a set, then the sequential group */
+static void soft_sweep(soft_job *job, const size_t *color_start, size_t color_count,
+                       cyclone_JobFunction function)
+{
+    for (size_t color = 0; color <= color_count; ++color)
+    {
+        size_t begin = color_start[color];
+        size_t count = color_start[color + 1] - begin;
+        if (count == 0)
+            continue;
+
+        job->first = begin;
+        if (color < color_count)
+            cyclone_job_pool_run(job->body->pool, count, SOFT_JOB_GRAIN, function, job);
+        else
+            function(job, 0, count, 0);
+    }
+}
+
+/* ============================================================
+ * Collision
+ * ============================================================
+ */
+
+/*
+ * Stack for walking a mesh BVH: seven siblings left per level, plus the
+ * root. Enough for any tree mesh_accelerate builds; a deeper one walks
+ * the children that do not fit with a fresh stack each.
+ */
+#define SOFT_BVH_STACK (7 * BVH_MAX_DEPTH + 1)
+
+typedef struct soft_contact {
+    bool hit;
+    cyclone_Vector3 normal;         /* of the last surface touched */
+} soft_contact;
+
+static Point3D soft_point(cyclone_Vector3 v)
+{
+    return vec3_make((float)v.x, (float)v.y, (float)v.z);
+}
+
+/* Move the particle to thickness from the surface point q, directly away from it */
+static void soft_push_from(cyclone_Vector3 q, real thickness, cyclone_Vector3 *p,
+                           soft_contact *contact)
+{
+    cyclone_Vector3 d = cyclone_vector3_sub(*p, q);
+    real distance2 = cyclone_vector3_square_magnitude(&d);
+    if (distance2 >= thickness * thickness || distance2 <= (real)0)
+        return;
+
+    real distance = real_sqrt(distance2);
+    contact->normal = cyclone_vector3_make(d.x / distance, d.y / distance, d.z / distance);
+    *p = q;
+    cyclone_vector3_add_scaled(p, &contact->normal, thickness);
+    contact->hit = true;
+}
+
+static void soft_collide_sphere(const Sphere *sphere, real thickness,
+                                cyclone_Vector3 *p, soft_contact *contact)
+{
+    cyclone_Vector3 center = soft_vector(sphere->position);
+    cyclone_Vector3 d = cyclone_vector3_sub(*p, center);
+    real reach = (real)sphere->radius + thickness;
+    real distance2 = cyclone_vector3_square_magnitude(&d);
+    if (distance2 >= reach * reach || distance2 <= (real)0)
+        return;
+
+    /* Inside, p - q points back at the centre, so push along d instead */
+    real distance = real_sqrt(distance2);
+    contact->normal = cyclone_vector3_make(d.x / distance, d.y / distance, d.z / distance);
+    *p = soft_vector(closest_point_on_sphere(*sphere, soft_point(*p)));
+    cyclone_vector3_add_scaled(p, &contact->normal, thickness);
+    contact->hit = true;
+}
+
+/*
+ * Outside the box, keep thickness from its closest point. Inside, the
+ * closest point is the particle itself, so leave through the nearest face.
+ */
+static void soft_collide_box(const OBB *box, real thickness,
+                             cyclone_Vector3 *p, soft_contact *contact)
+{
+    Point3D point = soft_point(*p);
+    if (!point_in_obb(point, *box))
+    {
+        soft_push_from(soft_vector(closest_point_on_obb(*box, point)), thickness, p, contact);
+        return;
+    }
+
+    cyclone_Vector3 d = cyclone_vector3_sub(*p, soft_vector(box->position));
+    cyclone_Vector3 axis[3];
+    int face = 0;
+    real least = (real)0;
+    real side = (real)1;
+    for (int k = 0; k < 3; ++k)
+    {
+        axis[k] = cyclone_vector3_make((real)box->orientation.m[k][0],
+                                       (real)box->orientation.m[k][1],
+                                       (real)box->orientation.m[k][2]);
+        real q = cyclone_vector3_dot(d, axis[k]);
+        real depth = (real)box->size.v[k] + thickness - real_abs(q);
+        if (k == 0 || depth < least)
+        {
+            face = k;
+            least = depth;
+            side = q < (real)0 ? (real)-1 : (real)1;
+        }
+    }
+
+    contact->normal = axis[face];
+    cyclone_vector3_scale_inplace(&contact->normal, side);
+    cyclone_vector3_add_scaled(p, &contact->normal, least);
+    contact->hit = true;
+}
+
+/*
+ * Keep the particle thickness from the triangle. Over the interior it is
+ * held on the side it was on before the substep, so a particle that went
+ * through the plane in one substep comes back; elsewhere it is pushed
+ * away from the closest point on the nearest edge or vertex.
+ */
+static void soft_collide_triangle(const Triangle *triangle, real thickness,
+                                  cyclone_Vector3 previous, cyclone_Vector3 *p,
+                                  soft_contact *contact)
+{
+    cyclone_Vector3 v[3];
+    for (int k = 0; k < 3; ++k)
+        v[k] = soft_vector(triangle->points[k]);
+
+    cyclone_Vector3 normal = cyclone_vector3_cross(cyclone_vector3_sub(v[1], v[0]),
+                                                   cyclone_vector3_sub(v[2], v[0]));
+    real length = cyclone_vector3_magnitude(&normal);
+    if (length <= (real)0)
+        return;
+    cyclone_vector3_scale_inplace(&normal, (real)1 / length);
+
+    real height = cyclone_vector3_dot(cyclone_vector3_sub(*p, v[0]), normal);
+    real before = cyclone_vector3_dot(cyclone_vector3_sub(previous, v[0]), normal);
+    real side = before < (real)0 ? (real)-1 : (real)1;
+    if (side * height >= thickness)
+        return;
+
+    cyclone_Vector3 q = *p;
+    cyclone_vector3_add_scaled(&q, &normal, -height);
+    if (!point_in_triangle(soft_point(q), *triangle))
+    {
+        soft_push_from(soft_vector(closest_point_on_triangle(*triangle, soft_point(*p))),
+                       thickness, p, contact);
+        return;
+    }
+
+    cyclone_vector3_scale_inplace(&normal, side);
+    cyclone_vector3_add_scaled(p, &normal, thickness - side * height);
+    contact->normal = normal;
+    contact->hit = true;
+}
+
+static bool soft_aabb_overlaps(const AABB *box, cyclone_Vector3 p, real reach)
+{
+    return real_abs(p.x - (real)box->position.x) <= (real)box->size.x + reach &&
+           real_abs(p.y - (real)box->position.y) <= (real)box->size.y + reach &&
+           real_abs(p.z - (real)box->position.z) <= (real)box->size.z + reach;
+}
+
+static void soft_collide_tree(const Mesh *mesh, const BVHNode *root, real thickness,
+                              cyclone_Vector3 previous, cyclone_Vector3 *p, soft_contact *contact)
+{
+    const BVHNode *stack[SOFT_BVH_STACK];
+    int top = 0;
+    stack[top++] = root;
+
+    while (top > 0)
+    {
+        const BVHNode *node = stack[--top];
+        if (!soft_aabb_overlaps(&node->bounds, *p, thickness))
+            continue;
+
+        for (int t = 0; t < node->num_triangles; ++t)
+            soft_collide_triangle(&mesh->triangles[node->triangles[t]], thickness, previous, p, contact);
+
+        if (node->children)
+        {
+            for (int c = 0; c < 8; ++c)
+            {
+                if (top < SOFT_BVH_STACK)
+                    stack[top++] = &node->children[c];
+                else
+                    soft_collide_tree(mesh, &node->children[c], thickness, previous, p, contact);
+            }
+        }
+    }
+}
+
+static void soft_collide_mesh(const Mesh *mesh, real thickness, cyclone_Vector3 previous,
+                              cyclone_Vector3 *p, soft_contact *contact)
+{
+    if (!mesh->accelerator)
+    {
+        for (int t = 0; t < mesh->num_triangles; ++t)
+            soft_collide_triangle(&mesh->triangles[t], thickness, previous, p, contact);
+        return;
+    }
+    soft_collide_tree(mesh, mesh->accelerator, thickness, previous, p, contact);
+}
+
+static void soft_collide_range(void *context, size_t begin, size_t end, int worker)
+{
+    (void)worker;
+    soft_job *job = context;
+    const cyclone_SoftBody *body = job->body;
+    cyclone_ParticleWorld *world = job->world;
+    real thickness = body->thickness;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (world->inverse_mass[i] <= (real)0)
+            continue;
+
+        cyclone_Vector3 previous = cyclone_vector3_make(body->previous[0][i], body->previous[1][i],
+                                                        body->previous[2][i]);
+        cyclone_Vector3 p = soft_position(world, i);
+        soft_contact contact = { false, { 0 } };
+
+        for (size_t s = 0; s < body->sphere_count; ++s)
+            soft_collide_sphere(&body->spheres[s], thickness, &p, &contact);
+        for (size_t b = 0; b < body->box_count; ++b)
+            soft_collide_box(&body->boxes[b], thickness, &p, &contact);
+        for (size_t m = 0; m < body->mesh_count; ++m)
+            soft_collide_mesh(body->meshes[m], thickness, previous, &p, &contact);
+
+        if (!contact.hit)
+            continue;
+
+        /* Friction: take back part of the sliding over the surface */
+        cyclone_Vector3 moved = cyclone_vector3_sub(p, previous);
+        cyclone_Vector3 slide = moved;
+        cyclone_vector3_add_scaled(&slide, &contact.normal, -cyclone_vector3_dot(moved, contact.normal));
+        cyclone_vector3_add_scaled(&p, &slide, -body->friction);
+
+        world->position[0][i] = p.x;
+        world->position[1][i] = p.y;
+        world->position[2][i] = p.z;
+    }
+}
+
+/* ============================================================
+ * Stepping
+ * ============================================================
+ */
+
+/* v = (p - previous) / h for movable particles */
+static void soft_update_velocity_axis(const real *restrict p,
+                                      const real *restrict previous,
+                                      real *restrict v,
+                                      const real *restrict inverse_mass,
+                                      size_t count,
+                                      real inverse_step)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        real vel = (p[i] - previous[i]) * inverse_step;
+        v[i] = inverse_mass[i] > (real)0 ? vel : v[i];
+    }
+}
+
+/* Start, resize or stop the worker pool to match body->threads */
+static void soft_update_pool(cyclone_SoftBody *body)
+{
+    int wanted = body->threads > 1 ? body->threads : 1;
+    if (wanted == body->pool_threads && (body->pool || wanted == 1))
+        return;
+
+    cyclone_job_pool_destroy(body->pool);
+    body->pool = wanted > 1 ? cyclone_job_pool_create(wanted) : NULL;
+    body->pool_threads = wanted;
+}
+
+bool cyclone_soft_body_step(cyclone_SoftBody *body, cyclone_ParticleWorld *world, real duration)
+{
+    if (duration <= (real)0 || body->substeps < 1)
+        return true;
+
+    if (!cyclone_soft_body_prepare(body, world))
+        return false;
+
+    if (world->count > body->previous_capacity)
+    {
+        size_t capacity = body->previous_capacity;
+        for (int k = 0; k < 3; ++k)
+        {
+            capacity = body->previous_capacity;
+            if (!soft_reserve((void **)&body->previous[k], &capacity, world->count, sizeof(real)))
+                return false;
+        }
+        body->previous_capacity = capacity;
+    }
+
+    soft_update_pool(body);
+
+    real h = duration / (real)body->substeps;
+    real inverse_h2 = (real)1 / (h * h);
+    size_t bytes = world->count * sizeof(real);
+
+    soft_job job;
+    job.body = body;
+    job.world = world;
+    job.distance = NULL;
+    job.volume = &body->volume;
+
+    for (int step = 0; step < body->substeps; ++step)
+    {
+        if (bytes > 0)
+        {
+            for (int k = 0; k < 3; ++k)
+                memcpy(body->previous[k], world->position[k], bytes);
+        }
+
+        /* The particle world's own step is the prediction */
+        cyclone_particle_world_run_physics(world, h);
+
+        if (body->stretch.count > 0)
+            memset(body->stretch.lambda, 0, body->stretch.count * sizeof(real));
+        if (body->bend.count > 0)
+            memset(body->bend.lambda, 0, body->bend.count * sizeof(real));
+        if (body->volume.count > 0)
+            memset(body->volume.lambda, 0, body->volume.count * sizeof(real));
+
+        for (int it = 0; it < body->iterations; ++it)
+        {
+            job.distance = &body->stretch;
+            job.alpha = body->stretch_compliance * inverse_h2;
+            soft_sweep(&job, body->stretch.color_start, body->stretch.color_count, soft_project_distance);
+
+            job.distance = &body->bend;
+            job.alpha = body->bend_compliance * inverse_h2;
+            soft_sweep(&job, body->bend.color_start, body->bend.color_count, soft_project_distance);
+
+            job.alpha = body->volume_compliance * inverse_h2;
+            soft_sweep(&job, body->volume.color_start, body->volume.color_count, soft_project_volume);
+        }
+
+        if (body->sphere_count + body->box_count + body->mesh_count > 0)
+            cyclone_job_pool_run(body->pool, world->count, SOFT_JOB_GRAIN, soft_collide_range, &job);
+
+        for (int k = 0; k < 3; ++k)
+            soft_update_velocity_axis(world->position[k], body->previous[k], world->velocity[k],
+                                      world->inverse_mass, world->count, (real)1 / h);
+    }
+    return true;
+}
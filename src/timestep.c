@@ -0,0 +1,211 @@
+#include "timestep.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * Clock
+ * ============================================================
+ */
+
+void cyclone_fixed_step_init(cyclone_FixedStep *clock, real step)
+{
+    clock->step = step;
+    clock->accumulator = (real)0;
+    clock->max_frame = CYCLONE_FIXED_STEP_MAX_FRAME;
+    clock->max_steps = CYCLONE_FIXED_STEP_MAX_STEPS;
+    clock->tick = 0;
+}
+
+int cyclone_fixed_step_advance(cyclone_FixedStep *clock, real elapsed)
+{
+    if (clock->step <= (real)0)
+        return 0;
+
+    elapsed = elapsed > (real)0 ? elapsed : (real)0;
+    elapsed = elapsed < clock->max_frame ? elapsed : clock->max_frame;
+    clock->accumulator += elapsed;
+
+    int steps = 0;
+    while (clock->accumulator >= clock->step && steps < clock->max_steps)
+    {
+        clock->accumulator -= clock->step;
+        steps++;
+    }
+
+    /* Behind by more than max_steps: drop whole steps, keep the phase */
+    while (clock->accumulator >= clock->step)
+        clock->accumulator -= clock->step;
+
+    clock->tick += (uint64_t)steps;
+    return steps;
+}
+
+real cyclone_fixed_step_alpha(const cyclone_FixedStep *clock)
+{
+    if (clock->step <= (real)0)
+        return (real)0;
+
+    real alpha = clock->accumulator / clock->step;
+    return alpha < (real)1 ? alpha : (real)1;
+}
+
+/* ============================================================
+ * Pose history
+ * ============================================================
+ */
+
+#define POSE_ARRAY_COUNT 7
+
+static void pose_arrays(cyclone_PoseHistory *history, real ***out)
+{
+    for (int k = 0; k < 3; ++k)
+        out[k] = &history->position[k];
+    for (int k = 0; k < 4; ++k)
+        out[3 + k] = &history->orientation[k];
+}
+
+void cyclone_pose_history_init(cyclone_PoseHistory *history)
+{
+    real **arrays[POSE_ARRAY_COUNT];
+    pose_arrays(history, arrays);
+    for (int i = 0; i < POSE_ARRAY_COUNT; ++i)
+        *arrays[i] = NULL;
+    history->count = 0;
+    history->capacity = 0;
+}
+
+void cyclone_pose_history_free(cyclone_PoseHistory *history)
+{
+    real **arrays[POSE_ARRAY_COUNT];
+    pose_arrays(history, arrays);
+    for (int i = 0; i < POSE_ARRAY_COUNT; ++i)
+        free(*arrays[i]);
+    cyclone_pose_history_init(history);
+}
+
+/* Contents are overwritten by every store, so growth copies nothing */
+static bool pose_history_reserve(cyclone_PoseHistory *history, size_t count)
+{
+    if (count <= history->capacity)
+        return true;
+
+    real *fresh[POSE_ARRAY_COUNT];
+    for (int i = 0; i < POSE_ARRAY_COUNT; ++i)
+    {
+        fresh[i] = (real *)malloc(count * sizeof(real));
+        if (!fresh[i])
+        {
+            while (i-- > 0)
+                free(fresh[i]);
+            return false;
+        }
+    }
+
+    real **arrays[POSE_ARRAY_COUNT];
+    pose_arrays(history, arrays);
+    for (int i = 0; i < POSE_ARRAY_COUNT; ++i)
+    {
+        free(*arrays[i]);
+        *arrays[i] = fresh[i];
+    }
+    history->capacity = count;
+    return true;
+}
+
+bool cyclone_pose_history_store_bodies(cyclone_PoseHistory *history, const cyclone_BodyWorld *world)
+{
+    if (!pose_history_reserve(history, world->count))
+        return false;
+
+    size_t bytes = world->count * sizeof(real);
+    if (bytes > 0)
+    {
+        for (int k = 0; k < 3; ++k)
+            memcpy(history->position[k], world->position[k], bytes);
+        for (int k = 0; k < 4; ++k)
+            memcpy(history->orientation[k], world->orientation[k], bytes);
+    }
+    history->count = world->count;
+    return true;
+}
+
+bool cyclone_pose_history_store_particles(cyclone_PoseHistory *history, const cyclone_ParticleWorld *world)
+{
+    if (!pose_history_reserve(history, world->count))
+        return false;
+
+    size_t bytes = world->count * sizeof(real);
+    if (bytes > 0)
+    {
+        for (int k = 0; k < 3; ++k)
+            memcpy(history->position[k], world->position[k], bytes);
+    }
+    history->count = world->count;
+    return true;
+}
+
+static cyclone_Vector3 pose_lerp_position(const cyclone_PoseHistory *history,
+                                          real *const current[3], size_t i, real alpha)
+{
+    cyclone_Vector3 now = cyclone_vector3_make(current[0][i], current[1][i], current[2][i]);
+    if (i >= history->count)
+        return now;
+
+    cyclone_Vector3 before = cyclone_vector3_make(history->position[0][i],
+                                                  history->position[1][i],
+                                                  history->position[2][i]);
+    cyclone_Vector3 delta = cyclone_vector3_sub(now, before);
+    cyclone_vector3_add_scaled(&before, &delta, alpha);
+    return before;
+}
+
+cyclone_Vector3 cyclone_pose_history_body_position(const cyclone_PoseHistory *history,
+                                                   const cyclone_BodyWorld *world,
+                                                   size_t i, real alpha)
+{
+    return pose_lerp_position(history, world->position, i, alpha);
+}
+
+cyclone_Vector3 cyclone_pose_history_particle_position(const cyclone_PoseHistory *history,
+                                                       const cyclone_ParticleWorld *world,
+                                                       size_t i, real alpha)
+{
+    return pose_lerp_position(history, world->position, i, alpha);
+}
+
+cyclone_Quaternion cyclone_pose_history_body_orientation(const cyclone_PoseHistory *history,
+                                                         const cyclone_BodyWorld *world,
+                                                         size_t i, real alpha)
+{
+    real now[4], before[4];
+    for (int k = 0; k < 4; ++k)
+    {
+        now[k] = world->orientation[k][i];
+        before[k] = i < history->count ? history->orientation[k][i] : now[k];
+    }
+
+    /* q and -q are the same rotation; blend towards the nearer one */
+    real dot = before[0] * now[0] + before[1] * now[1] + before[2] * now[2] + before[3] * now[3];
+    real sign = dot < (real)0 ? (real)-1 : (real)1;
+
+    real q[4];
+    for (int k = 0; k < 4; ++k)
+        q[k] = before[k] + (sign * now[k] - before[k]) * alpha;
+
+    cyclone_Quaternion result = cyclone_quaternion_make(q[0], q[1], q[2], q[3]);
+    cyclone_quaternion_normalise(&result);
+    return result;
+}
+
+cyclone_Matrix4 cyclone_pose_history_body_transform(const cyclone_PoseHistory *history,
+                                                    const cyclone_BodyWorld *world,
+                                                    size_t i, real alpha)
+{
+    cyclone_Vector3 position = cyclone_pose_history_body_position(history, world, i, alpha);
+    cyclone_Quaternion orientation = cyclone_pose_history_body_orientation(history, world, i, alpha);
+
+    cyclone_Matrix4 transform;
+    cyclone_matrix4_set_orientation_and_pos(&transform, &orientation, &position);
+    return transform;
+}
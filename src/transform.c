@@ -0,0 +1,169 @@
+/* Emit the header's inline operations as out-of-line symbols */
+#define MATH_TRANSFORM_IMPLEMENTATION
+#include "transform.h"
+#include "core.h"
+
+/* ---------- quaternions ---------- */
+
+quat quat_identity(void) {
+    quat q = { .x = 0.0f, .y = 0.0f, .z = 0.0f, .w = 1.0f };
+    return q;
+}
+
+quat quat_from_axis_angle(vec3 axis, float degrees) {
+    float s, c;
+    math_sincos(DEG2RAD(degrees) * 0.5f, &s, &c);
+    vec3 v = vec3_mul_scalar(axis, s * math_rsqrt(vec3_dot(axis, axis)));
+    quat q = { .x = v.x, .y = v.y, .z = v.z, .w = c };
+    return q;
+}
+
+quat quat_from_euler(float pitch, float yaw, float roll) {
+    float sx, cx, sy, cy, sz, cz;
+    math_sincos(DEG2RAD(pitch) * 0.5f, &sx, &cx);
+    math_sincos(DEG2RAD(yaw) * 0.5f, &sy, &cy);
+    math_sincos(DEG2RAD(roll) * 0.5f, &sz, &cz);
+
+    /* Rotation applies ZRotation first, so q = qy * qx * qz */
+    quat qx = { .x = sx, .y = 0.0f, .z = 0.0f, .w = cx };
+    quat qy = { .x = 0.0f, .y = sy, .z = 0.0f, .w = cy };
+    quat qz = { .x = 0.0f, .y = 0.0f, .z = sz, .w = cz };
+    return quat_mul(quat_mul(qy, qx), qz);
+}
+
+static inline float quat_dot(quat a, quat b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+quat quat_normalized(quat q) {
+    float inv = math_rsqrt(quat_dot(q, q));
+    for (int i = 0; i < 4; ++i) {
+        q.asArray[i] *= inv;
+    }
+    return q;
+}
+
+/* a * wa + b * wb, with b negated when it lies on the far side of a */
+static quat quat_blend(quat a, quat b, float wa, float wb) {
+    if (quat_dot(a, b) < 0.0f) {
+        wb = -wb;
+    }
+    quat q;
+    for (int i = 0; i < 4; ++i) {
+        q.asArray[i] = a.asArray[i] * wa + b.asArray[i] * wb;
+    }
+    return q;
+}
+
+quat quat_nlerp(quat a, quat b, float t) {
+    return quat_normalized(quat_blend(a, b, 1.0f - t, t));
+}
+
+quat quat_slerp(quat a, quat b, float t) {
+    float d = fabsf(quat_dot(a, b));
+    if (d > 0.9995f) {
+        /* Nearly parallel: sin(theta) is too small to divide by */
+        return quat_nlerp(a, b, t);
+    }
+
+    float theta     = acosf(d);
+    float inv_sin   = 1.0f / sinf(theta);
+    float wa        = sinf((1.0f - t) * theta) * inv_sin;
+    float wb        = sinf(t * theta) * inv_sin;
+    return quat_blend(a, b, wa, wb);
+}
+
+/* ---------- transforms ---------- */
+
+Transform transform_identity(void) {
+    return transform_make(vec3_make(0.0f, 0.0f, 0.0f), quat_identity(), vec3_make(1.0f, 1.0f, 1.0f));
+}
+
+Transform transform_make(vec3 translation, quat rotation, vec3 scale) {
+    Transform t;
+    t.translation = translation;
+    t.rotation    = rotation;
+    t.scale       = scale;
+    return t;
+}
+
+Transform transform_from_euler(vec3 translation, vec3 euler_degrees) {
+    return transform_make(translation, quat_from_euler(euler_degrees.x, euler_degrees.y, euler_degrees.z),
+                          vec3_make(1.0f, 1.0f, 1.0f));
+}
+
+Transform transform_inverse(Transform t) {
+    Transform r;
+    r.scale       = vec3_make(1.0f / t.scale.x, 1.0f / t.scale.y, 1.0f / t.scale.z);
+    r.rotation    = quat_conjugate(t.rotation);
+    r.translation = vec3_mul_scalar(vec3_mul(r.scale, quat_rotate(r.rotation, t.translation)), -1.0f);
+    return r;
+}
+
+static vec3 transform_lerp_vec3(vec3 a, vec3 b, float t) {
+    return vec3_add(a, vec3_mul_scalar(vec3_sub(b, a), t));
+}
+
+Transform transform_lerp(Transform a, Transform b, float t) {
+    return transform_make(transform_lerp_vec3(a.translation, b.translation, t),
+                          quat_nlerp(a.rotation, b.rotation, t),
+                          transform_lerp_vec3(a.scale, b.scale, t));
+}
+
+Transform transform_slerp(Transform a, Transform b, float t) {
+    return transform_make(transform_lerp_vec3(a.translation, b.translation, t),
+                          quat_slerp(a.rotation, b.rotation, t),
+                          transform_lerp_vec3(a.scale, b.scale, t));
+}
+
+/* ---------- conversions ---------- */
+
+/* r[i] is the image of axis i under the rotation, scaled by scale[i] */
+static void transform_axes(Transform t, vec3 r[3]) {
+    quat q = t.rotation;
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    r[0] = vec3_mul_scalar(vec3_make(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy)), t.scale.x);
+    r[1] = vec3_mul_scalar(vec3_make(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx)), t.scale.y);
+    r[2] = vec3_mul_scalar(vec3_make(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy)), t.scale.z);
+}
+
+mat4 transform_to_mat4(Transform t) {
+    vec3 r[3];
+    transform_axes(t, r);
+
+    mat4 m = {
+        ._11 = r[0].x,          ._12 = r[0].y,          ._13 = r[0].z,          ._14 = 0.0f,
+        ._21 = r[1].x,          ._22 = r[1].y,          ._23 = r[1].z,          ._24 = 0.0f,
+        ._31 = r[2].x,          ._32 = r[2].y,          ._33 = r[2].z,          ._34 = 0.0f,
+        ._41 = t.translation.x, ._42 = t.translation.y, ._43 = t.translation.z, ._44 = 1.0f
+    };
+    return m;
+}
+
+void transform_to_cyclone_matrix4(Transform t, cyclone_Matrix4 *out) {
+    vec3 r[3];
+    transform_axes(t, r);
+
+    /* The axes are the columns here */
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            out->data[row * 4 + col] = (real)r[col].v[row];
+        }
+        out->data[row * 4 + 3] = (real)t.translation.v[row];
+    }
+}
+
+Transform transform_from_cyclone(const cyclone_Vector3 *position, const cyclone_Quaternion *orientation) {
+    /* cyclone_matrix4_set_orientation_and_pos rotates by the conjugate of (i, j, k, r) */
+    quat q = {
+        .x = (float)-orientation->i,
+        .y = (float)-orientation->j,
+        .z = (float)-orientation->k,
+        .w = (float)orientation->r
+    };
+    return transform_make(vec3_make((float)position->x, (float)position->y, (float)position->z),
+                          q, vec3_make(1.0f, 1.0f, 1.0f));
+}
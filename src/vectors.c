@@ -1,5 +1,7 @@
 /* vectors.c – C23 implementation */
 
+/* Emit the header's inline vec3 operations as out-of-line symbols */
+#define MATH_VECTORS_IMPLEMENTATION
 #include "vectors.h"
 #include "compare.h"   /* single source for CMP / float comparisons */
 
@@ -60,14 +62,6 @@ vec2 vec2_make(float x, float y) {
     return v;
 }
 
-vec3 vec3_make(float x, float y, float z) {
-    vec3 v;
-    v.x = x;
-    v.y = y;
-    v.z = z;
-    return v;
-}
-
 float vec2_get(const vec2 *v, size_t index) {
     if (v == NULL || index >= 2U) {
         return 0.0f;
@@ -127,14 +121,6 @@ vec2 vec2_add(vec2 l, vec2 r) {
     return out;
 }
 
-vec3 vec3_add(vec3 l, vec3 r) {
-    vec3 out;
-    out.x = l.x + r.x;
-    out.y = l.y + r.y;
-    out.z = l.z + r.z;
-    return out;
-}
-
 vec2 vec2_sub(vec2 l, vec2 r) {
     vec2 out;
     out.x = l.x - r.x;
@@ -142,14 +128,6 @@ vec2 vec2_sub(vec2 l, vec2 r) {
     return out;
 }
 
-vec3 vec3_sub(vec3 l, vec3 r) {
-    vec3 out;
-    out.x = l.x - r.x;
-    out.y = l.y - r.y;
-    out.z = l.z - r.z;
-    return out;
-}
-
 /* Component-wise multiply */
 
 vec2 vec2_mul(vec2 l, vec2 r) {
@@ -159,14 +137,6 @@ vec2 vec2_mul(vec2 l, vec2 r) {
     return out;
 }
 
-vec3 vec3_mul(vec3 l, vec3 r) {
-    vec3 out;
-    out.x = l.x * r.x;
-    out.y = l.y * r.y;
-    out.z = l.z * r.z;
-    return out;
-}
-
 /* Scalar multiply */
 
 vec2 vec2_mul_scalar(vec2 v, float s) {
@@ -176,14 +146,6 @@ vec2 vec2_mul_scalar(vec2 v, float s) {
     return out;
 }
 
-vec3 vec3_mul_scalar(vec3 v, float s) {
-    vec3 out;
-    out.x = v.x * s;
-    out.y = v.y * s;
-    out.z = v.z * s;
-    return out;
-}
-
 #ifndef NO_EXTRAS
 /* Component-wise divide */
 
@@ -352,26 +314,14 @@ float vec2_dot(vec2 l, vec2 r) {
     return l.x * r.x + l.y * r.y;
 }
 
-float vec3_dot(vec3 l, vec3 r) {
-    return l.x * r.x + l.y * r.y + l.z * r.z;
-}
-
 float vec2_magnitude_sq(vec2 v) {
     return vec2_dot(v, v);
 }
 
-float vec3_magnitude_sq(vec3 v) {
-    return vec3_dot(v, v);
-}
-
 float vec2_magnitude(vec2 v) {
     return sqrtf(vec2_magnitude_sq(v));
 }
 
-float vec3_magnitude(vec3 v) {
-    return sqrtf(vec3_magnitude_sq(v));
-}
-
 #ifndef NO_EXTRAS
 float vec2_distance(vec2 p1, vec2 p2) {
     return vec2_magnitude(vec2_sub(p1, p2));
@@ -397,8 +347,8 @@ float vec3_distance_sq(vec3 p1, vec3 p2) {
 #ifndef NO_EXTRAS
 vec2 vec2_rotate(vec2 vector, float degrees) {
     float radians = DEG2RAD(degrees);
-    float s       = sinf(radians);
-    float c       = cosf(radians);
+    float s, c;
+    math_sincos(radians, &s, &c);
 
     vec2 out;
     out.x = vector.x * c - vector.y * s;
@@ -415,42 +365,18 @@ void vec2_normalize(vec2 *v) {
     if (v == NULL) {
         return;
     }
-    float mag = vec2_magnitude(*v);
-    float inv = 1.0f / mag;
-    *v        = vec2_mul_scalar(*v, inv);
+    *v = vec2_mul_scalar(*v, math_rsqrt(vec2_magnitude_sq(*v)));
 }
 
 void vec3_normalize(vec3 *v) {
     if (v == NULL) {
         return;
     }
-    float mag = vec3_magnitude(*v);
-    float inv = 1.0f / mag;
-    *v        = vec3_mul_scalar(*v, inv);
+    *v = vec3_mul_scalar(*v, math_rsqrt(vec3_dot(*v, *v)));
 }
 
 vec2 vec2_normalized(vec2 v) {
-    float mag = vec2_magnitude(v);
-    float inv = 1.0f / mag;
-    return vec2_mul_scalar(v, inv);
-}
-
-vec3 vec3_normalized(vec3 v) {
-    float mag = vec3_magnitude(v);
-    float inv = 1.0f / mag;
-    return vec3_mul_scalar(v, inv);
-}
-
-/* ------------------------------------------------------------------------- */
-/* Cross product (3D)                                                        */
-/* ------------------------------------------------------------------------- */
-
-vec3 vec3_cross(vec3 l, vec3 r) {
-    vec3 result;
-    result.x = l.y * r.z - l.z * r.y;
-    result.y = l.z * r.x - l.x * r.z;
-    result.z = l.x * r.y - l.y * r.x;
-    return result;
+    return vec2_mul_scalar(v, math_rsqrt(vec2_magnitude_sq(v)));
 }
 
 /* ------------------------------------------------------------------------- */
@@ -511,22 +437,6 @@ vec3 vec3_reflect(vec3 sourceVector, vec3 normal) {
 /* Compatibility wrappers for matrices.c                                    */
 /* ------------------------------------------------------------------------- */
 
-float Dot(vec3 a, vec3 b) {
-    return vec3_dot(a, b);
-}
-
-vec3 Cross(vec3 a, vec3 b) {
-    return vec3_cross(a, b);
-}
-
-float Magnitude(vec3 v) {
-    return vec3_magnitude(v);
-}
-
-float MagnitudeSq(vec3 v) {
-    return vec3_magnitude_sq(v);
-}
-
 vec3 Normalized(vec3 v) {
     return vec3_normalized(v);
 }
@@ -537,6 +447,3 @@ vec2 vec2_scale(vec2 v, float scalar) {
     return vec2_mul_scalar(v, scalar);
 }
 
-vec3 vec3_scale(vec3 v, float scalar) {
-    return vec3_mul_scalar(v, scalar);
-}
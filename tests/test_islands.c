@@ -0,0 +1,178 @@
+/*
+ * cyclone_islands_build against a naive union-find: random contact graphs,
+ * with static rows and immovable bodies mixed in, must come out as the
+ * same partition of bodies, with every row in the island of its movable
+ * body.
+ */
+#include "islands.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                    \
+    do                                                                      \
+    {                                                                       \
+        if (!(condition))                                                   \
+        {                                                                   \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, \
+                    #condition);                                            \
+            failures++;                                                     \
+            return;                                                         \
+        }                                                                   \
+    } while (0)
+
+/* Small deterministic generator, so failures reproduce */
+static unsigned long test_state;
+
+static size_t test_random(size_t n)
+{
+    test_state = test_state * 6364136223846793005UL + 1442695040888963407UL;
+    return (size_t)((test_state >> 33) % n);
+}
+
+/* Reference: no path compression, no balancing */
+static size_t reference_find(const size_t *parent, size_t i)
+{
+    while (parent[i] != i)
+        i = parent[i];
+    return i;
+}
+
+static bool reference_links(const cyclone_BodyWorld *world, size_t i)
+{
+    return i != CYCLONE_CONTACT_STATIC && world->inverse_mass[i] > (real)0;
+}
+
+static void test_partition(size_t body_count, size_t row_count, unsigned long seed)
+{
+    test_state = seed;
+
+    cyclone_BodyWorld world;
+    cyclone_body_world_init(&world);
+    cyclone_Matrix3 inertia = cyclone_matrix3_zero();
+    cyclone_matrix3_set_diagonal(&inertia, 1, 1, 1);
+    for (size_t i = 0; i < body_count; ++i)
+    {
+        real mass = test_random(10) == 0 ? (real)0 : (real)1;
+        CHECK(cyclone_body_world_add(&world, cyclone_vector3_zero(), cyclone_quaternion_identity(),
+                                     mass, &inertia, NULL));
+        if (test_random(4) == 0)
+            world.is_awake[i] = false;
+    }
+
+    cyclone_ContactConstraint *rows = calloc(row_count, sizeof(cyclone_ContactConstraint));
+    size_t *parent = malloc(body_count * sizeof(size_t));
+    CHECK(rows && parent);
+    for (size_t i = 0; i < body_count; ++i)
+        parent[i] = i;
+
+    for (size_t r = 0; r < row_count; ++r)
+    {
+        size_t a = test_random(body_count);
+        size_t b = test_random(20) == 0 ? CYCLONE_CONTACT_STATIC : test_random(body_count);
+        rows[r].body[0] = a;
+        rows[r].body[1] = b;
+        if (reference_links(&world, a) && reference_links(&world, b))
+        {
+            size_t ra = reference_find(parent, a);
+            size_t rb = reference_find(parent, b);
+            if (ra != rb)
+                parent[ra] = rb;
+        }
+    }
+
+    /* The islands only read the solver's rows */
+    cyclone_ContactSolver solver = { 0 };
+    solver.constraints = rows;
+    solver.count = row_count;
+
+    cyclone_Islands islands;
+    cyclone_islands_init(&islands);
+    CHECK(cyclone_islands_build(&islands, &world, &solver));
+
+    size_t roots = 0;
+    for (size_t i = 0; i < body_count; ++i)
+        roots += reference_find(parent, i) == i;
+    CHECK(islands.island_count == roots);
+
+    /* Same island exactly when the reference has the same root */
+    size_t *island_of_root = malloc(body_count * sizeof(size_t));
+    size_t *root_of_island = malloc(body_count * sizeof(size_t));
+    CHECK(island_of_root && root_of_island);
+    for (size_t i = 0; i < body_count; ++i)
+        island_of_root[i] = root_of_island[i] = (size_t)-1;
+    for (size_t i = 0; i < body_count; ++i)
+    {
+        size_t root = reference_find(parent, i);
+        size_t island = islands.island_of[i];
+        CHECK(island < islands.island_count);
+        if (island_of_root[root] == (size_t)-1)
+            island_of_root[root] = island;
+        if (root_of_island[island] == (size_t)-1)
+            root_of_island[island] = root;
+        CHECK(island_of_root[root] == island);
+        CHECK(root_of_island[island] == root);
+    }
+
+    /* Every body listed once, under its own island, and islands wake whole */
+    CHECK(islands.body_start[0] == 0);
+    CHECK(islands.body_start[islands.island_count] == body_count);
+    for (size_t s = 0; s < islands.island_count; ++s)
+    {
+        for (size_t k = islands.body_start[s]; k < islands.body_start[s + 1]; ++k)
+        {
+            size_t i = islands.bodies[k];
+            CHECK(i < body_count);
+            CHECK(islands.island_of[i] == s);
+            CHECK(world.is_awake[i] == islands.awake[s]);
+        }
+    }
+
+    /* Rows go to the island of their movable body; rows with none are dropped */
+    size_t listed = 0;
+    for (size_t s = 0; s < islands.island_count; ++s)
+    {
+        for (size_t k = islands.row_start[s]; k < islands.row_start[s + 1]; ++k)
+        {
+            const cyclone_ContactConstraint *c = &rows[islands.rows[k]];
+            size_t body = reference_links(&world, c->body[0]) ? c->body[0] : c->body[1];
+            CHECK(body != CYCLONE_CONTACT_STATIC);
+            CHECK(islands.island_of[body] == s);
+            listed++;
+        }
+    }
+    size_t expected = 0;
+    for (size_t r = 0; r < row_count; ++r)
+        expected += reference_links(&world, rows[r].body[0]) || rows[r].body[1] != CYCLONE_CONTACT_STATIC;
+    CHECK(listed == expected);
+
+    free(island_of_root);
+    free(root_of_island);
+    cyclone_islands_free(&islands);
+    free(parent);
+    free(rows);
+    cyclone_body_world_free(&world);
+}
+
+int main(void)
+{
+    /* Sparse graphs leave many small islands, dense ones a few large ones */
+    for (unsigned long seed = 1; seed <= 20; ++seed)
+    {
+        test_partition(500, 200, seed);
+        test_partition(500, 700, seed);
+        test_partition(2000, 4000, seed);
+    }
+    test_partition(1, 0, 1);
+    test_partition(64, 0, 1);
+
+    if (failures)
+    {
+        fprintf(stderr, "%d failure(s)\n", failures);
+        return 1;
+    }
+    printf("islands: all partitions match\n");
+    return 0;
+}